@@ -0,0 +1,468 @@
+/**
+ * @file qtip_bench.c
+ * @brief Microbenchmarks for QTip API
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * Sweeps item sizes, capacities and fill levels for each queue operation and
+ * reports the time per operation and the throughput. Every measurement is
+ * taken over a batch of operations long enough to be timed reliably, and the
+ * percentiles are computed across batches.
+ *
+ * Usage: qtip_bench [--json] [--quick] [--samples N]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "qtip.h"
+#include "qtip_fast.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Private defines
+ */
+
+#define DEFAULT_SAMPLES 51U     //!< Number of timed batches per case
+#define QUICK_SAMPLES   5U      //!< Number of timed batches per case with `--quick`
+#define MIN_BATCH_NS    20000U  //!< Minimum duration of a timed batch
+#define MAX_BATCH       (1U << 20U)
+#define BULK_ITEMS      16U     //!< Items moved by each bulk operation
+#define NS_PER_S        1000000000.0
+
+#define BENCH_CHECK(exp)                                                                          \
+    do                                                                                            \
+    {                                                                                             \
+        const qtipStatus_t benchStatus = (exp);                                                   \
+        if (benchStatus != QTIP_STATUS_OK)                                                        \
+        {                                                                                         \
+            fprintf(stderr, "%s:%d: %s returned %d\n", __FILE__, __LINE__, #exp, (int) benchStatus); \
+            exit(EXIT_FAILURE);                                                                   \
+        }                                                                                         \
+    } while (0)
+
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+
+#ifdef DISABLE_LOCK
+#define LOCK_ENABLED false
+#else
+#define LOCK_ENABLED true
+#endif
+
+#ifdef DISABLE_TELEMETRY
+#define TELEMETRY_ENABLED false
+#else
+#define TELEMETRY_ENABLED true
+#endif
+
+#ifdef REDUCED_API
+#define REDUCED_API_ENABLED true
+#else
+#define REDUCED_API_ENABLED false
+#endif
+
+#ifdef POWER_OF_TWO
+#define POWER_OF_TWO_ENABLED true
+#else
+#define POWER_OF_TWO_ENABLED false
+#endif
+
+/*
+ * Private typedefs
+ */
+
+/**
+ * @brief State of one benchmark case
+ */
+typedef struct
+{
+    qtipContext_t context; //!< Queue under test
+    void* pBuffer;         //!< Queue memory
+    void* pItems;          //!< Items to put, at least BULK_ITEMS long
+    void* pScratch;        //!< Destination of reads, at least maxItems long
+    size_t itemSize;       //!< Size of each item
+    qtipSize_t maxItems;   //!< Capacity of the queue
+    qtipSize_t fill;       //!< Number of items kept in the queue between operations
+} benchCase_t;
+
+/**
+ * @brief Queue operation to measure
+ */
+typedef struct
+{
+    const char* name;                              //!< Name reported in the results
+    bool needsItems;                               //!< Skip the case when the queue is empty
+    qtipSize_t (*itemsPerOp)(benchCase_t* pCase);  //!< Number of items moved by one operation
+    void (*run)(benchCase_t* pCase, size_t batch); //!< Runs `batch` operations
+} benchOp_t;
+
+/**
+ * @brief Statistics of one benchmark case
+ */
+typedef struct
+{
+    size_t batch;  //!< Operations per timed batch
+    double min;    //!< Fastest batch, in ns/op
+    double mean;   //!< Mean of all batches, in ns/op
+    double p50;    //!< Median, in ns/op
+    double p90;    //!< 90th percentile, in ns/op
+    double p99;    //!< 99th percentile, in ns/op
+    double itemsS; //!< Throughput, in items/s
+} benchResult_t;
+
+/*
+ * Private data
+ */
+
+static const size_t ITEM_SIZES[]      = {1U, 8U, 64U, 512U, 4096U};
+static const size_t CAPACITIES[]      = {16U, 256U, 4096U};
+static const unsigned FILL_PERCENTS[] = {0U, 50U, 90U};
+
+/*
+ * Private functions
+ */
+
+static uint64_t now_ns(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return ((uint64_t) time.tv_sec * 1000000000U) + (uint64_t) time.tv_nsec;
+}
+
+static qtipSize_t one_item(benchCase_t* pCase)
+{
+    (void) pCase;
+    return 1U;
+}
+
+static qtipSize_t fill_items(benchCase_t* pCase)
+{
+    return pCase->fill;
+}
+
+static void run_put_pop(benchCase_t* pCase, size_t batch)
+{
+    for (size_t i = 0U; i < batch; i++)
+    {
+        BENCH_CHECK(qtip_put(&pCase->context, pCase->pItems));
+        BENCH_CHECK(qtip_pop(&pCase->context, pCase->pScratch));
+    }
+}
+
+static void run_fast_put_pop(benchCase_t* pCase, size_t batch)
+{
+    for (size_t i = 0U; i < batch; i++)
+    {
+        BENCH_CHECK(qtip_fast_put(&pCase->context, pCase->pItems));
+        BENCH_CHECK(qtip_fast_pop(&pCase->context, pCase->pScratch));
+    }
+}
+
+static void run_get_front(benchCase_t* pCase, size_t batch)
+{
+    for (size_t i = 0U; i < batch; i++)
+    {
+        BENCH_CHECK(qtip_get_front(&pCase->context, pCase->pScratch));
+    }
+}
+
+static void run_peek(benchCase_t* pCase, size_t batch)
+{
+    qtipSize_t size = 0U;
+
+    for (size_t i = 0U; i < batch; i++)
+    {
+        BENCH_CHECK(qtip_peek(&pCase->context, pCase->pScratch, &size));
+    }
+}
+
+#ifndef REDUCED_API
+
+static qtipSize_t bulk_items(benchCase_t* pCase)
+{
+    const qtipSize_t room = pCase->maxItems - pCase->fill;
+    return (room < BULK_ITEMS) ? room : BULK_ITEMS;
+}
+
+static void run_put_pop_n(benchCase_t* pCase, size_t batch)
+{
+    const qtipSize_t n = bulk_items(pCase);
+
+    for (size_t i = 0U; i < batch; i++)
+    {
+        BENCH_CHECK(qtip_put_n(&pCase->context, pCase->pItems, n));
+        BENCH_CHECK(qtip_pop_n(&pCase->context, pCase->pScratch, n));
+    }
+}
+
+static void run_reserve_acquire(benchCase_t* pCase, size_t batch)
+{
+    void* pSlot = NULL;
+
+    for (size_t i = 0U; i < batch; i++)
+    {
+        BENCH_CHECK(qtip_reserve(&pCase->context, &pSlot));
+        BENCH_CHECK(qtip_commit(&pCase->context));
+        BENCH_CHECK(qtip_acquire(&pCase->context, &pSlot));
+        BENCH_CHECK(qtip_release(&pCase->context));
+    }
+}
+
+static void run_remove_item_index(benchCase_t* pCase, size_t batch)
+{
+    for (size_t i = 0U; i < batch; i++)
+    {
+        BENCH_CHECK(qtip_remove_item_index(&pCase->context, pCase->fill / 2U));
+        BENCH_CHECK(qtip_put(&pCase->context, pCase->pItems));
+    }
+}
+
+#endif // REDUCED_API
+
+static const benchOp_t OPERATIONS[] = {
+    {"put_pop", false, one_item, run_put_pop},
+    {"fast_put_pop", false, one_item, run_fast_put_pop},
+    {"get_front", true, one_item, run_get_front},
+    {"peek", true, fill_items, run_peek},
+#ifndef REDUCED_API
+    {"put_pop_n", false, bulk_items, run_put_pop_n},
+    {"reserve_acquire", false, one_item, run_reserve_acquire},
+    {"remove_item_index", true, one_item, run_remove_item_index},
+#endif
+};
+
+static int compare_doubles(const void* pA, const void* pB)
+{
+    const double a = *(const double*) pA;
+    const double b = *(const double*) pB;
+    return (a > b) - (a < b);
+}
+
+static double percentile(const double* pSorted, size_t count, unsigned percent)
+{
+    return pSorted[((count - 1U) * percent + 50U) / 100U];
+}
+
+static size_t calibrate_batch(const benchOp_t* pOp, benchCase_t* pCase)
+{
+    size_t batch = 1U;
+
+    while (batch < MAX_BATCH)
+    {
+        const uint64_t start = now_ns();
+        pOp->run(pCase, batch);
+        if ((now_ns() - start) >= MIN_BATCH_NS)
+        {
+            break;
+        }
+        batch *= 2U;
+    }
+
+    return batch;
+}
+
+static void measure(const benchOp_t* pOp, benchCase_t* pCase, size_t samples, double* pTimes, benchResult_t* pResult)
+{
+    double sum = 0.0;
+
+    pResult->batch = calibrate_batch(pOp, pCase);
+    for (size_t i = 0U; i < samples; i++)
+    {
+        const uint64_t start = now_ns();
+        pOp->run(pCase, pResult->batch);
+        pTimes[i] = (double) (now_ns() - start) / (double) pResult->batch;
+        sum += pTimes[i];
+    }
+
+    qsort(pTimes, samples, sizeof(double), compare_doubles);
+    pResult->min    = pTimes[0];
+    pResult->mean   = sum / (double) samples;
+    pResult->p50    = percentile(pTimes, samples, 50U);
+    pResult->p90    = percentile(pTimes, samples, 90U);
+    pResult->p99    = percentile(pTimes, samples, 99U);
+    pResult->itemsS = ((double) pOp->itemsPerOp(pCase) * NS_PER_S) / pResult->mean;
+}
+
+static void prepare_case(benchCase_t* pCase)
+{
+    BENCH_CHECK(qtip_init(&pCase->context, pCase->pBuffer, pCase->maxItems, pCase->itemSize));
+    for (qtipSize_t i = 0U; i < pCase->fill; i++)
+    {
+        BENCH_CHECK(qtip_put(&pCase->context, pCase->pItems));
+    }
+}
+
+static void print_config(bool json)
+{
+    const bool lock      = LOCK_ENABLED;
+    const bool telemetry = TELEMETRY_ENABLED;
+    const bool reduced   = REDUCED_API_ENABLED;
+    const bool powerOf2  = POWER_OF_TWO_ENABLED;
+
+    if (json)
+    {
+        printf("{\n  \"config\": {\"lock\": %s, \"telemetry\": %s, \"reduced_api\": %s, \"power_of_two\": %s, "
+               "\"size_type_bytes\": %zu},\n  \"results\": [",
+               lock ? "true" : "false",
+               telemetry ? "true" : "false",
+               reduced ? "true" : "false",
+               powerOf2 ? "true" : "false",
+               sizeof(qtipSize_t));
+    }
+    else
+    {
+        printf("lock=%d telemetry=%d reduced_api=%d power_of_two=%d size_type_bytes=%zu\n\n",
+               lock,
+               telemetry,
+               reduced,
+               powerOf2,
+               sizeof(qtipSize_t));
+        printf("%-18s %9s %9s %9s %10s %10s %10s %10s %10s %14s\n",
+               "operation",
+               "item_size",
+               "capacity",
+               "fill",
+               "min_ns",
+               "mean_ns",
+               "p50_ns",
+               "p90_ns",
+               "p99_ns",
+               "items_per_s");
+    }
+}
+
+static void print_result(bool json, bool first, const benchOp_t* pOp, benchCase_t* pCase, benchResult_t* pResult)
+{
+    if (json)
+    {
+        printf("%s\n    {\"op\": \"%s\", \"item_size\": %zu, \"capacity\": %zu, \"fill\": %zu, \"items_per_op\": %zu, "
+               "\"batch\": %zu, \"ns_per_op\": {\"min\": %.2f, \"mean\": %.2f, \"p50\": %.2f, \"p90\": %.2f, "
+               "\"p99\": %.2f}, \"items_per_s\": %.0f}",
+               first ? "" : ",",
+               pOp->name,
+               pCase->itemSize,
+               (size_t) pCase->maxItems,
+               (size_t) pCase->fill,
+               (size_t) pOp->itemsPerOp(pCase),
+               pResult->batch,
+               pResult->min,
+               pResult->mean,
+               pResult->p50,
+               pResult->p90,
+               pResult->p99,
+               pResult->itemsS);
+    }
+    else
+    {
+        printf("%-18s %9zu %9zu %9zu %10.1f %10.1f %10.1f %10.1f %10.1f %14.0f\n",
+               pOp->name,
+               pCase->itemSize,
+               (size_t) pCase->maxItems,
+               (size_t) pCase->fill,
+               pResult->min,
+               pResult->mean,
+               pResult->p50,
+               pResult->p90,
+               pResult->p99,
+               pResult->itemsS);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool json      = false;
+    bool quick     = false;
+    size_t samples = DEFAULT_SAMPLES;
+    bool first     = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--json") == 0)
+        {
+            json = true;
+        }
+        else if (strcmp(argv[i], "--quick") == 0)
+        {
+            quick = true;
+        }
+        else if ((strcmp(argv[i], "--samples") == 0) && ((i + 1) < argc) && (atoi(argv[i + 1]) > 0))
+        {
+            samples = (size_t) atoi(argv[++i]);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--json] [--quick] [--samples N]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (quick)
+    {
+        samples = QUICK_SAMPLES;
+    }
+
+    const size_t maxCapacity = CAPACITIES[ARRAY_SIZE(CAPACITIES) - 1U];
+    const size_t maxItemSize = ITEM_SIZES[ARRAY_SIZE(ITEM_SIZES) - 1U];
+    benchCase_t benchCase    = {0};
+    double* pTimes           = malloc(samples * sizeof(double));
+
+    benchCase.pBuffer  = malloc(maxCapacity * maxItemSize);
+    benchCase.pScratch = malloc(maxCapacity * maxItemSize);
+    benchCase.pItems   = calloc(BULK_ITEMS, maxItemSize);
+    if ((pTimes == NULL) || (benchCase.pBuffer == NULL) || (benchCase.pScratch == NULL) || (benchCase.pItems == NULL))
+    {
+        fprintf(stderr, "out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    print_config(json);
+
+    for (size_t s = 0U; s < ARRAY_SIZE(ITEM_SIZES); s += (quick ? 2U : 1U))
+    {
+        for (size_t c = 0U; c < ARRAY_SIZE(CAPACITIES); c++)
+        {
+            if ((size_t) (qtipSize_t) CAPACITIES[c] != CAPACITIES[c])
+            {
+                continue; // Does not fit in SIZE_TYPE
+            }
+
+            for (size_t f = 0U; f < ARRAY_SIZE(FILL_PERCENTS); f++)
+            {
+                benchCase.itemSize = ITEM_SIZES[s];
+                benchCase.maxItems = (qtipSize_t) CAPACITIES[c];
+                benchCase.fill     = (qtipSize_t) ((CAPACITIES[c] * FILL_PERCENTS[f]) / 100U);
+
+                for (size_t o = 0U; o < ARRAY_SIZE(OPERATIONS); o++)
+                {
+                    benchResult_t result = {0};
+
+                    if (OPERATIONS[o].needsItems && (benchCase.fill == 0U))
+                    {
+                        continue;
+                    }
+
+                    prepare_case(&benchCase);
+                    measure(&OPERATIONS[o], &benchCase, samples, pTimes, &result);
+                    print_result(json, first, &OPERATIONS[o], &benchCase, &result);
+                    first = false;
+                }
+            }
+        }
+    }
+
+    if (json)
+    {
+        printf("\n  ]\n}\n");
+    }
+
+    free(pTimes);
+    free(benchCase.pBuffer);
+    free(benchCase.pScratch);
+    free(benchCase.pItems);
+
+    return EXIT_SUCCESS;
+}
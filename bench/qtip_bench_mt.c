@@ -0,0 +1,623 @@
+/**
+ * @file qtip_bench_mt.c
+ * @brief Multi-threaded contention benchmarks for QTip API
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * Runs N producers and M consumers against one shared queue and reports the
+ * throughput and the end-to-end latency of the items. Every producer tags
+ * its items with its id and a sequence number, and the run fails if any item
+ * is lost, duplicated or seen out of order by a consumer.
+ *
+ * The core queue is shared through an external mutex, the same way it has to
+ * be shared between threads in an application. The lock-free queues are
+ * benchmarked for the thread counts they support.
+ *
+ * Usage: qtip_bench_mt [--json] [--quick] [--items N] [--capacity N] [--producers N --consumers M]
+ */
+
+#define _GNU_SOURCE
+
+#include "qtip.h"
+#include "qtip_mpmc.h"
+#include "qtip_spsc.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Private defines
+ */
+
+#define DEFAULT_ITEMS    100000U //!< Items put by each producer
+#define QUICK_ITEMS      5000U   //!< Items put by each producer with `--quick`
+#define DEFAULT_CAPACITY 128U    //!< Capacity of the shared queue
+#define LATENCY_SAMPLES  65536U  //!< Maximum number of latencies kept per consumer
+#define PRODUCER_SHIFT   48U     //!< Position of the producer id in an item tag
+#define NS_PER_S         1000000000.0
+
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+
+/*
+ * Private typedefs
+ */
+
+/**
+ * @brief Item moved through the queue
+ */
+typedef struct
+{
+    uint64_t tag;     //!< Producer id and sequence number
+    uint64_t stampNs; //!< Time at which the item was put
+} benchItem_t;
+
+/**
+ * @brief Core queue shared through a mutex
+ */
+typedef struct
+{
+    qtipContext_t context;
+    pthread_mutex_t mutex;
+} mutexQueue_t;
+
+/**
+ * @brief Queue implementation to measure
+ */
+typedef struct
+{
+    const char* name;                                                     //!< Name reported in the results
+    bool (*supports)(size_t producers, size_t consumers);                 //!< Whether the thread counts are valid
+    void* (*create)(qtipSize_t capacity);                                 //!< Allocates and initialises a queue
+    void (*destroy)(void* pQueue);                                        //!< Frees a queue
+    qtipStatus_t (*put)(void* pQueue, benchItem_t* pItem);                //!< Puts one item
+    qtipStatus_t (*pop)(void* pQueue, benchItem_t* pItem);                //!< Pops one item
+} benchMode_t;
+
+/**
+ * @brief State shared by all the threads of a run
+ */
+typedef struct
+{
+    const benchMode_t* pMode;                //!< Queue implementation
+    void* pQueue;                            //!< Shared queue
+    size_t producers;                        //!< Number of producer threads
+    size_t consumers;                        //!< Number of consumer threads
+    size_t items;                            //!< Items put by each producer
+    size_t cpus;                             //!< Number of CPUs to pin threads to
+    pthread_barrier_t start;                 //!< Releases all the threads at once
+    QTIP_ATOMIC(size_t) consumed;            //!< Items popped by all consumers
+    QTIP_ATOMIC(uint8_t) * pDelivered;       //!< Delivery count of every item
+} benchRun_t;
+
+/**
+ * @brief State of one thread
+ */
+typedef struct
+{
+    benchRun_t* pRun;   //!< Shared state
+    size_t id;          //!< Producer or consumer id
+    size_t cpu;         //!< CPU the thread is pinned to
+    uint64_t* pNext;    //!< Next sequence number expected from every producer
+    uint64_t* pLatency; //!< Sampled latencies
+    size_t samples;     //!< Number of sampled latencies
+    size_t stride;      //!< Items between latency samples
+    size_t received;    //!< Items popped by this consumer
+    bool ordered;       //!< Whether every producer was seen in order
+} benchWorker_t;
+
+/**
+ * @brief Result of one run
+ */
+typedef struct
+{
+    double seconds;    //!< Wall time of the run
+    double itemsS;     //!< Throughput, in items/s
+    uint64_t p50;      //!< Median latency, in ns
+    uint64_t p90;      //!< 90th percentile latency, in ns
+    uint64_t p99;      //!< 99th percentile latency, in ns
+    uint64_t p999;     //!< 99.9th percentile latency, in ns
+    uint64_t max;      //!< Highest sampled latency, in ns
+} benchResult_t;
+
+/*
+ * Private data
+ */
+
+static const size_t THREAD_COUNTS[][2] = {{1U, 1U}, {2U, 2U}, {4U, 4U}, {8U, 8U}, {1U, 4U}, {4U, 1U}};
+
+/*
+ * Private functions
+ */
+
+static void fail(const char* pMessage)
+{
+    fprintf(stderr, "qtip_bench_mt: %s\n", pMessage);
+    exit(EXIT_FAILURE);
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return ((uint64_t) time.tv_sec * 1000000000U) + (uint64_t) time.tv_nsec;
+}
+
+static void pin_thread(size_t cpu)
+{
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    (void) pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+static bool any_threads(size_t producers, size_t consumers)
+{
+    return (producers > 0U) && (consumers > 0U);
+}
+
+static bool single_threads(size_t producers, size_t consumers)
+{
+    return (producers == 1U) && (consumers == 1U);
+}
+
+static void* mutex_create(qtipSize_t capacity)
+{
+    mutexQueue_t* pQueue = malloc(sizeof(mutexQueue_t));
+    void* pBuffer        = malloc(capacity * sizeof(benchItem_t));
+
+    if ((pQueue == NULL) || (pBuffer == NULL) ||
+        (qtip_init(&pQueue->context, pBuffer, capacity, sizeof(benchItem_t)) != QTIP_STATUS_OK))
+    {
+        fail("cannot create mutex queue");
+    }
+    pthread_mutex_init(&pQueue->mutex, NULL);
+
+    return pQueue;
+}
+
+static void mutex_destroy(void* pQueue)
+{
+    mutexQueue_t* pMutexQueue = pQueue;
+
+    pthread_mutex_destroy(&pMutexQueue->mutex);
+    free(pMutexQueue->context.start);
+    free(pMutexQueue);
+}
+
+static qtipStatus_t mutex_put(void* pQueue, benchItem_t* pItem)
+{
+    mutexQueue_t* pMutexQueue = pQueue;
+
+    pthread_mutex_lock(&pMutexQueue->mutex);
+    const qtipStatus_t status = qtip_put(&pMutexQueue->context, pItem);
+    pthread_mutex_unlock(&pMutexQueue->mutex);
+
+    return status;
+}
+
+static qtipStatus_t mutex_pop(void* pQueue, benchItem_t* pItem)
+{
+    mutexQueue_t* pMutexQueue = pQueue;
+
+    pthread_mutex_lock(&pMutexQueue->mutex);
+    const qtipStatus_t status = qtip_pop(&pMutexQueue->context, pItem);
+    pthread_mutex_unlock(&pMutexQueue->mutex);
+
+    return status;
+}
+
+static void* spsc_create(qtipSize_t capacity)
+{
+    qtipSpscContext_t* pContext = aligned_alloc(CACHE_LINE_SIZE, sizeof(qtipSpscContext_t));
+    void* pBuffer               = malloc(capacity * sizeof(benchItem_t));
+
+    if ((pContext == NULL) || (pBuffer == NULL) ||
+        (qtip_spsc_init(pContext, pBuffer, capacity, sizeof(benchItem_t)) != QTIP_STATUS_OK))
+    {
+        fail("cannot create SPSC queue");
+    }
+
+    return pContext;
+}
+
+static void spsc_destroy(void* pQueue)
+{
+    free(((qtipSpscContext_t*) pQueue)->start);
+    free(pQueue);
+}
+
+static qtipStatus_t spsc_put(void* pQueue, benchItem_t* pItem)
+{
+    return qtip_spsc_put(pQueue, pItem);
+}
+
+static qtipStatus_t spsc_pop(void* pQueue, benchItem_t* pItem)
+{
+    return qtip_spsc_pop(pQueue, pItem);
+}
+
+static void* mpmc_create(qtipSize_t capacity)
+{
+    qtipMpmcContext_t* pContext = aligned_alloc(CACHE_LINE_SIZE, sizeof(qtipMpmcContext_t));
+    void* pBuffer               = malloc(QTIP_MPMC_BUFFER_SIZE(capacity, sizeof(benchItem_t)));
+
+    if ((pContext == NULL) || (pBuffer == NULL) ||
+        (qtip_mpmc_init(pContext, pBuffer, capacity, sizeof(benchItem_t)) != QTIP_STATUS_OK))
+    {
+        fail("cannot create MPMC queue");
+    }
+
+    return pContext;
+}
+
+static void mpmc_destroy(void* pQueue)
+{
+    free(((qtipMpmcContext_t*) pQueue)->start);
+    free(pQueue);
+}
+
+static qtipStatus_t mpmc_put(void* pQueue, benchItem_t* pItem)
+{
+    return qtip_mpmc_put(pQueue, pItem);
+}
+
+static qtipStatus_t mpmc_pop(void* pQueue, benchItem_t* pItem)
+{
+    return qtip_mpmc_pop(pQueue, pItem);
+}
+
+static const benchMode_t MODES[] = {
+    {"mutex", any_threads, mutex_create, mutex_destroy, mutex_put, mutex_pop},
+    {"spsc", single_threads, spsc_create, spsc_destroy, spsc_put, spsc_pop},
+    {"mpmc", any_threads, mpmc_create, mpmc_destroy, mpmc_put, mpmc_pop},
+};
+
+static void* producer(void* pArg)
+{
+    benchWorker_t* pWorker = pArg;
+    benchRun_t* pRun       = pWorker->pRun;
+    benchItem_t item       = {0};
+
+    pin_thread(pWorker->cpu);
+    pthread_barrier_wait(&pRun->start);
+
+    for (uint64_t i = 0U; i < pRun->items; i++)
+    {
+        item.tag = ((uint64_t) pWorker->id << PRODUCER_SHIFT) | i;
+        item.stampNs = now_ns();
+        while (pRun->pMode->put(pRun->pQueue, &item) != QTIP_STATUS_OK)
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void* consumer(void* pArg)
+{
+    benchWorker_t* pWorker = pArg;
+    benchRun_t* pRun       = pWorker->pRun;
+    const size_t total     = pRun->producers * pRun->items;
+    benchItem_t item       = {0};
+
+    pin_thread(pWorker->cpu);
+    pthread_barrier_wait(&pRun->start);
+
+    while (atomic_load_explicit(&pRun->consumed, memory_order_relaxed) < total)
+    {
+        if (pRun->pMode->pop(pRun->pQueue, &item) == QTIP_STATUS_OK)
+        {
+            const uint64_t latency  = now_ns() - item.stampNs;
+            const uint64_t id       = item.tag >> PRODUCER_SHIFT;
+            const uint64_t sequence = item.tag & ((1ULL << PRODUCER_SHIFT) - 1U);
+
+            if ((id >= pRun->producers) || (sequence >= pRun->items))
+            {
+                fail("corrupted item received");
+            }
+
+            pWorker->ordered   = pWorker->ordered && (sequence >= pWorker->pNext[id]);
+            pWorker->pNext[id] = sequence + 1U;
+            atomic_fetch_add_explicit(&pRun->pDelivered[id * pRun->items + sequence], 1U, memory_order_relaxed);
+
+            if (((pWorker->received % pWorker->stride) == 0U) && (pWorker->samples < LATENCY_SAMPLES))
+            {
+                pWorker->pLatency[pWorker->samples++] = latency;
+            }
+            pWorker->received++;
+            atomic_fetch_add_explicit(&pRun->consumed, 1U, memory_order_relaxed);
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static int compare_latencies(const void* pA, const void* pB)
+{
+    const uint64_t a = *(const uint64_t*) pA;
+    const uint64_t b = *(const uint64_t*) pB;
+    return (a > b) - (a < b);
+}
+
+static uint64_t percentile(const uint64_t* pSorted, size_t count, unsigned perMille)
+{
+    return (count > 0U) ? pSorted[((count - 1U) * perMille + 500U) / 1000U] : 0U;
+}
+
+static void verify(benchRun_t* pRun, benchWorker_t* pConsumers)
+{
+    size_t received = 0U;
+
+    for (size_t i = 0U; i < pRun->consumers; i++)
+    {
+        if (!pConsumers[i].ordered)
+        {
+            fail("items of a producer were received out of order");
+        }
+        received += pConsumers[i].received;
+    }
+
+    if (received != pRun->producers * pRun->items)
+    {
+        fail("number of received items does not match the number of sent items");
+    }
+
+    for (size_t i = 0U; i < pRun->producers * pRun->items; i++)
+    {
+        if (atomic_load(&pRun->pDelivered[i]) != 1U)
+        {
+            fail("an item was lost or delivered more than once");
+        }
+    }
+}
+
+static void run_case(const benchMode_t* pMode, size_t producers, size_t consumers, size_t items, qtipSize_t capacity,
+                     benchResult_t* pResult)
+{
+    benchRun_t run              = {0};
+    const size_t threads        = producers + consumers;
+    pthread_t* pThreads         = calloc(threads, sizeof(pthread_t));
+    benchWorker_t* pWorkers     = calloc(threads, sizeof(benchWorker_t));
+    const size_t total          = producers * items;
+    const size_t expectedShare  = (total + consumers - 1U) / consumers;
+    size_t samples              = 0U;
+    uint64_t* pLatency          = NULL;
+
+    run.pMode      = pMode;
+    run.pQueue     = pMode->create(capacity);
+    run.producers  = producers;
+    run.consumers  = consumers;
+    run.items      = items;
+    run.cpus       = (size_t) sysconf(_SC_NPROCESSORS_ONLN);
+    run.pDelivered = calloc(total, sizeof(*run.pDelivered));
+    atomic_init(&run.consumed, 0U);
+    if ((pThreads == NULL) || (pWorkers == NULL) || (run.pDelivered == NULL) || (run.cpus == 0U))
+    {
+        fail("cannot allocate run");
+    }
+    pthread_barrier_init(&run.start, NULL, (unsigned) threads + 1U);
+
+    for (size_t i = 0U; i < threads; i++)
+    {
+        const bool isProducer = i < producers;
+
+        pWorkers[i].pRun    = &run;
+        pWorkers[i].id      = isProducer ? i : (i - producers);
+        pWorkers[i].cpu     = i % run.cpus;
+        pWorkers[i].ordered = true;
+        pWorkers[i].stride  = (expectedShare + LATENCY_SAMPLES - 1U) / LATENCY_SAMPLES;
+        if (!isProducer)
+        {
+            pWorkers[i].pNext    = calloc(producers, sizeof(uint64_t));
+            pWorkers[i].pLatency = malloc(LATENCY_SAMPLES * sizeof(uint64_t));
+            if ((pWorkers[i].pNext == NULL) || (pWorkers[i].pLatency == NULL))
+            {
+                fail("cannot allocate consumer");
+            }
+        }
+        if (pthread_create(&pThreads[i], NULL, isProducer ? producer : consumer, &pWorkers[i]) != 0)
+        {
+            fail("cannot create thread");
+        }
+    }
+
+    pthread_barrier_wait(&run.start);
+    const uint64_t start = now_ns();
+    for (size_t i = 0U; i < threads; i++)
+    {
+        pthread_join(pThreads[i], NULL);
+    }
+    const uint64_t elapsed = now_ns() - start;
+
+    verify(&run, &pWorkers[producers]);
+
+    pLatency = malloc(consumers * LATENCY_SAMPLES * sizeof(uint64_t));
+    if (pLatency == NULL)
+    {
+        fail("cannot allocate latencies");
+    }
+    for (size_t i = producers; i < threads; i++)
+    {
+        memcpy(&pLatency[samples], pWorkers[i].pLatency, pWorkers[i].samples * sizeof(uint64_t));
+        samples += pWorkers[i].samples;
+        free(pWorkers[i].pNext);
+        free(pWorkers[i].pLatency);
+    }
+    qsort(pLatency, samples, sizeof(uint64_t), compare_latencies);
+
+    pResult->seconds = (double) elapsed / NS_PER_S;
+    pResult->itemsS  = (double) total / pResult->seconds;
+    pResult->p50     = percentile(pLatency, samples, 500U);
+    pResult->p90     = percentile(pLatency, samples, 900U);
+    pResult->p99     = percentile(pLatency, samples, 990U);
+    pResult->p999    = percentile(pLatency, samples, 999U);
+    pResult->max     = (samples > 0U) ? pLatency[samples - 1U] : 0U;
+
+    pthread_barrier_destroy(&run.start);
+    pMode->destroy(run.pQueue);
+    free(pLatency);
+    free(run.pDelivered);
+    free(pWorkers);
+    free(pThreads);
+}
+
+static void print_result(bool json, bool first, const benchMode_t* pMode, size_t producers, size_t consumers,
+                         benchResult_t* pResult)
+{
+    if (json)
+    {
+        printf("%s\n    {\"mode\": \"%s\", \"producers\": %zu, \"consumers\": %zu, \"seconds\": %.6f, "
+               "\"items_per_s\": %.0f, \"latency_ns\": {\"p50\": %llu, \"p90\": %llu, \"p99\": %llu, "
+               "\"p999\": %llu, \"max\": %llu}}",
+               first ? "" : ",",
+               pMode->name,
+               producers,
+               consumers,
+               pResult->seconds,
+               pResult->itemsS,
+               (unsigned long long) pResult->p50,
+               (unsigned long long) pResult->p90,
+               (unsigned long long) pResult->p99,
+               (unsigned long long) pResult->p999,
+               (unsigned long long) pResult->max);
+    }
+    else
+    {
+        printf("%-6s %9zu %9zu %14.0f %10llu %10llu %10llu %10llu %12llu\n",
+               pMode->name,
+               producers,
+               consumers,
+               pResult->itemsS,
+               (unsigned long long) pResult->p50,
+               (unsigned long long) pResult->p90,
+               (unsigned long long) pResult->p99,
+               (unsigned long long) pResult->p999,
+               (unsigned long long) pResult->max);
+    }
+}
+
+static bool parse_count(int argc, char** argv, int* pIndex, size_t* pValue)
+{
+    bool valid = ((*pIndex + 1) < argc) && (atoi(argv[*pIndex + 1]) > 0);
+
+    if (valid)
+    {
+        *pValue = (size_t) atoi(argv[++(*pIndex)]);
+    }
+
+    return valid;
+}
+
+int main(int argc, char** argv)
+{
+    bool json          = false;
+    size_t items       = DEFAULT_ITEMS;
+    size_t capacity    = DEFAULT_CAPACITY;
+    size_t producers   = 0U;
+    size_t consumers   = 0U;
+    bool first         = true;
+    bool valid         = true;
+
+    for (int i = 1; (i < argc) && valid; i++)
+    {
+        if (strcmp(argv[i], "--json") == 0)
+        {
+            json = true;
+        }
+        else if (strcmp(argv[i], "--quick") == 0)
+        {
+            items = QUICK_ITEMS;
+        }
+        else if (strcmp(argv[i], "--items") == 0)
+        {
+            valid = parse_count(argc, argv, &i, &items);
+        }
+        else if (strcmp(argv[i], "--capacity") == 0)
+        {
+            valid = parse_count(argc, argv, &i, &capacity);
+        }
+        else if (strcmp(argv[i], "--producers") == 0)
+        {
+            valid = parse_count(argc, argv, &i, &producers);
+        }
+        else if (strcmp(argv[i], "--consumers") == 0)
+        {
+            valid = parse_count(argc, argv, &i, &consumers);
+        }
+        else
+        {
+            valid = false;
+        }
+    }
+
+    if (!valid || ((producers == 0U) != (consumers == 0U)) || (items >= (1ULL << PRODUCER_SHIFT)) ||
+        ((size_t) (qtipSize_t) capacity != capacity))
+    {
+        fprintf(stderr,
+                "usage: %s [--json] [--quick] [--items N] [--capacity N] [--producers N --consumers M]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (json)
+    {
+        printf("{\n  \"items_per_producer\": %zu,\n  \"capacity\": %zu,\n  \"results\": [", items, capacity);
+    }
+    else
+    {
+        printf("items_per_producer=%zu capacity=%zu\n\n", items, capacity);
+        printf("%-6s %9s %9s %14s %10s %10s %10s %10s %12s\n",
+               "mode",
+               "producers",
+               "consumers",
+               "items_per_s",
+               "p50_ns",
+               "p90_ns",
+               "p99_ns",
+               "p999_ns",
+               "max_ns");
+    }
+
+    for (size_t t = 0U; t < ARRAY_SIZE(THREAD_COUNTS); t++)
+    {
+        const size_t caseProducers = (producers > 0U) ? producers : THREAD_COUNTS[t][0];
+        const size_t caseConsumers = (consumers > 0U) ? consumers : THREAD_COUNTS[t][1];
+
+        for (size_t m = 0U; m < ARRAY_SIZE(MODES); m++)
+        {
+            benchResult_t result = {0};
+
+            if (MODES[m].supports(caseProducers, caseConsumers))
+            {
+                run_case(&MODES[m], caseProducers, caseConsumers, items, (qtipSize_t) capacity, &result);
+                print_result(json, first, &MODES[m], caseProducers, caseConsumers, &result);
+                first = false;
+                fflush(stdout);
+            }
+        }
+
+        if (producers > 0U)
+        {
+            break; // Only the requested thread counts
+        }
+    }
+
+    if (json)
+    {
+        printf("\n  ]\n}\n");
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -29,6 +29,7 @@ QTIP_CPP_SUPPORT_START
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /*
  * Public defines
@@ -39,11 +40,55 @@ QTIP_CPP_SUPPORT_START
 #include <stdint.h>
 #endif
 
+#ifndef STATS_BUCKETS
+#define STATS_BUCKETS 16U //!< Number of buckets of the occupancy histogram, see @ref qtipStats_t
+#endif
+
+#ifndef STATS_SAMPLE_RATE
+#define STATS_SAMPLE_RATE 16U //!< Puts between fill level samples of the concurrent queues, see @ref qtip_spsc_get_stats
+#endif
+
+#ifndef SOJOURN_BUCKETS
+#define SOJOURN_BUCKETS 32U //!< Number of buckets of the sojourn time histogram, see @ref qtip_enable_sojourn
+#endif
+
 /*
  * Public typedefs
  */
 typedef SIZE_TYPE qtipSize_t; //!< Number of items in queue
 
+/**
+ * @brief Function called when a queue becomes ready to be consumed
+ * @param pArg Argument registered with @ref qtip_set_notifier
+ */
+typedef void (*qtipNotifyCallback_t)(void* pArg);
+
+/**
+ * @brief Function that selects items of a queue
+ * @param pItem Pointer to the item in the queue
+ * @param pArg  Argument passed along with the predicate
+ * @returns `true` if the item is selected
+ */
+typedef bool (*qtipPredicate_t)(const void* pItem, void* pArg);
+
+/**
+ * @brief Function that reads the clock of a queue
+ * @param pArg Argument registered with @ref qtip_enable_sojourn
+ * @returns Current time, in any unit, never going backwards
+ */
+typedef uint64_t (*qtipClock_t)(void* pArg);
+
+/**
+ * @brief Memory hooks of a growable queue
+ * @details See @ref qtip_init_growable.
+ */
+typedef struct
+{
+    void* (*alloc)(size_t size, void* pArg); //!< Allocates `size` bytes, returns NULL on failure
+    void (*free)(void* pBuffer, void* pArg); //!< Frees a buffer returned by `alloc`
+    void* pArg;                              //!< Argument passed to `alloc` and `free`
+} qtipAllocator_t;
+
 /*
  * Public Enum
  */
@@ -58,33 +103,195 @@ typedef enum
     QTIP_STATUS_EMPTY,        //!< Queue is empty
     QTIP_STATUS_NULL_PTR,     //!< Null pointer encountered
     QTIP_STATUS_INVALID_SIZE, //!< Invalid queue size
-    QTIP_STATUS_LOCKED        //!< Queue is locked
+    QTIP_STATUS_LOCKED,       //!< Queue is locked
+    QTIP_STATUS_SYSTEM_ERROR  //!< Operating system call failed, `errno` holds the cause
 } qtipStatus_t;
 
 /*
  * Public Structs
  */
 
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+
+/**
+ * @brief Queue statistics
+ * @details Bucket `k` of `histogram` counts the puts that left between `2^k`
+ *          and `2^(k+1) - 1` items in the queue, and the last bucket also
+ *          counts every larger fill level.
+ */
+typedef struct
+{
+    qtipSize_t highWatermark;        //!< Most items held by the queue after a put
+    size_t full;                     //!< Number of insertions rejected with @ref QTIP_STATUS_FULL
+    size_t empty;                    //!< Number of removals rejected with @ref QTIP_STATUS_EMPTY
+    size_t locked;                   //!< Number of insertions and removals rejected with @ref QTIP_STATUS_LOCKED
+    size_t histogram[STATS_BUCKETS]; //!< Number of puts by fill level after the put, in log2 buckets
+} qtipStats_t;
+
+#endif // DISABLE_TELEMETRY && DISABLE_STATS
+
+#if !defined(DISABLE_SOJOURN) && !defined(REDUCED_API)
+
+/**
+ * @brief State of the CoDel policy of a queue
+ * @details See @ref qtip_set_codel. The times are in the unit of the clock
+ *          of the queue.
+ */
+typedef struct
+{
+    uint64_t target;     //!< Sojourn time to keep the queue under, 0 when the policy is off
+    uint64_t interval;   //!< Time the sojourn time may stay above `target` before items are late
+    uint64_t firstAbove; //!< Time at which the sojourn time will have been above `target` for `interval`, 0 if below
+    uint64_t dropNext;   //!< Time of the next late item while dropping
+    uint32_t count;      //!< Number of late items since dropping started
+    uint32_t lastCount;  //!< Value of `count` when dropping last started
+    bool dropping;       //!< The sojourn time has been above `target` for `interval`
+    bool drop;           //!< Pops discard the late items instead of flagging them
+    size_t late;         //!< Number of items dropped or flagged as late
+} qtipCodel_t;
+
+/**
+ * @brief Sojourn time tracking of a queue
+ * @details Supplied by the caller to @ref qtip_enable_sojourn, so a queue that
+ *          does not track sojourn times only holds a pointer.
+ */
+typedef struct
+{
+    uint64_t* pTimestamps;             //!< Put time of the item in each slot
+    qtipClock_t clock;                 //!< Clock that stamps the items
+    void* pClockArg;                   //!< Argument passed to `clock`
+    size_t histogram[SOJOURN_BUCKETS]; //!< Number of pops by sojourn time, in log2 buckets
+    qtipCodel_t codel;                 //!< State of the CoDel policy
+} qtipSojourn_t;
+
+#endif // DISABLE_SOJOURN && REDUCED_API
+
 /**
  * @brief Queue context structure
  */
 typedef struct
 {
     qtipSize_t maxItems; //!< Number of items allowed in the queue
-    qtipSize_t qty;      //!< Current number of items in the queue
-    void* start;         //!< Pointer to the start of the queue
-    qtipSize_t front;    //!< Absolute index of the front of the queue
-    qtipSize_t rear;     //!< Absolute index of the rear of the queue
-    size_t itemSize;     //!< Size of each item in the queue
+#ifndef POWER_OF_TWO
+    qtipSize_t qty; //!< Current number of items in the queue
+#endif
+    void* start;      //!< Pointer to the start of the queue
+    qtipSize_t front; //!< Absolute index of the front of the queue (free-running counter with `POWER_OF_TWO`)
+    qtipSize_t rear;  //!< Absolute index of the rear of the queue (one past the rear with `POWER_OF_TWO`)
+    size_t itemSize;  //!< Size of each item in the queue
 #ifndef DISABLE_LOCK
     bool locked; //!< Lock status
 #endif
+#ifndef REDUCED_API
+    bool reserved; //!< A slot was handed out by @ref qtip_reserve and not committed yet
+#endif
+#if !defined(DISABLE_MIRROR) && !defined(REDUCED_API)
+    bool mirrored; //!< The buffer is mapped twice back-to-back, see @ref qtip_mirror_init
+#endif
+#if !defined(DISABLE_GROW) && !defined(REDUCED_API)
+    const qtipAllocator_t* pAllocator; //!< Memory hooks of a growable queue, NULL for a fixed buffer
+    qtipSize_t minItems;               //!< Capacity a growable queue never shrinks below
+    qtipSize_t capItems;               //!< Capacity a growable queue never grows above
+    qtipSize_t shrinkAfter;            //!< Low pops before a growable queue shrinks, 0 to never shrink
+    qtipSize_t lowPops;                //!< Consecutive pops that left the queue at most a quarter full
+#endif
+#if !defined(DISABLE_TOMBSTONE) && !defined(REDUCED_API)
+    uint8_t* pTombstones;    //!< Bitmap of the removed slots, NULL when removals shift the items
+    qtipSize_t tombstones;   //!< Number of removed items that still take a slot
+    uint32_t compactPercent; //!< Share of removed slots that triggers a compaction, 0 to compact only when full
+#endif
+#if !defined(DISABLE_OVERWRITE) && !defined(REDUCED_API)
+    bool overwrite;     //!< Puts into a full queue replace the front item
+    size_t overwritten; //!< Number of items replaced before they were removed
+#endif
+#if !defined(DISABLE_SOJOURN) && !defined(REDUCED_API)
+    qtipSojourn_t* pSojourn; //!< Sojourn time tracking, NULL when sojourn times are not tracked
+#endif
 #ifndef DISABLE_TELEMETRY
     size_t processed; //!< Number of items removed from the queue
     size_t total;     //!< Number of items introduced to the queue
 #endif
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS) && !defined(REDUCED_API)
+    qtipStats_t* pStats; //!< Statistics since the last reset, NULL when they are not collected
+#endif
+#ifndef DISABLE_NOTIFY
+    qtipNotifyCallback_t notify; //!< Readiness callback, NULL when no notifier is attached
+    void* pNotifyArg;            //!< Argument passed to `notify`
+    qtipSize_t notifyThreshold;  //!< Fill level that also triggers `notify`, 0 to disable
+#endif
 } qtipContext_t;
 
+/*
+ * Public macros
+ */
+
+/**
+ * @brief Defines a statically allocated queue of `N` items of type `T`
+ * @details Emits a zero-initialised queue object called `name` and the
+ *          `static inline` functions `name_put`, `name_pop`, `name_get_front` and
+ *          `name_count`. The item size and the capacity are compile-time
+ *          constants, so copies become plain assignments and no call to
+ *          @ref qtip_init is needed. The functions return the same
+ *          @ref qtipStatus_t values as their @ref qtip_put, @ref qtip_pop and
+ *          @ref qtip_get_front counterparts, but do not check for NULL pointers
+ *          and have no lock or telemetry.
+ * @param name Name of the queue object and prefix of its functions
+ * @param T    Type of the items in the queue
+ * @param N    Maximum number of items allowed in the queue
+ */
+#define QTIP_DEFINE_QUEUE(name, T, N)                                     \
+    static struct                                                         \
+    {                                                                     \
+        T items[N];                                                       \
+        qtipSize_t front;                                                 \
+        qtipSize_t qty;                                                   \
+    } name;                                                               \
+                                                                          \
+    static inline qtipStatus_t name##_put(const T* pItem)                 \
+    {                                                                     \
+        qtipStatus_t status = QTIP_STATUS_FULL;                           \
+        if (name.qty < (qtipSize_t) (N))                                  \
+        {                                                                 \
+            const qtipSize_t untilEnd = (qtipSize_t) (N) - name.front;    \
+            const qtipSize_t tail     = (name.qty < untilEnd)             \
+                                            ? (name.front + name.qty)     \
+                                            : (name.qty - untilEnd);      \
+            name.items[tail]          = *pItem;                           \
+            name.qty++;                                                   \
+            status = QTIP_STATUS_OK;                                      \
+        }                                                                 \
+        return status;                                                    \
+    }                                                                     \
+                                                                          \
+    static inline qtipStatus_t name##_get_front(T* pItem)                 \
+    {                                                                     \
+        qtipStatus_t status = QTIP_STATUS_EMPTY;                          \
+        if (name.qty > 0U)                                                \
+        {                                                                 \
+            *pItem = name.items[name.front];                              \
+            status = QTIP_STATUS_OK;                                      \
+        }                                                                 \
+        return status;                                                    \
+    }                                                                     \
+                                                                          \
+    static inline qtipStatus_t name##_pop(T* pItem)                       \
+    {                                                                     \
+        qtipStatus_t status = name##_get_front(pItem);                    \
+        if (status == QTIP_STATUS_OK)                                     \
+        {                                                                 \
+            name.front = (name.front < ((qtipSize_t) (N) - 1U))           \
+                             ? (name.front + 1U)                          \
+                             : 0U;                                        \
+            name.qty--;                                                   \
+        }                                                                 \
+        return status;                                                    \
+    }                                                                     \
+                                                                          \
+    static inline qtipSize_t name##_count(void)                           \
+    {                                                                     \
+        return name.qty;                                                  \
+    }
+
 /*
  * Public API
  */
@@ -97,17 +304,19 @@ typedef struct
  * @param[in] maxItems Maximum number of items allowed in the queue
  * @param[in] itemSize Size of the item to store in the queue
  * @note      pQueue must be at least maxItems * itemSize bytes
+ * @note      With `POWER_OF_TWO` defined, maxItems must be a power of two
  * @returns   Operation status
  *
  * @details
- *    | Returned @ref qtipStatus_t    | Reason                          |
- *    | ----------------------------- | ------------------------------- |
- *    | @ref QTIP_STATUS_OK           | Operation successful            |
- *    | @ref QTIP_STATUS_LOCKED       | NA                              |
- *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL              |
- *    | @ref QTIP_STATUS_FULL         | NA                              |
- *    | @ref QTIP_STATUS_EMPTY        | NA                              |
- *    | @ref QTIP_STATUS_INVALID_SIZE | `itemSize` or `maxItems` is `0` |
+ *    | Returned @ref qtipStatus_t    | Reason                                                |
+ *    | ----------------------------- | ----------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                  |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                    |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL                                    |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                    |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                    |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `itemSize` or `maxItems` is `0` or not a power of two |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                    |
  */
 qtipStatus_t qtip_init(qtipContext_t* pContext, void* pQueue, qtipSize_t maxItems, size_t itemSize);
 
@@ -127,6 +336,7 @@ qtipStatus_t qtip_init(qtipContext_t* pContext, void* pQueue, qtipSize_t maxItem
  *    | @ref QTIP_STATUS_FULL         | Queue is full                   |
  *    | @ref QTIP_STATUS_EMPTY        | NA                              |
  *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
  */
 qtipStatus_t qtip_put(qtipContext_t* pContext, void* pItem);
 
@@ -146,6 +356,7 @@ qtipStatus_t qtip_put(qtipContext_t* pContext, void* pItem);
  *    | @ref QTIP_STATUS_FULL         | NA                              |
  *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                  |
  *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
  */
 qtipStatus_t qtip_pop(qtipContext_t* pContext, void* pItem);
 
@@ -167,6 +378,7 @@ qtipStatus_t qtip_pop(qtipContext_t* pContext, void* pItem);
  *    | @ref QTIP_STATUS_FULL         | NA                                      |
  *    | @ref QTIP_STATUS_EMPTY        | NA                                      |
  *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                      |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                      |
  */
 qtipStatus_t qtip_peek(qtipContext_t* pContext, void* pBuffer, qtipSize_t* pSize);
 
@@ -185,6 +397,7 @@ qtipStatus_t qtip_peek(qtipContext_t* pContext, void* pBuffer, qtipSize_t* pSize
  *    | @ref QTIP_STATUS_FULL         | NA                                      |
  *    | @ref QTIP_STATUS_EMPTY        | NA                                      |
  *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                      |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                      |
  */
 qtipStatus_t qtip_purge(qtipContext_t* pContext);
 
@@ -204,6 +417,7 @@ qtipStatus_t qtip_purge(qtipContext_t* pContext);
  *    | @ref QTIP_STATUS_FULL         | NA                                      |
  *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                          |
  *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                      |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                      |
  */
 qtipStatus_t qtip_get_front(qtipContext_t* pContext, void* pItem);
 
@@ -223,6 +437,7 @@ qtipStatus_t qtip_get_front(qtipContext_t* pContext, void* pItem);
  *    | @ref QTIP_STATUS_FULL         | NA                                      |
  *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                          |
  *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                      |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                      |
  */
 qtipStatus_t qtip_get_rear(qtipContext_t* pContext, void* pItem);
 
@@ -242,6 +457,7 @@ qtipStatus_t qtip_get_rear(qtipContext_t* pContext, void* pItem);
  *    | @ref QTIP_STATUS_FULL         | Queue is full                   |
  *    | @ref QTIP_STATUS_EMPTY        | NA                              |
  *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
  */
 qtipStatus_t qtip_is_full(qtipContext_t* pContext);
 
@@ -260,6 +476,7 @@ qtipStatus_t qtip_is_full(qtipContext_t* pContext);
  *    | @ref QTIP_STATUS_FULL         | NA                              |
  *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                  |
  *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
  */
 qtipStatus_t qtip_is_empty(qtipContext_t* pContext);
 
@@ -278,6 +495,7 @@ qtipStatus_t qtip_is_empty(qtipContext_t* pContext);
  *    | @ref QTIP_STATUS_FULL         | NA                              |
  *    | @ref QTIP_STATUS_EMPTY        | NA                              |
  *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
  */
 qtipStatus_t qtip_count_items(qtipContext_t* pContext, qtipSize_t* pResult);
 
@@ -299,6 +517,7 @@ qtipStatus_t qtip_count_items(qtipContext_t* pContext, qtipSize_t* pResult);
  *    | @ref QTIP_STATUS_FULL         | NA                              |
  *    | @ref QTIP_STATUS_EMPTY        | NA                              |
  *    | @ref QTIP_STATUS_INVALID_SIZE | Index unavailable               |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
  */
 qtipStatus_t qtip_get_item_index(qtipContext_t* pContext, qtipSize_t index, void* pItem);
 
@@ -319,6 +538,7 @@ qtipStatus_t qtip_get_item_index(qtipContext_t* pContext, qtipSize_t index, void
  *    | @ref QTIP_STATUS_FULL         | NA                              |
  *    | @ref QTIP_STATUS_EMPTY        | NA                              |
  *    | @ref QTIP_STATUS_INVALID_SIZE | Index unavailable               |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
  */
 qtipStatus_t qtip_remove_item_index(qtipContext_t* pContext, qtipSize_t index);
 
@@ -340,9 +560,707 @@ qtipStatus_t qtip_remove_item_index(qtipContext_t* pContext, qtipSize_t index);
  *    | @ref QTIP_STATUS_FULL         | NA                              |
  *    | @ref QTIP_STATUS_EMPTY        | NA                              |
  *    | @ref QTIP_STATUS_INVALID_SIZE | Index unavailable               |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
  */
 qtipStatus_t qtip_get_pop_index(qtipContext_t* pContext, qtipSize_t index, void* pItem);
 
+/**
+ * @brief      Removes every item selected by a predicate
+ * @details    Calls `predicate` once for each item, from the front to the
+ *             rear, and moves the items it does not select forward in a
+ *             single pass, so the queue keeps its order. The predicate must
+ *             not modify the queue.
+ * @param[in]  pContext  Pointer to queue context
+ * @param[in]  predicate Function that selects the items to remove
+ * @param[in]  pArg      Argument passed to `predicate`
+ * @param[out] pRemoved  Pointer to the variable to hold the number of removed items
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                         |
+ *    | ----------------------------- | ---------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                           |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                                |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `predicate` or `pRemoved` is NULL  |
+ *    | @ref QTIP_STATUS_FULL         | NA                                             |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                             |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                             |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                             |
+ */
+qtipStatus_t qtip_remove_if(qtipContext_t* pContext, qtipPredicate_t predicate, void* pArg, qtipSize_t* pRemoved);
+
+/**
+ * @brief      Moves every item selected by a predicate to another queue
+ * @details    Works as @ref qtip_remove_if, but puts each selected item at the
+ *             back of `pTarget` instead of dropping it, so both queues keep
+ *             their order. Once `pTarget` is full, the remaining selected
+ *             items stay in the queue.
+ * @param[in]  pContext  Pointer to queue context
+ * @param[in]  pTarget   Pointer to the context of the queue that receives the items
+ * @param[in]  predicate Function that selects the items to move
+ * @param[in]  pArg      Argument passed to `predicate`
+ * @param[out] pMoved    Pointer to the variable to hold the number of moved items
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                        |
+ *    | ----------------------------- | ------------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                          |
+ *    | @ref QTIP_STATUS_LOCKED       | Either queue is locked                                        |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `pTarget`, `predicate` or `pMoved` is NULL        |
+ *    | @ref QTIP_STATUS_FULL         | `pTarget` filled up and some selected items were not moved    |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                            |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | The item sizes differ, or `pTarget` is the queue itself       |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                            |
+ */
+qtipStatus_t qtip_extract_if(qtipContext_t* pContext,
+                             qtipContext_t* pTarget,
+                             qtipPredicate_t predicate,
+                             void* pArg,
+                             qtipSize_t* pMoved);
+
+/**
+ * @brief     Put several items in a queue
+ * @details   Copies `n` contiguous items from pItems to the back of the queue.
+ *            Either every item is enqueued or none is. The items are copied
+ *            with at most two memory copies, splitting only at the end of the buffer.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pItems   Pointer to the items to store in the queue
+ * @param[in] n        Number of items to store
+ * @note      pItems must be at least n * itemSize bytes
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                               |
+ *    | ----------------------------- | ------------------------------------ |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                 |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                      |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItems` is NULL       |
+ *    | @ref QTIP_STATUS_FULL         | Not enough room for `n` items        |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                   |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                   |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                   |
+ */
+qtipStatus_t qtip_put_n(qtipContext_t* pContext, void* pItems, qtipSize_t n);
+
+/**
+ * @brief      Extract several items from the queue
+ * @details    Pulls and removes the next `n` items in the queue and puts them into pItems.
+ *             Either every item is extracted or none is. The items are copied
+ *             with at most two memory copies, splitting only at the end of the buffer.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItems   Pointer to the buffer to hold the items
+ * @param[in]  n        Number of items to extract
+ * @note       pItems must be at least n * itemSize bytes
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                               |
+ *    | ----------------------------- | ------------------------------------ |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                 |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                      |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItems` is NULL       |
+ *    | @ref QTIP_STATUS_FULL         | NA                                   |
+ *    | @ref QTIP_STATUS_EMPTY        | Less than `n` items in the queue     |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                   |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                   |
+ */
+qtipStatus_t qtip_pop_n(qtipContext_t* pContext, void* pItems, qtipSize_t n);
+
+/**
+ * @brief      Put up to `n` items in a queue
+ * @details    Copies as many of the `n` items in pItems as fit to the back of the queue.
+ * @param[in]  pContext Pointer to queue context
+ * @param[in]  pItems   Pointer to the items to store in the queue
+ * @param[in]  n        Maximum number of items to store
+ * @param[out] pPut     Pointer to the variable to hold the number of stored items
+ * @note       pItems must be at least n * itemSize bytes
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                   |
+ *    | ----------------------------- | ---------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | At least one item stored, or `n` is `0`  |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                          |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `pItems` or `pPut` is NULL   |
+ *    | @ref QTIP_STATUS_FULL         | Queue is full                            |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                       |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                       |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                       |
+ */
+qtipStatus_t qtip_put_up_to_n(qtipContext_t* pContext, void* pItems, qtipSize_t n, qtipSize_t* pPut);
+
+/**
+ * @brief      Extract up to `n` items from the queue
+ * @details    Pulls and removes as many of the next `n` items as are available.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItems   Pointer to the buffer to hold the items
+ * @param[in]  n        Maximum number of items to extract
+ * @param[out] pPopped  Pointer to the variable to hold the number of extracted items
+ * @note       pItems must be at least n * itemSize bytes
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                    |
+ *    | ----------------------------- | ----------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | At least one item popped, or `n` is `0`   |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                           |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `pItems` or `pPopped` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                                        |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                            |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                        |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                        |
+ */
+qtipStatus_t qtip_pop_up_to_n(qtipContext_t* pContext, void* pItems, qtipSize_t n, qtipSize_t* pPopped);
+
+/**
+ * @brief     Put an item at the front of the queue
+ * @details   Copies the value of pItem to the front of the queue, so it is the
+ *            next item to be popped.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pItem    Pointer to item to store in the queue
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                        |
+ *    | ----------------------------- | ----------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful          |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked               |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | Queue is full                 |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                            |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                            |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                            |
+ */
+qtipStatus_t qtip_push_front(qtipContext_t* pContext, void* pItem);
+
+/**
+ * @brief      Extract the item at the back of the queue
+ * @details    Pulls and removes the item at the rear of the queue and puts it
+ *             into pItem, so the queue can also be used as a stack.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItem    Pointer to the variable to hold the item
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                        |
+ *    | ----------------------------- | ----------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful          |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked               |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                            |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                            |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                            |
+ */
+qtipStatus_t qtip_pop_back(qtipContext_t* pContext, void* pItem);
+
+/**
+ * @brief     Put several items at the front of the queue
+ * @details   Copies `n` contiguous items from pItems to the front of the
+ *            queue, keeping their order, so the first of them is the next
+ *            item to be popped. Either every item is enqueued or none is.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pItems   Pointer to the items to store in the queue
+ * @param[in] n        Number of items to store
+ * @note      pItems must be at least n * itemSize bytes
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                         |
+ *    | ----------------------------- | ------------------------------ |
+ *    | @ref QTIP_STATUS_OK           | Operation successful           |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItems` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | Not enough room for `n` items  |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                             |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                             |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                             |
+ */
+qtipStatus_t qtip_push_front_n(qtipContext_t* pContext, void* pItems, qtipSize_t n);
+
+/**
+ * @brief      Extract several items from the back of the queue
+ * @details    Pulls and removes the last `n` items in the queue and puts them
+ *             into pItems in queue order, so the rear item is the last one.
+ *             Either every item is extracted or none is.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItems   Pointer to the buffer to hold the items
+ * @param[in]  n        Number of items to extract
+ * @note       pItems must be at least n * itemSize bytes
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                           |
+ *    | ----------------------------- | -------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful             |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                  |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItems` is NULL   |
+ *    | @ref QTIP_STATUS_FULL         | NA                               |
+ *    | @ref QTIP_STATUS_EMPTY        | Less than `n` items in the queue |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                               |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                               |
+ */
+qtipStatus_t qtip_pop_back_n(qtipContext_t* pContext, void* pItems, qtipSize_t n);
+
+/**
+ * @brief      Reserves the slot at the back of the queue
+ * @details    Returns a pointer to the slot the next item will be stored in, so
+ *             the item can be built in place. The item is enqueued by @ref qtip_commit.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] ppItem   Pointer to the variable to hold the address of the slot
+ * @note       No other item may be put in the queue until the slot is committed
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                 |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `ppItem` is NULL  |
+ *    | @ref QTIP_STATUS_FULL         | Queue is full                   |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_reserve(qtipContext_t* pContext, void** ppItem);
+
+/**
+ * @brief     Enqueues the slot reserved with @ref qtip_reserve
+ * @param[in] pContext Pointer to queue context
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                 |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL              |
+ *    | @ref QTIP_STATUS_FULL         | Queue is full                   |
+ *    | @ref QTIP_STATUS_EMPTY        | No slot is reserved             |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_commit(qtipContext_t* pContext);
+
+/**
+ * @brief      Acquires the item at the front of the queue
+ * @details    Returns a pointer to the item at the front of the queue, so it can
+ *             be used in place. The item is removed by @ref qtip_release.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] ppItem   Pointer to the variable to hold the address of the item
+ * @note       No other item may be popped from the queue until the item is released
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                 |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `ppItem` is NULL  |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                  |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_acquire(qtipContext_t* pContext, void** ppItem);
+
+/**
+ * @brief     Removes the item acquired with @ref qtip_acquire
+ * @details   The slot is freed without being cleared.
+ * @param[in] pContext Pointer to queue context
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                 |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL              |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                  |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_release(qtipContext_t* pContext);
+
+/**
+ * @brief      Gets a view of the items at the front of the queue
+ * @details    Points `ppItems` at the front item and sets `pCount` to the
+ *             number of items stored contiguously from it, which is every item
+ *             in the queue for a buffer set up with @ref qtip_mirror_init and
+ *             the items up to the end of the buffer otherwise. The items stay
+ *             in the queue until they are removed with @ref qtip_release_n.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] ppItems  Pointer to variable to hold the address of the front item
+ * @param[out] pCount   Pointer to variable to hold the number of items in the view
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                       |
+ *    | ----------------------------- | -------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                         |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `ppItems` or `pCount` is NULL    |
+ *    | @ref QTIP_STATUS_FULL         | NA                                           |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                               |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                           |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                           |
+ */
+qtipStatus_t qtip_get_view(qtipContext_t* pContext, void** ppItems, qtipSize_t* pCount);
+
+/**
+ * @brief     Removes n items from the front of the queue without reading them
+ * @details   Meant to consume items used in place through @ref qtip_get_view.
+ *            The slots are freed without being cleared.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] n        Number of items to remove
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                       |
+ *    | ----------------------------- | -------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                         |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL                           |
+ *    | @ref QTIP_STATUS_FULL         | NA                                           |
+ *    | @ref QTIP_STATUS_EMPTY        | The queue holds fewer than `n` items         |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                           |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                           |
+ */
+qtipStatus_t qtip_release_n(qtipContext_t* pContext, qtipSize_t n);
+
+#ifndef DISABLE_GROW
+
+/**
+ * @brief     Initialize a queue that allocates its own buffer and grows on demand
+ * @details   Allocates a buffer of `initialItems` items with the hooks of
+ *            `pAllocator`. When an insertion with @ref qtip_put,
+ *            @ref qtip_put_n, @ref qtip_put_up_to_n or @ref qtip_reserve does
+ *            not fit, the capacity is doubled, up to `capItems`, and the items
+ *            are copied to the new buffer in order, so the wrapped part of the
+ *            queue is unrolled. The insertion only returns
+ *            @ref QTIP_STATUS_FULL once `capItems` is reached or `alloc`
+ *            fails. If `shrinkAfter` is not `0`, the capacity is halved, down
+ *            to `initialItems`, after `shrinkAfter` consecutive pops that leave
+ *            the queue at most a quarter full. The queue must be released with
+ *            @ref qtip_free_growable.
+ * @param[in] pContext     Pointer to queue context
+ * @param[in] pAllocator   Pointer to memory hooks, must outlive the queue
+ * @param[in] initialItems Initial and minimum number of items allowed in the queue
+ * @param[in] capItems     Maximum number of items the queue can grow to
+ * @param[in] itemSize     Size of the item to store in the queue
+ * @param[in] shrinkAfter  Number of low pops before shrinking, `0` to never shrink
+ * @note      `POWER_OF_TWO` requires `initialItems` and `capItems` to be powers of two
+ * @note      The `qtip_fast_` functions never resize the queue
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                               |
+ *    | ----------------------------- | -------------------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                                 |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                                                      |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `pAllocator` or one of its hooks is NULL                 |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                                   |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                                   |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | Invalid sizes, or `capItems` is smaller than `initialItems`          |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | `alloc` failed                                                       |
+ */
+qtipStatus_t qtip_init_growable(qtipContext_t* pContext,
+                                const qtipAllocator_t* pAllocator,
+                                qtipSize_t initialItems,
+                                qtipSize_t capItems,
+                                size_t itemSize,
+                                qtipSize_t shrinkAfter);
+
+/**
+ * @brief     Release the buffer of a growable queue
+ * @details   Frees the buffer with the hooks given to @ref qtip_init_growable.
+ *            The context must be initialized again before it is used.
+ * @param[in] pContext Pointer to queue context
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                 |
+ *    | ----------------------------- | -------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                   |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                        |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL or not growable     |
+ *    | @ref QTIP_STATUS_FULL         | NA                                     |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                     |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                     |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                     |
+ */
+qtipStatus_t qtip_free_growable(qtipContext_t* pContext);
+
+#endif // DISABLE_GROW
+
+#ifndef DISABLE_TOMBSTONE
+
+/**
+ * @brief Size in bytes of the tombstone bitmap of a queue of `maxItems` items
+ */
+#define QTIP_TOMBSTONE_BITMAP_SIZE(maxItems) (((size_t) (maxItems) + 7U) / 8U)
+
+/**
+ * @brief     Makes removals from the middle of the queue mark the item instead of moving the others
+ * @details   From now on, @ref qtip_remove_item_index and
+ *            @ref qtip_get_pop_index mark the slot of an item in the middle
+ *            of the queue as removed in `pBitmap` instead of shifting every
+ *            item behind it. Pops, peeks and index lookups skip the removed
+ *            slots, and the indexes and counts of the API only cover the items
+ *            still in the queue. Finding the slot of an index is still O(n),
+ *            but it counts the removed slots of the bitmap a word at a time,
+ *            so it is much cheaper than moving the items. The removed slots
+ *            are reclaimed by moving the items together, which happens when
+ *            an insertion needs the space, when removed slots exceed
+ *            `compactPercent` percent of the used slots, before
+ *            @ref qtip_get_view and on @ref qtip_compact.
+ * @param[in] pContext       Pointer to queue context
+ * @param[in] pBitmap        Pointer to a bitmap of @ref QTIP_TOMBSTONE_BITMAP_SIZE bytes
+ * @param[in] compactPercent Percentage of removed slots that triggers a compaction, `0` to wait for a full queue
+ * @note      The `qtip_fast_` functions must not be used while the queue holds removed slots
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                |
+ *    | ----------------------------- | ----------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                  |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                                       |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pBitmap` is NULL                       |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                    |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                    |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `compactPercent` is over 100 or the queue is growable |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                    |
+ */
+qtipStatus_t qtip_enable_tombstones(qtipContext_t* pContext, uint8_t* pBitmap, uint32_t compactPercent);
+
+/**
+ * @brief     Reclaims the slots of the removed items
+ * @details   Moves the items behind removed slots forward, keeping their
+ *            order. Does nothing if no slot is marked as removed.
+ * @param[in] pContext Pointer to queue context
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                       |
+ *    | ----------------------------- | -------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                         |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL                           |
+ *    | @ref QTIP_STATUS_FULL         | NA                                           |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                           |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                           |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                           |
+ */
+qtipStatus_t qtip_compact(qtipContext_t* pContext);
+
+#endif // DISABLE_TOMBSTONE
+
+#ifndef DISABLE_OVERWRITE
+
+/**
+ * @brief     Makes puts into a full queue replace the oldest item
+ * @details   While enabled, @ref qtip_put on a full queue writes the new item
+ *            over the front item in place and moves the front forward, so the
+ *            queue keeps the newest `maxItems` items. The replaced items are
+ *            counted by @ref qtip_total_overwritten_items. The other insertions
+ *            still return @ref QTIP_STATUS_FULL.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] enabled  `true` to replace the oldest item, `false` to reject the put
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason               |
+ *    | ----------------------------- | -------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked      |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL   |
+ *    | @ref QTIP_STATUS_FULL         | NA                   |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                   |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                   |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                   |
+ */
+qtipStatus_t qtip_set_overwrite(qtipContext_t* pContext, bool enabled);
+
+/**
+ * @brief      Get number of items replaced by puts into a full queue
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pResult  Pointer to the variable to hold the result
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_total_overwritten_items(qtipContext_t* pContext, size_t* pResult);
+
+#endif // DISABLE_OVERWRITE
+
+#ifndef DISABLE_SOJOURN
+
+/**
+ * @brief     Tracks how long the items wait in the queue
+ * @details   From now on, every insertion stamps the slot of the item in
+ *            `pTimestamps` with the time of `clock`, and every pop, back pop
+ *            and release records the sojourn time of each item it removes in
+ *            a histogram of @ref SOJOURN_BUCKETS log2 buckets, read with
+ *            @ref qtip_get_sojourn_percentile. The histogram and the state of
+ *            the CoDel policy are kept in `pSojourn`, which is cleared first.
+ *            The items already in the queue are stamped with the current time.
+ *            The layout of the items does not change.
+ * @param[in] pContext    Pointer to queue context
+ * @param[in] pSojourn    Pointer to the sojourn time tracking of the queue
+ * @param[in] pTimestamps Pointer to an array of `maxItems` timestamps
+ * @param[in] clock       Clock that stamps the items
+ * @param[in] pClockArg   Argument passed to `clock`
+ * @note      The items popped by @ref qtip_fast_pop are not recorded
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                   |
+ *    | ----------------------------- | -------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                     |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                                          |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `pSojourn`, `pTimestamps` or `clock` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                       |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                       |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | The queue is growable                                    |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                       |
+ */
+qtipStatus_t qtip_enable_sojourn(qtipContext_t* pContext,
+                                 qtipSojourn_t* pSojourn,
+                                 uint64_t* pTimestamps,
+                                 qtipClock_t clock,
+                                 void* pClockArg);
+
+/**
+ * @brief      Extract the next item from the queue along with its sojourn time
+ * @details    Works as @ref qtip_pop, and also reports how long the item was
+ *             in the queue and whether the CoDel policy found it late. Both
+ *             are `0` if the sojourn times are not tracked.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItem    Pointer to item to store in the queue
+ * @param[out] pSojourn Pointer to variable to hold the sojourn time of the item
+ * @param[out] pLate    Pointer to variable set when the item is flagged as late
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                             |
+ *    | ----------------------------- | -------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                               |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                                    |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `pItem`, `pSojourn` or `pLate` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                 |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                                     |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                                 |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                 |
+ */
+qtipStatus_t qtip_pop_timed(qtipContext_t* pContext, void* pItem, uint64_t* pSojourn, bool* pLate);
+
+/**
+ * @brief      Get a percentile of the sojourn times of the popped items
+ * @details    The result is the upper bound of the histogram bucket that holds
+ *             the percentile, so it is at most twice the real value. It is
+ *             `UINT64_MAX` if the percentile falls in the last bucket, which
+ *             has no upper bound.
+ * @param[in]  pContext Pointer to queue context
+ * @param[in]  percent  Percentile to get, from `0` to `100`
+ * @param[out] pResult  Pointer to variable to hold the result
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | No sojourn time was recorded    |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `percent` is over 100           |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_get_sojourn_percentile(qtipContext_t* pContext, uint32_t percent, uint64_t* pResult);
+
+/**
+ * @brief     Clears the recorded sojourn times
+ * @param[in] pContext Pointer to queue context
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL              |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_reset_sojourns(qtipContext_t* pContext);
+
+/**
+ * @brief     Bounds the time items wait in the queue with a CoDel policy
+ * @details   Once the sojourn time of the items leaving the front of the
+ *            queue has stayed above `target` for `interval`, they are late at
+ *            a rate that grows with the square root of the number of late
+ *            items, until the sojourn time falls below `target` again. Each
+ *            pop or release judges the oldest item it removes. Late items are
+ *            discarded if `drop` is set, and otherwise returned flagged
+ *            through @ref qtip_pop_timed. Released items were already used in
+ *            place, and the items a call asked for are always left, so those
+ *            are only counted as late. The last item in the queue is never
+ *            late. The times are in the unit of the clock of
+ *            @ref qtip_enable_sojourn, and the state of the policy is kept
+ *            with the sojourn time tracking, so it must be enabled first.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] target   Acceptable sojourn time, `0` to disable the policy
+ * @param[in] interval Time the sojourn time may stay above `target`
+ * @param[in] drop     Discard the late items instead of flagging them
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                                |
+ *    | ----------------------------- | --------------------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                                  |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                                                       |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL                                                    |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                                    |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                                    |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `interval` is 0 with a `target` set, or sojourn times are not tracked |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                                    |
+ */
+qtipStatus_t qtip_set_codel(qtipContext_t* pContext, uint64_t target, uint64_t interval, bool drop);
+
+/**
+ * @brief      Get number of items dropped or flagged as late by the CoDel policy
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pResult  Pointer to variable to hold the result
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_total_late_items(qtipContext_t* pContext, size_t* pResult);
+
+#endif // DISABLE_SOJOURN
+
 #endif // REDUCED_API
 
 #ifndef DISABLE_LOCK
@@ -362,6 +1280,7 @@ qtipStatus_t qtip_get_pop_index(qtipContext_t* pContext, qtipSize_t index, void*
  *    | @ref QTIP_STATUS_FULL         | NA                              |
  *    | @ref QTIP_STATUS_EMPTY        | NA                              |
  *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
  */
 qtipStatus_t qtip_is_locked(qtipContext_t* pContext);
 
@@ -379,6 +1298,7 @@ qtipStatus_t qtip_is_locked(qtipContext_t* pContext);
  *    | @ref QTIP_STATUS_FULL         | NA                              |
  *    | @ref QTIP_STATUS_EMPTY        | NA                              |
  *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
  */
 qtipStatus_t qtip_lock(qtipContext_t* pContext);
 
@@ -396,11 +1316,49 @@ qtipStatus_t qtip_lock(qtipContext_t* pContext);
  *    | @ref QTIP_STATUS_FULL         | NA                              |
  *    | @ref QTIP_STATUS_EMPTY        | NA                              |
  *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
  */
 qtipStatus_t qtip_unlock(qtipContext_t* pContext);
 
 #endif // DISABLE_LOCK
 
+#ifndef DISABLE_NOTIFY
+
+/**
+ * @brief     Attaches a readiness notifier to the queue
+ * @details   `callback` is called with `pArg` when an insertion makes the queue
+ *            go from empty to non-empty and, if `threshold` is not 0, when an
+ *            insertion makes the number of items reach `threshold`. Insertions
+ *            into a queue that is already non-empty and above the threshold
+ *            do not call it, so a burst of insertions causes a single
+ *            notification until the consumer drains the queue again. The
+ *            callback runs inside the inserting call while the queue is
+ *            locked, so it must not use the queue. A NULL `callback` detaches
+ *            the notifier. @ref qtip_init detaches any previous notifier.
+ * @param[in] pContext  Pointer to queue context
+ * @param[in] callback  Function to call, or NULL to detach the notifier
+ * @param[in] pArg      Argument passed to `callback`
+ * @param[in] threshold Number of items that also triggers `callback`, 0 to disable
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                 |
+ *    | ----------------------------- | -------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                   |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                        |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL                     |
+ *    | @ref QTIP_STATUS_FULL         | NA                                     |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                     |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `threshold` is greater than `maxItems` |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                     |
+ */
+qtipStatus_t qtip_set_notifier(qtipContext_t* pContext,
+                               qtipNotifyCallback_t callback,
+                               void* pArg,
+                               qtipSize_t threshold);
+
+#endif // DISABLE_NOTIFY
+
 #ifndef DISABLE_TELEMETRY
 
 /**
@@ -419,6 +1377,7 @@ qtipStatus_t qtip_unlock(qtipContext_t* pContext);
  *    | @ref QTIP_STATUS_FULL         | NA                              |
  *    | @ref QTIP_STATUS_EMPTY        | NA                              |
  *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
  */
 qtipStatus_t qtip_total_enqueued_items(qtipContext_t* pContext, size_t* pResult);
 
@@ -438,15 +1397,68 @@ qtipStatus_t qtip_total_enqueued_items(qtipContext_t* pContext, size_t* pResult)
  *    | @ref QTIP_STATUS_FULL         | NA                              |
  *    | @ref QTIP_STATUS_EMPTY        | NA                              |
  *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
  */
 qtipStatus_t qtip_total_processed_items(qtipContext_t* pContext, size_t* pResult);
 
-#endif // DISABLE_TELEMETRY
+#if !defined(DISABLE_STATS) && !defined(REDUCED_API)
 
-#endif // QTIP_H
+/**
+ * @brief     Collects the statistics of the queue
+ * @details   From now on, the puts, pops, pushes to the front, pops from the
+ *            back, reservations and acquisitions of the queue are recorded in
+ *            `pStats`, which is cleared first and read with
+ *            @ref qtip_get_stats. The statistics live with the caller, so a
+ *            queue that does not collect them only holds a pointer.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pStats   Pointer to the statistics to record into
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                         |
+ *    | ----------------------------- | ------------------------------ |
+ *    | @ref QTIP_STATUS_OK           | Operation successful           |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pStats` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                             |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                             |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                             |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                             |
+ */
+qtipStatus_t qtip_enable_stats(qtipContext_t* pContext, qtipStats_t* pStats);
+
+/**
+ * @brief      Get the statistics of the queue
+ * @details    The statistics cover the calls since @ref qtip_enable_stats or
+ *             the last reset, but not the unchecked calls of qtip_fast.h. The
+ *             fill level counts the slots still taken by removed items. The
+ *             result is all zeros if the queue does not collect statistics.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pStats   Pointer to variable to hold the statistics
+ * @param[in]  reset    Clear the statistics after reading them
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                         |
+ *    | ----------------------------- | ------------------------------ |
+ *    | @ref QTIP_STATUS_OK           | Operation successful           |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                             |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pStats` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                             |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                             |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                             |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                             |
+ */
+qtipStatus_t qtip_get_stats(qtipContext_t* pContext, qtipStats_t* pStats, bool reset);
+
+#endif // DISABLE_STATS && REDUCED_API
+
+#endif // DISABLE_TELEMETRY
 
 QTIP_CPP_SUPPORT_END
 
+#endif // QTIP_H
+
 /**
  * @}
  */
\ No newline at end of file
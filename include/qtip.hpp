@@ -0,0 +1,265 @@
+/**
+ * @file qtip.hpp
+ * @brief Header-only C++ API for queues of non-trivial objects
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * @addtogroup API
+ * @{
+ */
+
+#ifndef QTIP_HPP
+#define QTIP_HPP
+
+#include "qtip.h"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace qtip
+{
+
+/**
+ * @brief Circular buffer of objects of type `T` with the storage given by `Storage`
+ * @details Uses the same front index and item counter as the C queue, but
+ *          constructs items in place and moves them out, so types that are
+ *          not trivially copyable can be stored. Items left in the queue are
+ *          destroyed with the queue. There is no lock nor telemetry.
+ * @tparam T       Type of the items in the queue
+ * @tparam Storage Type providing `data()` and `capacity()` for the slots
+ */
+template <typename T, typename Storage>
+class basic_ring : private Storage
+{
+public:
+    using value_type = T;
+
+    using Storage::capacity;
+    using Storage::Storage;
+
+    basic_ring(const basic_ring&)            = delete;
+    basic_ring& operator=(const basic_ring&) = delete;
+
+    ~basic_ring()
+    {
+        purge();
+    }
+
+    /**
+     * @brief   Constructs an item in place at the back of the queue
+     * @param   args Arguments forwarded to the constructor of `T`
+     * @returns @ref QTIP_STATUS_OK, or @ref QTIP_STATUS_FULL if the queue is full
+     */
+    template <typename... Args>
+    qtipStatus_t emplace(Args&&... args)
+    {
+        qtipStatus_t status = QTIP_STATUS_FULL;
+
+        if (!full())
+        {
+            ::new (static_cast<void*>(slot(wrap_index(front_ + qty_)))) T(std::forward<Args>(args)...);
+            qty_++;
+            status = QTIP_STATUS_OK;
+        }
+
+        return status;
+    }
+
+    /**
+     * @brief   Copies an item to the back of the queue
+     * @returns @ref QTIP_STATUS_OK, or @ref QTIP_STATUS_FULL if the queue is full
+     */
+    qtipStatus_t put(const T& item)
+    {
+        return emplace(item);
+    }
+
+    /**
+     * @brief   Moves an item to the back of the queue
+     * @returns @ref QTIP_STATUS_OK, or @ref QTIP_STATUS_FULL if the queue is full
+     */
+    qtipStatus_t put(T&& item)
+    {
+        return emplace(std::move(item));
+    }
+
+    /**
+     * @brief   Moves the front item out of the queue and destroys its slot
+     * @param   item Object to move the front item into
+     * @returns @ref QTIP_STATUS_OK, or @ref QTIP_STATUS_EMPTY if the queue is empty
+     */
+    qtipStatus_t pop(T& item)
+    {
+        qtipStatus_t status = QTIP_STATUS_EMPTY;
+
+        if (!empty())
+        {
+            T* pFront = slot(front_);
+            item      = std::move(*pFront);
+            pFront->~T();
+            advance_front();
+            status = QTIP_STATUS_OK;
+        }
+
+        return status;
+    }
+
+    /**
+     * @brief   Destroys the front item
+     * @returns @ref QTIP_STATUS_OK, or @ref QTIP_STATUS_EMPTY if the queue is empty
+     */
+    qtipStatus_t pop()
+    {
+        qtipStatus_t status = QTIP_STATUS_EMPTY;
+
+        if (!empty())
+        {
+            slot(front_)->~T();
+            advance_front();
+            status = QTIP_STATUS_OK;
+        }
+
+        return status;
+    }
+
+    /**
+     * @brief   Gets the front item
+     * @returns Pointer to the front item, or `nullptr` if the queue is empty
+     */
+    T* front()
+    {
+        return empty() ? nullptr : slot(front_);
+    }
+
+    /**
+     * @brief   Gets the rear item
+     * @returns Pointer to the rear item, or `nullptr` if the queue is empty
+     */
+    T* rear()
+    {
+        return empty() ? nullptr : slot(wrap_index(front_ + qty_ - 1U));
+    }
+
+    /**
+     * @brief Destroys every item in the queue
+     */
+    void purge()
+    {
+        while (pop() == QTIP_STATUS_OK)
+        {
+        }
+        front_ = 0U;
+    }
+
+    qtipSize_t count_items() const
+    {
+        return qty_;
+    }
+
+    bool empty() const
+    {
+        return qty_ == 0U;
+    }
+
+    bool full() const
+    {
+        return qty_ == capacity();
+    }
+
+private:
+    qtipSize_t wrap_index(qtipSize_t index) const
+    {
+        return (index < capacity()) ? index : (index - capacity());
+    }
+
+    void advance_front()
+    {
+        front_ = wrap_index(front_ + 1U);
+        qty_--;
+    }
+
+    T* slot(qtipSize_t index)
+    {
+        return std::launder(reinterpret_cast<T*>(Storage::data() + index * sizeof(T)));
+    }
+
+    qtipSize_t front_ = 0U; //!< Index of the front of the queue
+    qtipSize_t qty_   = 0U; //!< Current number of items in the queue
+};
+
+/**
+ * @brief Slots embedded in the queue object, with the capacity known at compile time
+ */
+template <typename T, qtipSize_t N>
+class static_storage
+{
+    static_assert(N > 0U, "a queue needs at least one slot");
+
+public:
+    static_storage() = default;
+
+    static constexpr qtipSize_t capacity()
+    {
+        return N;
+    }
+
+protected:
+    unsigned char* data()
+    {
+        return buffer_;
+    }
+
+private:
+    alignas(T) unsigned char buffer_[N * sizeof(T)];
+};
+
+/**
+ * @brief Slots in a caller-supplied buffer, with the capacity given at run time
+ * @note  The buffer must be at least `maxItems * sizeof(T)` bytes, aligned to
+ *        `alignof(T)`, and outlive the queue
+ */
+template <typename T>
+class buffer_storage
+{
+public:
+    buffer_storage(void* pBuffer, qtipSize_t maxItems) : buffer_(static_cast<unsigned char*>(pBuffer)), maxItems_(maxItems)
+    {
+    }
+
+    qtipSize_t capacity() const
+    {
+        return maxItems_;
+    }
+
+protected:
+    unsigned char* data()
+    {
+        return buffer_;
+    }
+
+private:
+    unsigned char* buffer_;
+    qtipSize_t maxItems_;
+};
+
+/**
+ * @brief Queue of up to `N` items of type `T` stored inside the object
+ */
+template <typename T, qtipSize_t N>
+using ring = basic_ring<T, static_storage<T, N>>;
+
+/**
+ * @brief Queue of items of type `T` stored in a caller-supplied buffer
+ */
+template <typename T>
+using dynamic_ring = basic_ring<T, buffer_storage<T>>;
+
+} // namespace qtip
+
+#endif // QTIP_HPP
+
+/**
+ * @}
+ */
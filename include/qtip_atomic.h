@@ -0,0 +1,37 @@
+/**
+ * @file qtip_atomic.h
+ * @brief Atomic and alignment helpers for the concurrent queues
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * @addtogroup API
+ * @{
+ */
+
+#ifndef QTIP_ATOMIC_H
+#define QTIP_ATOMIC_H
+
+/*
+ * Public defines
+ */
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64U //!< Size of a cache line in bytes, used to keep producer and consumer data apart
+#endif
+
+#ifdef __cplusplus
+// clang-format off
+#include <atomic>
+#define QTIP_ATOMIC(type) std::atomic<type> //!< Atomic type specifier
+#define QTIP_ALIGNAS(size) alignas(size)    //!< Alignment specifier
+#else
+#include <stdatomic.h>
+#define QTIP_ATOMIC(type) _Atomic(type)     //!< Atomic type specifier
+#define QTIP_ALIGNAS(size) _Alignas(size)   //!< Alignment specifier
+// clang-format on
+#endif
+
+#endif // QTIP_ATOMIC_H
+
+/**
+ * @}
+ */
@@ -0,0 +1,59 @@
+/**
+ * @file qtip_eventfd.h
+ * @brief eventfd readiness notification for queues
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * @addtogroup API
+ * @{
+ */
+
+#ifndef QTIP_EVENTFD_H
+#define QTIP_EVENTFD_H
+
+#include "qtip.h"
+
+QTIP_CPP_SUPPORT_START
+
+#if defined(__linux__) && !defined(DISABLE_NOTIFY)
+
+/*
+ * Public API
+ */
+
+/**
+ * @brief     Signals an eventfd when the queue becomes ready to be consumed
+ * @details   Attaches a notifier (see @ref qtip_set_notifier) that adds 1 to
+ *            the counter of `fd`, so the descriptor becomes readable for
+ *            `epoll`, `poll` or `select` on the empty-to-non-empty transition
+ *            and when the number of items reaches `threshold`. The consumer
+ *            should read `fd` to reset it and then pop until the queue is
+ *            empty, which re-arms the notification. The descriptor is owned
+ *            by the caller and should be created with `EFD_NONBLOCK`.
+ * @param[in] pContext  Pointer to queue context
+ * @param[in] fd        eventfd descriptor to signal
+ * @param[in] threshold Number of items that also signals `fd`, 0 to disable
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                     |
+ *    | ----------------------------- | ---------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                       |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                                            |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL                                         |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                         |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                         |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `fd` is negative or `threshold` is greater than `maxItems` |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                         |
+ */
+qtipStatus_t qtip_eventfd_attach(qtipContext_t* pContext, int fd, qtipSize_t threshold);
+
+#endif // __linux__ && DISABLE_NOTIFY
+
+QTIP_CPP_SUPPORT_END
+
+#endif // QTIP_EVENTFD_H
+
+/**
+ * @}
+ */
@@ -0,0 +1,288 @@
+/**
+ * @file qtip_fast.h
+ * @brief Inline unchecked API for queues
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * @addtogroup API
+ * @{
+ */
+
+#ifndef QTIP_FAST_H
+#define QTIP_FAST_H
+
+#include "qtip.h"
+
+#include <string.h>
+
+QTIP_CPP_SUPPORT_START
+
+/*
+ * Public API
+ *
+ * The functions in this file operate on a context already set up by
+ * @ref qtip_init. They do not check their arguments, nor check or take the
+ * queue lock, so the caller must guarantee that no other function uses the
+ * queue at the same time. The queue state and the `total` and `processed`
+ * counters are updated like the checked API does, so both APIs can be mixed
+ * on the same queue, with these restrictions:
+ *
+ * - @ref qtip_fast_put never grows the queue nor overwrites the front item,
+ *   it returns @ref QTIP_STATUS_FULL once the current slots are used.
+ * - The slots removed through @ref qtip_enable_tombstones are still counted,
+ *   read and popped as items, so none of these functions may be used while
+ *   the queue holds any. @ref qtip_compact reclaims them.
+ * - The statistics of @ref qtip_get_stats are not updated.
+ * - @ref qtip_fast_put stamps the items for @ref qtip_enable_sojourn, but
+ *   @ref qtip_fast_pop neither records their sojourn time nor applies the
+ *   CoDel policy.
+ */
+
+/**
+ * @brief     Gets the number of items in a queue
+ * @param[in] pContext Pointer to queue context
+ * @returns   Number of items in the queue
+ */
+static inline qtipSize_t qtip_fast_count_items(const qtipContext_t* pContext)
+{
+#ifdef POWER_OF_TWO
+    return (qtipSize_t) (pContext->rear - pContext->front);
+#else
+    return pContext->qty;
+#endif
+}
+
+/**
+ * @brief     Checks whether a queue is empty
+ * @param[in] pContext Pointer to queue context
+ * @returns   `true` if the queue has no items
+ */
+static inline bool qtip_fast_is_empty(const qtipContext_t* pContext)
+{
+    return qtip_fast_count_items(pContext) == 0U;
+}
+
+/**
+ * @brief     Checks whether a queue is full
+ * @param[in] pContext Pointer to queue context
+ * @returns   `true` if the queue has no free slots
+ */
+static inline bool qtip_fast_is_full(const qtipContext_t* pContext)
+{
+    return qtip_fast_count_items(pContext) == pContext->maxItems;
+}
+
+/**
+ * @brief     Gets the slot index of the front item
+ * @param[in] pContext Pointer to queue context
+ * @note      Only meaningful if the queue is not empty
+ * @returns   Slot index of the front item
+ */
+static inline qtipSize_t qtip_fast_front_index(const qtipContext_t* pContext)
+{
+#ifdef POWER_OF_TWO
+    return pContext->front & (pContext->maxItems - 1U);
+#else
+    return pContext->front;
+#endif
+}
+
+/**
+ * @brief     Gets the slot index of the rear item
+ * @param[in] pContext Pointer to queue context
+ * @note      Only meaningful if the queue is not empty
+ * @returns   Slot index of the rear item
+ */
+static inline qtipSize_t qtip_fast_rear_index(const qtipContext_t* pContext)
+{
+#ifdef POWER_OF_TWO
+    return (pContext->rear - 1U) & (pContext->maxItems - 1U);
+#else
+    return pContext->rear;
+#endif
+}
+
+/**
+ * @brief     Gets the slot index the next item will be put in
+ * @param[in] pContext Pointer to queue context
+ * @note      Only meaningful if the queue is not full
+ * @returns   Slot index of the next item
+ */
+static inline qtipSize_t qtip_fast_tail_index(const qtipContext_t* pContext)
+{
+#ifdef POWER_OF_TWO
+    return pContext->rear & (pContext->maxItems - 1U);
+#else
+    qtipSize_t index = 0U;
+    if (pContext->qty > 0U)
+    {
+        index = (pContext->rear < (pContext->maxItems - 1U)) ? (pContext->rear + 1U) : 0U;
+    }
+    return index;
+#endif
+}
+
+/**
+ * @brief     Gets the address of a slot
+ * @param[in] pContext Pointer to queue context
+ * @param[in] index    Slot index
+ * @returns   Address of the slot
+ */
+static inline void* qtip_fast_slot_address(const qtipContext_t* pContext, qtipSize_t index)
+{
+    return (char*) pContext->start + index * pContext->itemSize;
+}
+
+#ifndef DISABLE_NOTIFY
+
+/**
+ * @brief     Calls the notifier of a queue that has just received items
+ * @details   Calls the callback attached with @ref qtip_set_notifier when the
+ *            queue was empty before the insertion, or when the insertion made
+ *            the number of items reach the notification threshold.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] before   Number of items in the queue before the insertion
+ */
+static inline void qtip_fast_notify(qtipContext_t* pContext, qtipSize_t before)
+{
+    if (pContext->notify != NULL)
+    {
+        const qtipSize_t threshold = pContext->notifyThreshold;
+
+        if ((before == 0U) || ((before < threshold) && (qtip_fast_count_items(pContext) >= threshold)))
+        {
+            pContext->notify(pContext->pNotifyArg);
+        }
+    }
+}
+
+#endif // DISABLE_NOTIFY
+
+/**
+ * @brief     Put an item in a queue without checks
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pItem    Pointer to item to store in the queue
+ * @returns   @ref QTIP_STATUS_OK, or @ref QTIP_STATUS_FULL if the queue is full
+ */
+static inline qtipStatus_t qtip_fast_put(qtipContext_t* pContext, const void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_FULL;
+
+    if (!qtip_fast_is_full(pContext))
+    {
+        const qtipSize_t tail = qtip_fast_tail_index(pContext);
+#ifndef DISABLE_NOTIFY
+        const qtipSize_t before = qtip_fast_count_items(pContext);
+#endif
+
+        memcpy(qtip_fast_slot_address(pContext, tail), pItem, pContext->itemSize);
+#if !defined(DISABLE_SOJOURN) && !defined(REDUCED_API)
+        if (pContext->pSojourn != NULL)
+        {
+            pContext->pSojourn->pTimestamps[tail] = pContext->pSojourn->clock(pContext->pSojourn->pClockArg);
+        }
+#endif
+#ifdef POWER_OF_TWO
+        pContext->rear++;
+#else
+        pContext->rear = tail;
+        pContext->qty++;
+#endif
+
+#ifndef DISABLE_NOTIFY
+        qtip_fast_notify(pContext, before);
+#endif
+
+#ifndef DISABLE_TELEMETRY
+        pContext->total++;
+#endif
+        status = QTIP_STATUS_OK;
+    }
+
+    return status;
+}
+
+/**
+ * @brief      Extract the next item from a queue without checks
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItem    Pointer to the variable to hold the item
+ * @returns    @ref QTIP_STATUS_OK, or @ref QTIP_STATUS_EMPTY if the queue is empty
+ */
+static inline qtipStatus_t qtip_fast_pop(qtipContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_EMPTY;
+
+    if (!qtip_fast_is_empty(pContext))
+    {
+        void* pSlot = qtip_fast_slot_address(pContext, qtip_fast_front_index(pContext));
+
+        memcpy(pItem, pSlot, pContext->itemSize);
+        memset(pSlot, 0, pContext->itemSize);
+#ifdef POWER_OF_TWO
+        pContext->front++;
+#else
+        pContext->qty--;
+        if (pContext->qty == 0U)
+        {
+            pContext->front = 0U;
+        }
+        else
+        {
+            pContext->front = (pContext->front < (pContext->maxItems - 1U)) ? (pContext->front + 1U) : 0U;
+        }
+#endif
+
+#ifndef DISABLE_TELEMETRY
+        pContext->processed++;
+#endif
+        status = QTIP_STATUS_OK;
+    }
+
+    return status;
+}
+
+/**
+ * @brief      Read the front item of a queue without checks
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItem    Pointer to the variable to hold the item
+ * @returns    @ref QTIP_STATUS_OK, or @ref QTIP_STATUS_EMPTY if the queue is empty
+ */
+static inline qtipStatus_t qtip_fast_get_front(const qtipContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_EMPTY;
+
+    if (!qtip_fast_is_empty(pContext))
+    {
+        memcpy(pItem, qtip_fast_slot_address(pContext, qtip_fast_front_index(pContext)), pContext->itemSize);
+        status = QTIP_STATUS_OK;
+    }
+
+    return status;
+}
+
+/**
+ * @brief      Read the rear item of a queue without checks
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItem    Pointer to the variable to hold the item
+ * @returns    @ref QTIP_STATUS_OK, or @ref QTIP_STATUS_EMPTY if the queue is empty
+ */
+static inline qtipStatus_t qtip_fast_get_rear(const qtipContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_EMPTY;
+
+    if (!qtip_fast_is_empty(pContext))
+    {
+        memcpy(pItem, qtip_fast_slot_address(pContext, qtip_fast_rear_index(pContext)), pContext->itemSize);
+        status = QTIP_STATUS_OK;
+    }
+
+    return status;
+}
+
+QTIP_CPP_SUPPORT_END
+
+#endif // QTIP_FAST_H
+
+/**
+ * @}
+ */
@@ -0,0 +1,227 @@
+/**
+ * @file qtip_file.h
+ * @brief API for queues persisted in a memory-mapped file
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * @addtogroup API
+ * @{
+ */
+
+#ifndef QTIP_FILE_H
+#define QTIP_FILE_H
+
+#include "qtip.h"
+
+#include <stdint.h>
+
+QTIP_CPP_SUPPORT_START
+
+#if !defined(DISABLE_FILE) && !defined(REDUCED_API)
+
+/*
+ * Public defines
+ */
+
+#define QTIP_FILE_MAGIC   0x51544946U //!< Marks a formatted queue file ("QTIF")
+#define QTIP_FILE_VERSION 1U          //!< Version of the file layout
+
+/*
+ * Public Structs
+ */
+
+/**
+ * @brief Queue state stored in a queue file
+ * @details `front`, `rear` and `count` are the indexes and the number of items
+ *          of @ref qtipContext_t, so they are only meaningful for the
+ *          `POWER_OF_TWO` setting recorded in the file. `checksum` covers the
+ *          other fields and tells a complete state from a torn one.
+ */
+typedef struct
+{
+    uint64_t sequence;  //!< Number of the flush that wrote the state
+    uint64_t front;     //!< Front index of the queue
+    uint64_t rear;      //!< Rear index of the queue
+    uint64_t count;     //!< Number of items in the queue
+    uint64_t total;     //!< Number of items introduced to the queue
+    uint64_t processed; //!< Number of items removed from the queue
+    uint64_t checksum;  //!< FNV-1a hash of the fields above
+} qtipFileState_t;
+
+/**
+ * @brief Header at the start of a queue file
+ * @details The items start at `itemsOffset`, which is a multiple of the page
+ *          size. Every flush writes the queue state into the older of the two
+ *          state slots once the items it covers are on the disk, so the newer
+ *          slot with a valid checksum always describes a consistent queue.
+ */
+typedef struct
+{
+    uint32_t magic;             //!< @ref QTIP_FILE_MAGIC once the file is formatted
+    uint32_t version;           //!< @ref QTIP_FILE_VERSION
+    uint32_t flags;             //!< Build settings that change the meaning of the state
+    uint32_t reserved;          //!< Reserved, always `0`
+    uint64_t maxItems;          //!< Number of items allowed in the queue
+    uint64_t itemSize;          //!< Size of each item in the queue
+    uint64_t itemsOffset;       //!< Offset of the first item from the start of the file
+    qtipFileState_t states[2U]; //!< Alternating copies of the queue state
+} qtipFileHeader_t;
+
+/**
+ * @brief Queue file context structure
+ * @details `queue` is a regular queue whose items live in the mapped file. It
+ *          can be read with the core API, such as @ref qtip_get_front,
+ *          @ref qtip_count_items or @ref qtip_total_enqueued_items, but it must
+ *          only be modified through the `qtip_file_` functions, which persist
+ *          its state.
+ */
+typedef struct
+{
+    qtipContext_t queue;       //!< Queue on the items of the file
+    qtipFileHeader_t* pHeader; //!< Header of the file, as mapped in this process
+    size_t mapSize;            //!< Size of the mapping
+    int fd;                    //!< Descriptor of the file
+    uint64_t sequence;         //!< Number of the last state written to the file
+    uint32_t syncEvery;        //!< Updates between flushes, `0` to disable
+    uint32_t syncIntervalMs;   //!< Milliseconds between flushes, `0` to disable
+    uint32_t pending;          //!< Updates since the last flush
+    uint64_t lastSyncNs;       //!< Time of the last flush in nanoseconds
+} qtipFileContext_t;
+
+/*
+ * Public API
+ */
+
+/**
+ * @brief     Open a queue file, creating it if needed
+ * @details   Creates and formats the file if it does not exist or was never
+ *            fully formatted. Otherwise recovers the queue from the newest
+ *            valid state in the file. The state is only written to the file
+ *            when it is flushed, after the items it covers, every `syncEvery`
+ *            updates or every `syncIntervalMs` milliseconds, whichever comes
+ *            first, and by @ref qtip_file_sync and @ref qtip_file_close. A put
+ *            into a slot popped since the last flush also flushes first. After
+ *            a crash of the process or of the system, the queue is recovered
+ *            as of the last flush: the items popped since then are popped
+ *            again, and the items put since then are lost.
+ * @param[in] pContext       Pointer to queue file context
+ * @param[in] path           Path of the file
+ * @param[in] maxItems       Maximum number of items allowed in the queue
+ * @param[in] itemSize       Size of the item to store in the queue
+ * @param[in] syncEvery      Number of updates between flushes, `0` to disable
+ * @param[in] syncIntervalMs Milliseconds between flushes, `0` to disable
+ * @note      `POWER_OF_TWO` requires `maxItems` to be a power of two
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                                     |
+ *    | ----------------------------- | -------------------------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                                       |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                                         |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `path` is NULL                                               |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                                         |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                                         |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | Invalid sizes, or the file holds a different or corrupted queue           |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | The file could not be opened, sized or mapped                              |
+ */
+qtipStatus_t qtip_file_open(qtipFileContext_t* pContext,
+                            const char* path,
+                            qtipSize_t maxItems,
+                            size_t itemSize,
+                            uint32_t syncEvery,
+                            uint32_t syncIntervalMs);
+
+/**
+ * @brief     Put an item in a queue file
+ * @details   Copies the value of pItem to the back of the queue and counts
+ *            the update towards the next flush. A slot popped since the last
+ *            flush is still part of the state on the disk, so the file is
+ *            flushed before the item goes into it.
+ * @param[in] pContext Pointer to queue file context
+ * @param[in] pItem    Pointer to item to store in the queue
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                 |
+ *    | ----------------------------- | -------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                   |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                        |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL          |
+ *    | @ref QTIP_STATUS_FULL         | Queue is full                          |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                     |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                     |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | A flush before or after the put failed |
+ */
+qtipStatus_t qtip_file_put(qtipFileContext_t* pContext, void* pItem);
+
+/**
+ * @brief      Extract the next item from a queue file
+ * @details    Pulls and removes the next item in the queue, puts it into pItem
+ *             and counts the update towards the next flush.
+ * @param[in]  pContext Pointer to queue file context
+ * @param[out] pItem    Pointer to item to store in the queue
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                             |
+ *    | ----------------------------- | -------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                               |
+ *    | @ref QTIP_STATUS_LOCKED       | Queue is locked                                    |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL                      |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                 |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                                     |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                                 |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | The item was popped but the flush it caused failed |
+ */
+qtipStatus_t qtip_file_pop(qtipFileContext_t* pContext, void* pItem);
+
+/**
+ * @brief     Flush a queue file to the disk
+ * @details   Writes the items to the disk, and only then the state that
+ *            covers them, so the state on the disk never refers to items that
+ *            are not.
+ * @param[in] pContext Pointer to queue file context
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL or not open  |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | `msync` failed                  |
+ */
+qtipStatus_t qtip_file_sync(qtipFileContext_t* pContext);
+
+/**
+ * @brief     Close a queue file
+ * @details   Flushes the file, unmaps it and closes it. The context must be
+ *            opened again before it is used.
+ * @param[in] pContext Pointer to queue file context
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                    |
+ *    | ----------------------------- | ----------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                      |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                        |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL or not open            |
+ *    | @ref QTIP_STATUS_FULL         | NA                                        |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                        |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                        |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | The file could not be flushed or unmapped |
+ */
+qtipStatus_t qtip_file_close(qtipFileContext_t* pContext);
+
+#endif // DISABLE_FILE && REDUCED_API
+
+QTIP_CPP_SUPPORT_END
+
+#endif // QTIP_FILE_H
+
+/**
+ * @}
+ */
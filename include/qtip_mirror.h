@@ -0,0 +1,81 @@
+/**
+ * @file qtip_mirror.h
+ * @brief API for queues on a buffer mapped twice back-to-back
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * @addtogroup API
+ * @{
+ */
+
+#ifndef QTIP_MIRROR_H
+#define QTIP_MIRROR_H
+
+#include "qtip.h"
+
+QTIP_CPP_SUPPORT_START
+
+#if defined(__linux__) && !defined(DISABLE_MIRROR) && !defined(REDUCED_API)
+
+/*
+ * Public API
+ */
+
+/**
+ * @brief     Initialize a queue on a mirrored buffer
+ * @details   Allocates a buffer of `maxItems * itemSize` bytes and maps it
+ *            twice in a row, so the bytes past the end of the buffer are the
+ *            bytes at its start. Any run of up to `maxItems` items is then
+ *            contiguous in memory: @ref qtip_get_view covers every item in the
+ *            queue and the bulk operations, such as @ref qtip_peek,
+ *            @ref qtip_put_n or @ref qtip_pop_n, copy with a single `memcpy`.
+ *            The queue is initialized as with @ref qtip_init and must be
+ *            released with @ref qtip_mirror_free.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] maxItems Maximum number of items allowed in the queue
+ * @param[in] itemSize Size of the item to store in the queue
+ * @note      `maxItems * itemSize` must be a multiple of the page size
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                   |
+ *    | ----------------------------- | -------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                     |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                       |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL                                       |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                       |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                       |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | Invalid sizes or the buffer is not a multiple of a page  |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | The buffer could not be created or mapped                |
+ */
+qtipStatus_t qtip_mirror_init(qtipContext_t* pContext, qtipSize_t maxItems, size_t itemSize);
+
+/**
+ * @brief     Release the buffer of a mirrored queue
+ * @details   Unmaps the buffer allocated by @ref qtip_mirror_init. The context
+ *            must be initialized again before it is used.
+ * @param[in] pContext Pointer to queue context
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                   |
+ *    | ----------------------------- | ---------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                     |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                       |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL                       |
+ *    | @ref QTIP_STATUS_FULL         | NA                                       |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                       |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | The queue is not mirrored                |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | The buffer could not be unmapped         |
+ */
+qtipStatus_t qtip_mirror_free(qtipContext_t* pContext);
+
+#endif // __linux__ && DISABLE_MIRROR && REDUCED_API
+
+QTIP_CPP_SUPPORT_END
+
+#endif // QTIP_MIRROR_H
+
+/**
+ * @}
+ */
@@ -0,0 +1,303 @@
+/**
+ * @file qtip_mpmc.h
+ * @brief API for bounded lock-free multi-producer/multi-consumer queues
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * @addtogroup API
+ * @{
+ */
+
+#ifndef QTIP_MPMC_H
+#define QTIP_MPMC_H
+
+#include "qtip.h"
+#include "qtip_atomic.h"
+#include "qtip_wait.h"
+
+QTIP_CPP_SUPPORT_START
+
+/*
+ * Public defines
+ */
+
+/**
+ * @brief Size in bytes of one slot of a multi-producer/multi-consumer queue
+ * @details Each slot holds a sequence number followed by the item, padded to
+ *          keep the next sequence number aligned.
+ */
+#define QTIP_MPMC_SLOT_SIZE(itemSize) \
+    (((sizeof(size_t) + (itemSize) + sizeof(size_t) - 1U) / sizeof(size_t)) * sizeof(size_t))
+
+/**
+ * @brief Size in bytes of the buffer needed by a multi-producer/multi-consumer queue
+ */
+#define QTIP_MPMC_BUFFER_SIZE(maxItems, itemSize) ((maxItems) * QTIP_MPMC_SLOT_SIZE(itemSize))
+
+/*
+ * Public Structs
+ */
+
+/**
+ * @brief Multi-producer/multi-consumer queue context structure
+ * @details Every slot carries a sequence number telling whether it is ready
+ *          to be written or read for a given lap. Producers claim a slot by
+ *          advancing `rear` with a compare-and-swap and consumers do the same
+ *          with `front`, so threads only contend on the counter of their side.
+ */
+typedef struct
+{
+    void* start;         //!< Pointer to the start of the queue
+    qtipSize_t maxItems; //!< Number of items allowed in the queue
+    size_t itemSize;     //!< Size of each item in the queue
+    size_t slotSize;     //!< Size of each slot in the queue
+
+    QTIP_ALIGNAS(CACHE_LINE_SIZE) QTIP_ATOMIC(size_t) rear; //!< Position of the next item to put
+#ifndef DISABLE_TELEMETRY
+    QTIP_ATOMIC(size_t) total; //!< Number of items introduced to the queue
+#endif
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    QTIP_ATOMIC(size_t) full;                     //!< Number of insertions rejected because the queue was full
+    QTIP_ATOMIC(qtipSize_t) highWatermark;        //!< Most items seen by a sampled put
+    QTIP_ATOMIC(size_t) histogram[STATS_BUCKETS]; //!< Number of sampled puts by fill level after the put
+#endif
+
+    QTIP_ALIGNAS(CACHE_LINE_SIZE) QTIP_ATOMIC(size_t) front; //!< Position of the next item to pop
+#ifndef DISABLE_TELEMETRY
+    QTIP_ATOMIC(size_t) processed; //!< Number of items removed from the queue
+#endif
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    QTIP_ATOMIC(size_t) empty; //!< Number of removals rejected because the queue was empty
+#endif
+
+#ifndef DISABLE_WAIT
+    QTIP_ALIGNAS(CACHE_LINE_SIZE) qtipWaiters_t notEmpty; //!< Consumers parked until an item is put
+    qtipWaiters_t notFull;                                //!< Producers parked until a slot is freed
+#endif
+} qtipMpmcContext_t;
+
+/*
+ * Public API
+ */
+
+/**
+ * @brief     Initialize a multi-producer/multi-consumer queue context
+ * @details   Initializes the queue context struct and the sequence number of every slot.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pBuffer  Pointer to queue in memory.
+ * @param[in] maxItems Maximum number of items allowed in the queue
+ * @param[in] itemSize Size of the item to store in the queue
+ * @note      pBuffer must be at least @ref QTIP_MPMC_BUFFER_SIZE bytes and aligned to `size_t`
+ * @note      With `POWER_OF_TWO` defined, maxItems must be a power of two
+ * @note      Must not be called while a producer or consumer uses the queue
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                                            |
+ *    | ----------------------------- | --------------------------------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                                              |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                                                |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pBuffer` is NULL                                                   |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                                                |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                                                |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `itemSize` or `maxItems` is `0` or not a power of two, or `pBuffer` is misaligned |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                                                |
+ */
+qtipStatus_t qtip_mpmc_init(qtipMpmcContext_t* pContext, void* pBuffer, qtipSize_t maxItems, size_t itemSize);
+
+/**
+ * @brief     Put an item in a multi-producer/multi-consumer queue
+ * @details   Copies the value of pItem to the back of the queue. Safe to call
+ *            from any number of threads at once.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pItem    Pointer to item to store in the queue
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                        |
+ *    | ----------------------------- | ----------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful          |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                            |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | Queue is full                 |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                            |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                            |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                            |
+ */
+qtipStatus_t qtip_mpmc_put(qtipMpmcContext_t* pContext, void* pItem);
+
+/**
+ * @brief      Extract the next item from a multi-producer/multi-consumer queue
+ * @details    Pulls and removes the next item in the queue and puts it into pItem.
+ *             Safe to call from any number of threads at once.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItem    Pointer to item to store in the queue
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                        |
+ *    | ----------------------------- | ----------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful          |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                            |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                            |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                            |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                            |
+ */
+qtipStatus_t qtip_mpmc_pop(qtipMpmcContext_t* pContext, void* pItem);
+
+/**
+ * @brief      Gets the number of items in a multi-producer/multi-consumer queue
+ * @details    The result is a snapshot that counts claimed slots, so it may
+ *             include items that are still being written or read.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pResult  Pointer to the variable to hold the result
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_mpmc_count_items(qtipMpmcContext_t* pContext, qtipSize_t* pResult);
+
+#ifndef DISABLE_WAIT
+
+/**
+ * @brief     Put an item in a multi-producer/multi-consumer queue, waiting for a free slot
+ * @details   Like @ref qtip_mpmc_put, but if the queue is full it waits until a
+ *            slot is freed or `timeoutUs` microseconds pass, using `strategy`.
+ * @param[in] pContext  Pointer to queue context
+ * @param[in] pItem     Pointer to item to store in the queue
+ * @param[in] timeoutUs Maximum time to wait, or @ref QTIP_WAIT_FOREVER
+ * @param[in] strategy  How to wait
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                    |
+ *    | ----------------------------- | ----------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                      |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                        |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL             |
+ *    | @ref QTIP_STATUS_FULL         | Queue still full when the timeout expired |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                        |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                        |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                        |
+ */
+qtipStatus_t qtip_mpmc_put_wait(qtipMpmcContext_t* pContext, void* pItem, uint32_t timeoutUs, qtipWaitStrategy_t strategy);
+
+/**
+ * @brief      Extract the next item from a multi-producer/multi-consumer queue, waiting for an item
+ * @details    Like @ref qtip_mpmc_pop, but if the queue is empty it waits until an
+ *             item is put or `timeoutUs` microseconds pass, using `strategy`.
+ * @param[in]  pContext  Pointer to queue context
+ * @param[out] pItem     Pointer to item to store in the queue
+ * @param[in]  timeoutUs Maximum time to wait, or @ref QTIP_WAIT_FOREVER
+ * @param[in]  strategy  How to wait
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                     |
+ *    | ----------------------------- | ------------------------------------------ |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                       |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                         |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL              |
+ *    | @ref QTIP_STATUS_FULL         | NA                                         |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue still empty when the timeout expired |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                         |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                         |
+ */
+qtipStatus_t qtip_mpmc_pop_wait(qtipMpmcContext_t* pContext, void* pItem, uint32_t timeoutUs, qtipWaitStrategy_t strategy);
+
+#endif // DISABLE_WAIT
+
+#ifndef DISABLE_TELEMETRY
+
+/**
+ * @brief      Get number of items inserted in a multi-producer/multi-consumer queue
+ * @details    The result considers the all-time number of inserted items.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pResult  Pointer to variable to hold the result
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_mpmc_total_enqueued_items(qtipMpmcContext_t* pContext, size_t* pResult);
+
+/**
+ * @brief      Get number of processed items in a multi-producer/multi-consumer queue
+ * @details    The result considers the all-time number of popped items.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pResult  Pointer to variable to hold the result
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_mpmc_total_processed_items(qtipMpmcContext_t* pContext, size_t* pResult);
+
+#ifndef DISABLE_STATS
+
+/**
+ * @brief      Get the statistics of a multi-producer/multi-consumer queue
+ * @details    The producers count the full queues next to `rear` and the
+ *             consumers the empty queues next to `front`. Every put that
+ *             claims a position multiple of @ref STATS_SAMPLE_RATE loads
+ *             `front` once to sample the fill level, so `histogram` counts the
+ *             sampled puts only and `highWatermark` is the highest sampled
+ *             level. `locked` is always `0`. The calls of
+ *             @ref qtip_mpmc_put_wait and @ref qtip_mpmc_pop_wait only count
+ *             as rejected when they time out. Can be called from any thread.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pStats   Pointer to variable to hold the statistics
+ * @param[in]  reset    Clear the statistics after reading them
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                         |
+ *    | ----------------------------- | ------------------------------ |
+ *    | @ref QTIP_STATUS_OK           | Operation successful           |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                             |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pStats` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                             |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                             |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                             |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                             |
+ */
+qtipStatus_t qtip_mpmc_get_stats(qtipMpmcContext_t* pContext, qtipStats_t* pStats, bool reset);
+
+#endif // DISABLE_STATS
+
+#endif // DISABLE_TELEMETRY
+
+QTIP_CPP_SUPPORT_END
+
+#endif // QTIP_MPMC_H
+
+/**
+ * @}
+ */
@@ -0,0 +1,179 @@
+/**
+ * @file qtip_priority.h
+ * @brief API for queues with a fixed number of priority levels
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * @addtogroup API
+ * @{
+ */
+
+#ifndef QTIP_PRIORITY_H
+#define QTIP_PRIORITY_H
+
+#include "qtip.h"
+
+#include <stdint.h>
+
+QTIP_CPP_SUPPORT_START
+
+#ifndef DISABLE_PRIORITY
+
+/*
+ * Public defines
+ */
+
+#ifndef PRIORITY_LEVELS
+#define PRIORITY_LEVELS 8U //!< Maximum number of priority levels of a priority queue, up to 32
+#endif
+
+/**
+ * @brief Size in bytes of the buffer of a priority queue
+ * @param levels           Number of priority levels
+ * @param maxItemsPerLevel Maximum number of items in each level
+ * @param itemSize         Size of each item in the queue
+ */
+#define QTIP_PRIORITY_BUFFER_SIZE(levels, maxItemsPerLevel, itemSize) \
+    ((size_t) (levels) * (size_t) (maxItemsPerLevel) * (size_t) (itemSize))
+
+/*
+ * Public Structs
+ */
+
+/**
+ * @brief Priority queue context structure
+ * @details Each priority level is a regular ring over its own part of the
+ *          buffer, and `ready` has a bit set for every level that holds
+ *          items. Put appends to the ring of its level and pop takes from the
+ *          lowest set bit, so both are O(1) and items of the same priority
+ *          keep their order.
+ */
+typedef struct
+{
+    qtipContext_t levels[PRIORITY_LEVELS]; //!< Ring of each priority level, `0` being the most urgent
+    uint32_t levelCount;                   //!< Number of priority levels in use
+    uint32_t ready;                        //!< Bit `n` is set when level `n` holds items
+} qtipPriorityContext_t;
+
+/*
+ * Public API
+ */
+
+/**
+ * @brief     Initialize a priority queue context
+ * @details   Splits pBuffer in `levels` rings of `maxItemsPerLevel` items.
+ * @param[in] pContext         Pointer to queue context
+ * @param[in] pBuffer          Pointer to queue in memory
+ * @param[in] levels           Number of priority levels, up to @ref PRIORITY_LEVELS
+ * @param[in] maxItemsPerLevel Maximum number of items in each level
+ * @param[in] itemSize         Size of the item to store in the queue
+ * @note      pBuffer must be at least @ref QTIP_PRIORITY_BUFFER_SIZE bytes
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                   |
+ *    | ----------------------------- | -------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                     |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                       |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pBuffer` is NULL                          |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                       |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                       |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `levels` is `0` or too large, or an invalid level size   |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                       |
+ */
+qtipStatus_t qtip_priority_init(qtipPriorityContext_t* pContext,
+                                void* pBuffer,
+                                uint32_t levels,
+                                qtipSize_t maxItemsPerLevel,
+                                size_t itemSize);
+
+/**
+ * @brief     Put an item in a priority queue
+ * @details   Copies the value of pItem to the back of its priority level.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pItem    Pointer to item to store in the queue
+ * @param[in] priority Priority level of the item, `0` being the most urgent
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL   |
+ *    | @ref QTIP_STATUS_FULL         | The priority level is full      |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `priority` is not a valid level |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_priority_put(qtipPriorityContext_t* pContext, void* pItem, uint32_t priority);
+
+/**
+ * @brief      Extract the most urgent item from a priority queue
+ * @details    Pulls and removes the oldest item of the most urgent non-empty
+ *             level and puts it into pItem.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItem    Pointer to item to store in the queue
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                        |
+ *    | ----------------------------- | ----------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful          |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                            |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                            |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                            |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                            |
+ */
+qtipStatus_t qtip_priority_pop(qtipPriorityContext_t* pContext, void* pItem);
+
+/**
+ * @brief      Get the most urgent item of a priority queue without removing it
+ * @param[in]  pContext  Pointer to queue context
+ * @param[out] pItem     Pointer to item to store in the queue
+ * @param[out] pPriority Pointer to variable to hold the priority of the item
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                     |
+ *    | ----------------------------- | ------------------------------------------ |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                       |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                         |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `pItem` or `pPriority` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                                         |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                             |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                         |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                         |
+ */
+qtipStatus_t qtip_priority_get_front(qtipPriorityContext_t* pContext, void* pItem, uint32_t* pPriority);
+
+/**
+ * @brief      Get the number of items in a priority queue
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pResult  Pointer to variable to hold the number of items
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_priority_count_items(qtipPriorityContext_t* pContext, qtipSize_t* pResult);
+
+#endif // DISABLE_PRIORITY
+
+QTIP_CPP_SUPPORT_END
+
+#endif // QTIP_PRIORITY_H
+
+/**
+ * @}
+ */
@@ -0,0 +1,224 @@
+/**
+ * @file qtip_record.h
+ * @brief API for queues of variable-length records
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * @addtogroup API
+ * @{
+ */
+
+#ifndef QTIP_RECORD_H
+#define QTIP_RECORD_H
+
+#include "qtip.h"
+
+QTIP_CPP_SUPPORT_START
+
+#ifndef DISABLE_RECORD
+
+/*
+ * Public defines
+ */
+
+#define QTIP_RECORD_ALIGNMENT 8U //!< Alignment of the records in the buffer
+
+/**
+ * @brief Number of bytes of the buffer used by a record of `length` bytes
+ * @details Each record is stored after a header holding its length and is
+ *          padded to @ref QTIP_RECORD_ALIGNMENT, so the data of every record
+ *          keeps the alignment of the buffer.
+ */
+#define QTIP_RECORD_SIZE(length) \
+    ((((size_t) (length) + (2U * QTIP_RECORD_ALIGNMENT) - 1U) / QTIP_RECORD_ALIGNMENT) * QTIP_RECORD_ALIGNMENT)
+
+/*
+ * Public Structs
+ */
+
+/**
+ * @brief Record queue context structure
+ * @details The records are stored back-to-back in a byte buffer. A record
+ *          that does not fit before the end of the buffer is stored at its
+ *          start, and the bytes left at the end are marked as padding, so
+ *          every record is contiguous.
+ */
+typedef struct
+{
+    void* start;          //!< Pointer to the start of the buffer
+    size_t size;          //!< Size of the buffer in bytes
+    size_t front;         //!< Offset of the front record
+    size_t rear;          //!< Offset of the first byte after the rear record
+    size_t used;          //!< Number of bytes used by records and padding
+    qtipSize_t qty;       //!< Number of records in the queue
+    size_t reserveOffset; //!< Offset of the reserved record
+    size_t reserveLength; //!< Length of the reserved record, `0` when there is no reservation
+} qtipRecordContext_t;
+
+/*
+ * Public API
+ */
+
+/**
+ * @brief     Initialize a record queue context
+ * @details   Initializes the queue context struct with default values.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pBuffer  Pointer to buffer in memory
+ * @param[in] size     Size of the buffer in bytes
+ * @note      `size` must be a multiple of @ref QTIP_RECORD_ALIGNMENT
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                           |
+ *    | ----------------------------- | ---------------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                             |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                               |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pBuffer` is NULL                                  |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                               |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                               |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `size` is `0` or not a multiple of @ref QTIP_RECORD_ALIGNMENT    |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                               |
+ */
+qtipStatus_t qtip_record_init(qtipRecordContext_t* pContext, void* pBuffer, size_t size);
+
+/**
+ * @brief     Put a record in the queue
+ * @details   Copies `length` bytes from pRecord to the back of the queue.
+ *            Cancels any reservation made with @ref qtip_record_reserve.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pRecord  Pointer to record to store in the queue
+ * @param[in] length   Length of the record in bytes
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                    |
+ *    | ----------------------------- | --------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                      |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                        |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pRecord` is NULL                           |
+ *    | @ref QTIP_STATUS_FULL         | Not enough contiguous space for the record                |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                        |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `length` is `0` or the record can never fit in the buffer |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                        |
+ */
+qtipStatus_t qtip_record_put(qtipRecordContext_t* pContext, const void* pRecord, size_t length);
+
+/**
+ * @brief      Extract the next record from the queue
+ * @details    Copies the front record into pBuffer, sets pLength to its length
+ *             and removes it from the queue. If the record does not fit in
+ *             pBuffer, it is left in the queue and pLength is set to the size
+ *             needed.
+ * @param[in]  pContext   Pointer to queue context
+ * @param[out] pBuffer    Pointer to buffer to hold the record
+ * @param[in]  bufferSize Size of pBuffer in bytes
+ * @param[out] pLength    Pointer to variable to hold the length of the record
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                          |
+ *    | ----------------------------- | ----------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `pBuffer` or `pLength` is NULL      |
+ *    | @ref QTIP_STATUS_FULL         | NA                                              |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                                  |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | The record is longer than `bufferSize`          |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                              |
+ */
+qtipStatus_t qtip_record_pop(qtipRecordContext_t* pContext, void* pBuffer, size_t bufferSize, size_t* pLength);
+
+/**
+ * @brief      Get the length of the next record
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pLength  Pointer to variable to hold the length of the front record
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pLength` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                  |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_record_next_size(qtipRecordContext_t* pContext, size_t* pLength);
+
+/**
+ * @brief      Reserve space for a record at the back of the queue
+ * @details    Points ppRecord to `length` contiguous bytes where the record
+ *             can be built in place. The record is not part of the queue until
+ *             it is committed with @ref qtip_record_commit. A new reservation
+ *             replaces the previous one.
+ * @param[in]  pContext Pointer to queue context
+ * @param[in]  length   Maximum length of the record in bytes
+ * @param[out] ppRecord Pointer to variable to hold the address of the record
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                    |
+ *    | ----------------------------- | --------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                      |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                        |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `ppRecord` is NULL                          |
+ *    | @ref QTIP_STATUS_FULL         | Not enough contiguous space for the record                |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                        |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `length` is `0` or the record can never fit in the buffer |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                        |
+ */
+qtipStatus_t qtip_record_reserve(qtipRecordContext_t* pContext, size_t length, void** ppRecord);
+
+/**
+ * @brief     Commit the reserved record to the queue
+ * @details   Adds the record built in the space returned by
+ *            @ref qtip_record_reserve to the back of the queue. The record can
+ *            be shorter than the reservation, in which case the rest of the
+ *            reserved space is released.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] length   Length of the record in bytes
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                           |
+ *    | ----------------------------- | ---------------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                             |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                               |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL                                               |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                               |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                               |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `length` is `0` or longer than the reservation, or none was made |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                               |
+ */
+qtipStatus_t qtip_record_commit(qtipRecordContext_t* pContext, size_t length);
+
+/**
+ * @brief      Get the number of records in the queue
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pCount   Pointer to variable to hold the number of records
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                         |
+ *    | ----------------------------- | ------------------------------ |
+ *    | @ref QTIP_STATUS_OK           | Operation successful           |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                             |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pCount` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                             |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                             |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                             |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                             |
+ */
+qtipStatus_t qtip_record_count(qtipRecordContext_t* pContext, qtipSize_t* pCount);
+
+#endif // DISABLE_RECORD
+
+QTIP_CPP_SUPPORT_END
+
+#endif // QTIP_RECORD_H
+
+/**
+ * @}
+ */
@@ -0,0 +1,196 @@
+/**
+ * @file qtip_segment.h
+ * @brief API for unbounded queues made of chained fixed-size chunks
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * @addtogroup API
+ * @{
+ */
+
+#ifndef QTIP_SEGMENT_H
+#define QTIP_SEGMENT_H
+
+#include "qtip.h"
+
+QTIP_CPP_SUPPORT_START
+
+#ifndef DISABLE_SEGMENT
+
+/*
+ * Public typedefs
+ */
+
+typedef struct qtipSegmentChunk qtipSegmentChunk_t; //!< Fixed-size ring holding part of a segmented queue
+
+/*
+ * Public Structs
+ */
+
+/**
+ * @brief Segmented queue context structure
+ * @details The items live in a linked list of chunks, each a fixed-size ring
+ *          of `chunkItems` items. The producer appends a chunk when the tail
+ *          chunk is full and the consumer hands the head chunk back as soon as
+ *          it is drained. Drained chunks are kept in a pool, up to
+ *          `maxPooled` of them, and reused before a new one is allocated.
+ */
+typedef struct
+{
+    qtipSegmentChunk_t* pHead;         //!< Chunk holding the front of the queue
+    qtipSegmentChunk_t* pTail;         //!< Chunk holding the rear of the queue
+    qtipSegmentChunk_t* pPool;         //!< Drained chunks ready to be reused
+    const qtipAllocator_t* pAllocator; //!< Memory hooks used for the chunks
+    qtipSize_t chunkItems;             //!< Number of items in each chunk
+    size_t itemSize;                   //!< Size of each item in the queue
+    size_t maxChunks;                  //!< Maximum number of chunks, `0` for no limit
+    size_t maxPooled;                  //!< Maximum number of chunks kept in the pool
+    size_t chunks;                     //!< Number of allocated chunks, pooled ones included
+    size_t pooled;                     //!< Number of chunks in the pool
+    size_t qty;                        //!< Number of items in the queue
+} qtipSegmentContext_t;
+
+/*
+ * Public API
+ */
+
+/**
+ * @brief     Initialize a segmented queue context
+ * @details   Allocates the first chunk with the hooks of `pAllocator`.
+ * @param[in] pContext   Pointer to queue context
+ * @param[in] pAllocator Pointer to memory hooks, must outlive the queue
+ * @param[in] chunkItems Number of items in each chunk
+ * @param[in] itemSize   Size of the item to store in the queue
+ * @param[in] maxChunks  Maximum number of chunks, `0` for no limit
+ * @param[in] maxPooled  Maximum number of drained chunks kept for reuse
+ * @note      `POWER_OF_TWO` requires `chunkItems` to be a power of two
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                               |
+ *    | ----------------------------- | ---------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                 |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                   |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `pAllocator` or one of its hooks is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                   |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                   |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `chunkItems` or `itemSize` is invalid                |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | `alloc` failed                                       |
+ */
+qtipStatus_t qtip_segment_init(qtipSegmentContext_t* pContext,
+                               const qtipAllocator_t* pAllocator,
+                               qtipSize_t chunkItems,
+                               size_t itemSize,
+                               size_t maxChunks,
+                               size_t maxPooled);
+
+/**
+ * @brief     Put an item in a segmented queue
+ * @details   Copies the value of pItem to the back of the queue, appending a
+ *            chunk if the tail chunk is full. Items already in the queue are
+ *            never moved.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pItem    Pointer to item to store in the queue
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                       |
+ *    | ----------------------------- | ------------------------------------------------------------ |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                         |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                           |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL                                |
+ *    | @ref QTIP_STATUS_FULL         | `maxChunks` is reached or a new chunk could not be allocated |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                           |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                                           |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                           |
+ */
+qtipStatus_t qtip_segment_put(qtipSegmentContext_t* pContext, void* pItem);
+
+/**
+ * @brief      Extract the next item from a segmented queue
+ * @details    Pulls and removes the next item in the queue and puts it into
+ *             pItem. The head chunk goes back to the pool once it is drained.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItem    Pointer to item to store in the queue
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                        |
+ *    | ----------------------------- | ----------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful          |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                            |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                            |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                            |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                            |
+ */
+qtipStatus_t qtip_segment_pop(qtipSegmentContext_t* pContext, void* pItem);
+
+/**
+ * @brief      Get the front item of a segmented queue without removing it
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItem    Pointer to item to store in the queue
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                        |
+ *    | ----------------------------- | ----------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful          |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                            |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                            |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                            |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                            |
+ */
+qtipStatus_t qtip_segment_get_front(qtipSegmentContext_t* pContext, void* pItem);
+
+/**
+ * @brief      Get the number of items in a segmented queue
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pResult  Pointer to variable to hold the number of items
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_segment_count_items(qtipSegmentContext_t* pContext, size_t* pResult);
+
+/**
+ * @brief     Release every chunk of a segmented queue
+ * @details   Frees the chunks in use and in the pool, discarding the items.
+ *            The context must be initialized again before it is used.
+ * @param[in] pContext Pointer to queue context
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason               |
+ *    | ----------------------------- | -------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                   |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL   |
+ *    | @ref QTIP_STATUS_FULL         | NA                   |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                   |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                   |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                   |
+ */
+qtipStatus_t qtip_segment_free(qtipSegmentContext_t* pContext);
+
+#endif // DISABLE_SEGMENT
+
+QTIP_CPP_SUPPORT_END
+
+#endif // QTIP_SEGMENT_H
+
+/**
+ * @}
+ */
@@ -0,0 +1,371 @@
+/**
+ * @file qtip_shm.h
+ * @brief API for single-producer/single-consumer queues shared between processes
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * @addtogroup API
+ * @{
+ */
+
+#ifndef QTIP_SHM_H
+#define QTIP_SHM_H
+
+#include "qtip.h"
+#include "qtip_atomic.h"
+
+#include <stdint.h>
+
+QTIP_CPP_SUPPORT_START
+
+#ifndef DISABLE_SHM
+
+/*
+ * Public defines
+ */
+
+#define QTIP_SHM_MAGIC   0x51544950U //!< Marks memory that holds a formatted queue ("QTIP")
+#define QTIP_SHM_VERSION 1U          //!< Version of the shared memory layout
+
+/**
+ * @brief Number of bytes of shared memory needed for a queue
+ * @param maxItems Maximum number of items allowed in the queue
+ * @param itemSize Size of each item in the queue
+ */
+#define QTIP_SHM_SIZE(maxItems, itemSize) (sizeof(qtipShmHeader_t) + (size_t) (maxItems) * (size_t) (itemSize))
+
+/*
+ * Public Structs
+ */
+
+/**
+ * @brief Header at the start of the shared memory of a queue
+ * @details The items follow the header in the same mapping at `itemsOffset`,
+ *          so the header holds no pointers and every process can map the
+ *          memory at a different address. All the fields have a fixed width
+ *          and the telemetry counters are always present, so the layout does
+ *          not depend on @ref SIZE_TYPE or `DISABLE_TELEMETRY`. The counters
+ *          are lock-free atomics, which are address-free and therefore safe
+ *          to share between processes. `magic` is written last, so a process
+ *          that attaches while the queue is being created sees it unformatted.
+ */
+typedef struct
+{
+    QTIP_ATOMIC(uint32_t) magic; //!< @ref QTIP_SHM_MAGIC once the header is initialised
+    uint32_t version;            //!< @ref QTIP_SHM_VERSION
+    uint64_t maxItems;           //!< Number of items allowed in the queue
+    uint64_t itemSize;           //!< Size of each item in the queue
+    uint64_t itemsOffset;        //!< Offset of the first item from the start of the header
+
+    QTIP_ALIGNAS(CACHE_LINE_SIZE) QTIP_ATOMIC(uint64_t) rear; //!< Producer counter of the rear of the queue
+    QTIP_ATOMIC(uint64_t) total;                              //!< Number of items introduced to the queue
+
+    QTIP_ALIGNAS(CACHE_LINE_SIZE) QTIP_ATOMIC(uint64_t) front; //!< Consumer counter of the front of the queue
+    QTIP_ATOMIC(uint64_t) processed;                           //!< Number of items removed from the queue
+} qtipShmHeader_t;
+
+/**
+ * @brief Shared memory queue context structure
+ * @details Each process keeps its own context, which holds the addresses of
+ *          the shared memory in that process and the cached counter of the
+ *          other side. As with @ref qtipSpscContext_t, one process must only
+ *          put and the other must only pop.
+ */
+typedef struct
+{
+    qtipShmHeader_t* pHeader; //!< Header of the queue, as mapped in this process
+    void* start;              //!< Pointer to the start of the items, as mapped in this process
+    qtipSize_t maxItems;      //!< Number of items allowed in the queue
+    size_t itemSize;          //!< Size of each item in the queue
+    size_t mapSize;           //!< Size of the mapping made by this context, `0` if the memory is not owned
+    uint64_t frontCache;      //!< Last front seen by the producer
+    uint64_t rearCache;       //!< Last rear seen by the consumer
+} qtipShmContext_t;
+
+/*
+ * Public API
+ */
+
+/**
+ * @brief     Initialize a queue in memory shared with other processes
+ * @details   Formats the header and binds the context to it. The memory can be
+ *            any shared mapping, such as an anonymous `MAP_SHARED` mapping
+ *            inherited through `fork`. Other processes bind to it with
+ *            @ref qtip_shm_attach_memory.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pMemory  Pointer to the shared memory
+ * @param[in] size     Size of the shared memory in bytes
+ * @param[in] maxItems Maximum number of items allowed in the queue
+ * @param[in] itemSize Size of the item to store in the queue
+ * @note      pMemory must be aligned to `CACHE_LINE_SIZE` and size must be at
+ *            least @ref QTIP_SHM_SIZE bytes
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                                    |
+ *    | ----------------------------- | ------------------------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                                      |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                                        |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pMemory` is NULL                                           |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                                        |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                                        |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `itemSize` or `maxItems` is `0`, or the memory is too small or misaligned |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                                        |
+ */
+qtipStatus_t
+qtip_shm_init(qtipShmContext_t* pContext, void* pMemory, size_t size, qtipSize_t maxItems, size_t itemSize);
+
+/**
+ * @brief     Bind to a queue initialized by another process
+ * @details   Validates the header written by @ref qtip_shm_init and binds the
+ *            context to it.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pMemory  Pointer to the shared memory
+ * @param[in] size     Size of the shared memory in bytes
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                    |
+ *    | ----------------------------- | --------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                      |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                        |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pMemory` is NULL                           |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                        |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                        |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | The memory holds no queue of this version or is too small |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                        |
+ */
+qtipStatus_t qtip_shm_attach_memory(qtipShmContext_t* pContext, void* pMemory, size_t size);
+
+/**
+ * @brief     Create a queue in a new POSIX shared memory object
+ * @details   Creates the object `name` with `shm_open`, sizes it, maps it and
+ *            initializes the queue in it. Fails if the object already exists.
+ *            The object lives until it is removed with `shm_unlink`.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] name     Name of the shared memory object, such as `"/capture"`
+ * @param[in] maxItems Maximum number of items allowed in the queue
+ * @param[in] itemSize Size of the item to store in the queue
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                     |
+ *    | ----------------------------- | ---------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                       |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                         |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `name` is NULL                               |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                         |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                         |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `itemSize` or `maxItems` is `0`, or the queue is too large |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | The object could not be created, sized or mapped           |
+ */
+qtipStatus_t qtip_shm_create(qtipShmContext_t* pContext, const char* name, qtipSize_t maxItems, size_t itemSize);
+
+/**
+ * @brief     Attach to a queue in an existing POSIX shared memory object
+ * @details   Opens the object `name` created by @ref qtip_shm_create, maps it
+ *            and binds the context to the queue in it.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] name     Name of the shared memory object
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                    |
+ *    | ----------------------------- | ----------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                      |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                        |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `name` is NULL              |
+ *    | @ref QTIP_STATUS_FULL         | NA                                        |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                        |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | The object holds no queue of this version |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | The object could not be opened or mapped  |
+ */
+qtipStatus_t qtip_shm_attach(qtipShmContext_t* pContext, const char* name);
+
+/**
+ * @brief     Detach from a shared memory queue
+ * @details   Unmaps the memory mapped by @ref qtip_shm_create or
+ *            @ref qtip_shm_attach and clears the context. Memory passed to
+ *            @ref qtip_shm_init or @ref qtip_shm_attach_memory is left mapped.
+ *            The queue itself is not modified, so the other process keeps
+ *            using it.
+ * @param[in] pContext Pointer to queue context
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                             |
+ *    | ----------------------------- | ---------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful               |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                 |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL or not attached |
+ *    | @ref QTIP_STATUS_FULL         | NA                                 |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                 |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                 |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | The memory could not be unmapped   |
+ */
+qtipStatus_t qtip_shm_detach(qtipShmContext_t* pContext);
+
+/**
+ * @brief     Put an item in a shared memory queue
+ * @details   Copies the value of pItem to the back of the queue.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pItem    Pointer to item to store in the queue
+ * @note      Must only be called from the producer
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                        |
+ *    | ----------------------------- | ----------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful          |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                            |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | Queue is full                 |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                            |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                            |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                            |
+ */
+qtipStatus_t qtip_shm_put(qtipShmContext_t* pContext, void* pItem);
+
+/**
+ * @brief      Extract the next item from a shared memory queue
+ * @details    Pulls and removes the next item in the queue and puts it into pItem.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItem    Pointer to item to store in the queue
+ * @note       Must only be called from the consumer
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                        |
+ *    | ----------------------------- | ----------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful          |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                            |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                            |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                            |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                            |
+ */
+qtipStatus_t qtip_shm_pop(qtipShmContext_t* pContext, void* pItem);
+
+/**
+ * @brief      Put up to n items in a shared memory queue
+ * @details    Copies as many items from pItems as fit, up to n, with a single
+ *             publication of the rear.
+ * @param[in]  pContext Pointer to queue context
+ * @param[in]  pItems   Pointer to the array of items to store in the queue
+ * @param[in]  n        Maximum number of items to put
+ * @param[out] pPut     Number of items put in the queue
+ * @note       Must only be called from the producer
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                   |
+ *    | ----------------------------- | ---------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | At least one item was put, or `n` is `0` |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                       |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `pItems` or `pPut` is NULL   |
+ *    | @ref QTIP_STATUS_FULL         | Queue is full                            |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                       |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                       |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                       |
+ */
+qtipStatus_t qtip_shm_put_up_to_n(qtipShmContext_t* pContext, void* pItems, qtipSize_t n, qtipSize_t* pPut);
+
+/**
+ * @brief      Extract up to n items from a shared memory queue
+ * @details    Pulls and removes as many items as available, up to n, with a
+ *             single publication of the front.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItems   Pointer to the array to hold the items
+ * @param[in]  n        Maximum number of items to pop
+ * @param[out] pPopped  Number of items popped from the queue
+ * @note       Must only be called from the consumer
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                      |
+ *    | ----------------------------- | ------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | At least one item was popped, or `n` is `0` |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                          |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `pItems` or `pPopped` is NULL   |
+ *    | @ref QTIP_STATUS_FULL         | NA                                          |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                          |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                          |
+ */
+qtipStatus_t qtip_shm_pop_up_to_n(qtipShmContext_t* pContext, void* pItems, qtipSize_t n, qtipSize_t* pPopped);
+
+/**
+ * @brief      Get the number of items in a shared memory queue
+ * @details    The result is a snapshot and may be outdated by the time it is
+ *             read if the other process is using the queue.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pResult  Pointer to variable to hold the result
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_shm_count_items(qtipShmContext_t* pContext, qtipSize_t* pResult);
+
+#ifndef DISABLE_TELEMETRY
+
+/**
+ * @brief      Get number of items inserted in a shared memory queue
+ * @details    The result considers the all-time number of inserted items.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pResult  Pointer to variable to hold the result
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_shm_total_enqueued_items(qtipShmContext_t* pContext, size_t* pResult);
+
+/**
+ * @brief      Get number of processed items in a shared memory queue
+ * @details    The result considers the all-time number of popped items.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pResult  Pointer to variable to hold the result
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_shm_total_processed_items(qtipShmContext_t* pContext, size_t* pResult);
+
+#endif // DISABLE_TELEMETRY
+
+#endif // DISABLE_SHM
+
+QTIP_CPP_SUPPORT_END
+
+#endif // QTIP_SHM_H
+
+/**
+ * @}
+ */
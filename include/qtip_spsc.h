@@ -0,0 +1,427 @@
+/**
+ * @file qtip_spsc.h
+ * @brief API for lock-free single-producer/single-consumer queues
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * @addtogroup API
+ * @{
+ */
+
+#ifndef QTIP_SPSC_H
+#define QTIP_SPSC_H
+
+#include "qtip.h"
+#include "qtip_atomic.h"
+#include "qtip_wait.h"
+
+QTIP_CPP_SUPPORT_START
+
+/*
+ * Public Structs
+ */
+
+/**
+ * @brief Single-producer/single-consumer queue context structure
+ * @details The producer owns `rear` and the consumer owns `front`. Each side
+ *          publishes its counter with release semantics and reads the other
+ *          one with acquire semantics, so no lock or shared item counter is
+ *          needed. The counters run from `0` to `2 * maxItems - 1`, which tells
+ *          a full queue from an empty one without division. In overwrite mode,
+ *          the producer also moves `front` to drop the oldest item, so both
+ *          sides update it with a compare-and-swap.
+ */
+typedef struct
+{
+    void* start;         //!< Pointer to the start of the queue
+    qtipSize_t maxItems; //!< Number of items allowed in the queue
+    size_t itemSize;     //!< Size of each item in the queue
+#ifndef DISABLE_OVERWRITE
+    bool overwrite; //!< Puts into a full queue replace the front item
+#endif
+
+    QTIP_ALIGNAS(CACHE_LINE_SIZE) QTIP_ATOMIC(qtipSize_t) rear; //!< Producer counter of the rear of the queue
+    qtipSize_t frontCache;                                      //!< Last front seen by the producer
+#ifndef DISABLE_TELEMETRY
+    QTIP_ATOMIC(size_t) total; //!< Number of items introduced to the queue
+#endif
+#ifndef DISABLE_OVERWRITE
+    QTIP_ATOMIC(size_t) overwritten; //!< Number of items replaced before the consumer removed them
+    QTIP_ATOMIC(size_t) drops;       //!< Number of attempts to drop the front item, checked by the consumer
+#endif
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    QTIP_ATOMIC(qtipSize_t) highWatermark;        //!< Most items seen by the producer after a put
+    QTIP_ATOMIC(size_t) full;                     //!< Number of insertions rejected because the queue was full
+    QTIP_ATOMIC(size_t) histogram[STATS_BUCKETS]; //!< Number of sampled puts by fill level after the put
+    size_t sampleCountdown;                       //!< Puts until the next fill level sample
+#endif
+
+    QTIP_ALIGNAS(CACHE_LINE_SIZE) QTIP_ATOMIC(qtipSize_t) front; //!< Consumer counter of the front of the queue
+    qtipSize_t rearCache;                                        //!< Last rear seen by the consumer
+#ifndef DISABLE_TELEMETRY
+    QTIP_ATOMIC(size_t) processed; //!< Number of items removed from the queue
+#endif
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    QTIP_ATOMIC(size_t) empty; //!< Number of removals rejected because the queue was empty
+#endif
+
+#ifndef DISABLE_WAIT
+    QTIP_ALIGNAS(CACHE_LINE_SIZE) qtipWaiters_t notEmpty; //!< Consumer parked until an item is put
+    qtipWaiters_t notFull;                                //!< Producer parked until a slot is freed
+#endif
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    qtipStats_t statsBase; //!< Counters at the last reset, subtracted by @ref qtip_spsc_get_stats
+#endif
+} qtipSpscContext_t;
+
+/*
+ * Public API
+ */
+
+/**
+ * @brief     Initialize a single-producer/single-consumer queue context
+ * @details   Initializes the queue context struct with default values.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pBuffer  Pointer to queue in memory.
+ * @param[in] maxItems Maximum number of items allowed in the queue
+ * @param[in] itemSize Size of the item to store in the queue
+ * @note      pBuffer must be at least maxItems * itemSize bytes
+ * @note      Must not be called while a producer or consumer uses the queue
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                                      |
+ *    | ----------------------------- | ----------------------------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                                        |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                                          |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pBuffer` is NULL                             |
+ *    | @ref QTIP_STATUS_FULL         | NA                                                          |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                                          |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | `itemSize` or `maxItems` is `0`, or `maxItems` is too large |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                                          |
+ */
+qtipStatus_t qtip_spsc_init(qtipSpscContext_t* pContext, void* pBuffer, qtipSize_t maxItems, size_t itemSize);
+
+#ifndef DISABLE_OVERWRITE
+
+/**
+ * @brief     Makes puts into a full single-producer/single-consumer queue replace the oldest item
+ * @details   While enabled, @ref qtip_spsc_put on a full queue drops the front
+ *            item and puts the new one in its slot, so the queue keeps the
+ *            newest `maxItems` items. The consumer confirms each pop with a
+ *            compare-and-swap on the front, and retries with the next item
+ *            when the producer dropped the one it was reading. A consumer
+ *            can tell it was overrun by a change of
+ *            @ref qtip_spsc_total_overwritten_items.
+ *            @ref qtip_spsc_put_up_to_n still stops at a full queue.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] enabled  `true` to replace the oldest item, `false` to reject the put
+ * @note      Must not be called while a producer or consumer uses the queue
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason               |
+ *    | ----------------------------- | -------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                   |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` is NULL   |
+ *    | @ref QTIP_STATUS_FULL         | NA                   |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                   |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                   |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                   |
+ */
+qtipStatus_t qtip_spsc_set_overwrite(qtipSpscContext_t* pContext, bool enabled);
+
+/**
+ * @brief      Get number of items replaced by puts into a full single-producer/single-consumer queue
+ * @details    May be called from either thread.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pResult  Pointer to variable to hold the result
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_spsc_total_overwritten_items(qtipSpscContext_t* pContext, size_t* pResult);
+
+#endif // DISABLE_OVERWRITE
+
+/**
+ * @brief     Put an item in a single-producer/single-consumer queue
+ * @details   Copies the value of pItem to the back of the queue.
+ * @param[in] pContext Pointer to queue context
+ * @param[in] pItem    Pointer to item to store in the queue
+ * @note      Must only be called from the producer thread
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                        |
+ *    | ----------------------------- | ----------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful          |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                            |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | Queue is full                 |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                            |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                            |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                            |
+ */
+qtipStatus_t qtip_spsc_put(qtipSpscContext_t* pContext, void* pItem);
+
+/**
+ * @brief      Extract the next item from a single-producer/single-consumer queue
+ * @details    Pulls and removes the next item in the queue and puts it into pItem.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItem    Pointer to item to store in the queue
+ * @note       Must only be called from the consumer thread
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                        |
+ *    | ----------------------------- | ----------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful          |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                            |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                            |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                            |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                            |
+ */
+qtipStatus_t qtip_spsc_pop(qtipSpscContext_t* pContext, void* pItem);
+
+/**
+ * @brief      Put up to `n` items in a single-producer/single-consumer queue
+ * @details    Copies as many of the `n` items in pItems as fit to the back of the queue
+ *             and publishes them at once.
+ * @param[in]  pContext Pointer to queue context
+ * @param[in]  pItems   Pointer to the items to store in the queue
+ * @param[in]  n        Maximum number of items to store
+ * @param[out] pPut     Pointer to the variable to hold the number of stored items
+ * @note       Must only be called from the producer thread
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                  |
+ *    | ----------------------------- | --------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | At least one item stored, or `n` is `0` |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                      |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `pItems` or `pPut` is NULL  |
+ *    | @ref QTIP_STATUS_FULL         | Queue is full                           |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                      |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                      |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                      |
+ */
+qtipStatus_t qtip_spsc_put_up_to_n(qtipSpscContext_t* pContext, void* pItems, qtipSize_t n, qtipSize_t* pPut);
+
+/**
+ * @brief      Extract up to `n` items from a single-producer/single-consumer queue
+ * @details    Pulls and removes as many of the next `n` items as are available
+ *             and releases their slots at once.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItems   Pointer to the buffer to hold the items
+ * @param[in]  n        Maximum number of items to extract
+ * @param[out] pPopped  Pointer to the variable to hold the number of extracted items
+ * @note       Must only be called from the consumer thread
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                    |
+ *    | ----------------------------- | ----------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | At least one item popped, or `n` is `0`   |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                        |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext`, `pItems` or `pPopped` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                                        |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                            |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                        |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                        |
+ */
+qtipStatus_t qtip_spsc_pop_up_to_n(qtipSpscContext_t* pContext, void* pItems, qtipSize_t n, qtipSize_t* pPopped);
+
+/**
+ * @brief      Gets the item at the front of a single-producer/single-consumer queue
+ * @details    The item at the front of the queue is fetched, but not removed.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pItem    Pointer to the item at the front of the queue
+ * @note       Must only be called from the consumer thread
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                        |
+ *    | ----------------------------- | ----------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful          |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                            |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                            |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue is empty                |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                            |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                            |
+ */
+qtipStatus_t qtip_spsc_get_front(qtipSpscContext_t* pContext, void* pItem);
+
+/**
+ * @brief      Gets the number of items in a single-producer/single-consumer queue
+ * @details    The result is a snapshot and may be outdated as soon as it is returned
+ *             when called concurrently with the producer or the consumer.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pResult  Pointer to the variable to hold the result
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_spsc_count_items(qtipSpscContext_t* pContext, qtipSize_t* pResult);
+
+#ifndef DISABLE_WAIT
+
+/**
+ * @brief     Put an item in a single-producer/single-consumer queue, waiting for a free slot
+ * @details   Like @ref qtip_spsc_put, but if the queue is full it waits until a
+ *            slot is freed or `timeoutUs` microseconds pass, using `strategy`.
+ * @param[in] pContext  Pointer to queue context
+ * @param[in] pItem     Pointer to item to store in the queue
+ * @param[in] timeoutUs Maximum time to wait, or @ref QTIP_WAIT_FOREVER
+ * @param[in] strategy  How to wait
+ * @note      Must only be called from the producer thread
+ * @returns   Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                    |
+ *    | ----------------------------- | ----------------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                      |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                        |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL             |
+ *    | @ref QTIP_STATUS_FULL         | Queue still full when the timeout expired |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                                        |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                        |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                        |
+ */
+qtipStatus_t qtip_spsc_put_wait(qtipSpscContext_t* pContext, void* pItem, uint32_t timeoutUs, qtipWaitStrategy_t strategy);
+
+/**
+ * @brief      Extract the next item from a single-producer/single-consumer queue, waiting for an item
+ * @details    Like @ref qtip_spsc_pop, but if the queue is empty it waits until an
+ *             item is put or `timeoutUs` microseconds pass, using `strategy`.
+ * @param[in]  pContext  Pointer to queue context
+ * @param[out] pItem     Pointer to item to store in the queue
+ * @param[in]  timeoutUs Maximum time to wait, or @ref QTIP_WAIT_FOREVER
+ * @param[in]  strategy  How to wait
+ * @note       Must only be called from the consumer thread
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                                     |
+ *    | ----------------------------- | ------------------------------------------ |
+ *    | @ref QTIP_STATUS_OK           | Operation successful                       |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                                         |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pItem` is NULL              |
+ *    | @ref QTIP_STATUS_FULL         | NA                                         |
+ *    | @ref QTIP_STATUS_EMPTY        | Queue still empty when the timeout expired |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                                         |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                                         |
+ */
+qtipStatus_t qtip_spsc_pop_wait(qtipSpscContext_t* pContext, void* pItem, uint32_t timeoutUs, qtipWaitStrategy_t strategy);
+
+#endif // DISABLE_WAIT
+
+#ifndef DISABLE_TELEMETRY
+
+/**
+ * @brief      Get number of items inserted in a single-producer/single-consumer queue
+ * @details    The result considers the all-time number of inserted items.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pResult  Pointer to variable to hold the result
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_spsc_total_enqueued_items(qtipSpscContext_t* pContext, size_t* pResult);
+
+/**
+ * @brief      Get number of processed items in a single-producer/single-consumer queue
+ * @details    The result considers the all-time number of popped items.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pResult  Pointer to variable to hold the result
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                          |
+ *    | ----------------------------- | ------------------------------- |
+ *    | @ref QTIP_STATUS_OK           | Operation successful            |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                              |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pResult` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                              |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                              |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                              |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                              |
+ */
+qtipStatus_t qtip_spsc_total_processed_items(qtipSpscContext_t* pContext, size_t* pResult);
+
+#ifndef DISABLE_STATS
+
+/**
+ * @brief      Get the statistics of a single-producer/single-consumer queue
+ * @details    The producer records the puts and the full queues next to
+ *             `rear`, and the consumer the empty queues next to `front`. Each
+ *             counter has a single writer, so it is updated without a locked
+ *             instruction, and a reset only moves the base it is read against.
+ *             The producer samples the fill level every @ref STATS_SAMPLE_RATE
+ *             puts, with a fresh load of the front, so `histogram` counts the
+ *             sampled puts only. `highWatermark` is also raised whenever the
+ *             producer reloads the front because the queue looked full. The
+ *             queue has no lock, so `locked` is always `0`. The calls of
+ *             @ref qtip_spsc_put_wait and @ref qtip_spsc_pop_wait only count as
+ *             rejected when they time out. Can be called from any thread, but
+ *             not from two threads at once.
+ * @param[in]  pContext Pointer to queue context
+ * @param[out] pStats   Pointer to variable to hold the statistics
+ * @param[in]  reset    Clear the statistics after reading them
+ * @returns    Operation status
+ *
+ * @details
+ *    | Returned @ref qtipStatus_t    | Reason                         |
+ *    | ----------------------------- | ------------------------------ |
+ *    | @ref QTIP_STATUS_OK           | Operation successful           |
+ *    | @ref QTIP_STATUS_LOCKED       | NA                             |
+ *    | @ref QTIP_STATUS_NULL_PTR     | `pContext` or `pStats` is NULL |
+ *    | @ref QTIP_STATUS_FULL         | NA                             |
+ *    | @ref QTIP_STATUS_EMPTY        | NA                             |
+ *    | @ref QTIP_STATUS_INVALID_SIZE | NA                             |
+ *    | @ref QTIP_STATUS_SYSTEM_ERROR | NA                             |
+ */
+qtipStatus_t qtip_spsc_get_stats(qtipSpscContext_t* pContext, qtipStats_t* pStats, bool reset);
+
+#endif // DISABLE_STATS
+
+#endif // DISABLE_TELEMETRY
+
+QTIP_CPP_SUPPORT_END
+
+#endif // QTIP_SPSC_H
+
+/**
+ * @}
+ */
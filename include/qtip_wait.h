@@ -0,0 +1,67 @@
+/**
+ * @file qtip_wait.h
+ * @brief Wait strategies for the blocking operations of the concurrent queues
+ * @author Jose Amador
+ * @copyright MIT License
+ *
+ * @addtogroup API
+ * @{
+ */
+
+#ifndef QTIP_WAIT_H
+#define QTIP_WAIT_H
+
+#include "qtip.h"
+#include "qtip_atomic.h"
+
+#include <stdint.h>
+
+QTIP_CPP_SUPPORT_START
+
+/*
+ * Public defines
+ */
+
+#define QTIP_WAIT_FOREVER UINT32_MAX //!< Timeout that never expires
+
+#ifndef WAIT_SPIN_COUNT
+#define WAIT_SPIN_COUNT 128U //!< Number of spins before yielding or parking
+#endif
+
+/*
+ * Public Enum
+ */
+
+/**
+ * @brief How a blocking operation waits for the queue to change
+ */
+typedef enum
+{
+    QTIP_WAIT_SPIN,  //!< Busy-spin until the operation succeeds or times out
+    QTIP_WAIT_YIELD, //!< Spin for a while, then yield the CPU between retries
+    QTIP_WAIT_PARK   //!< Spin for a while, then sleep until the queue changes
+} qtipWaitStrategy_t;
+
+/*
+ * Public Structs
+ */
+
+/**
+ * @brief Threads parked until a queue changes
+ * @details `sequence` is bumped on every wake-up and is the word parked
+ *          threads sleep on; `waiters` counts the parked threads so the
+ *          other side only makes a system call when someone is asleep.
+ */
+typedef struct
+{
+    QTIP_ATOMIC(uint32_t) sequence; //!< Wake-up counter
+    QTIP_ATOMIC(uint32_t) waiters;  //!< Number of parked threads
+} qtipWaiters_t;
+
+QTIP_CPP_SUPPORT_END
+
+#endif // QTIP_WAIT_H
+
+/**
+ * @}
+ */
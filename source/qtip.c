@@ -6,6 +6,8 @@
  */
 
 #include "qtip.h"
+#include "qtip_fast.h"
+#include "qtip_private.h"
 
 #include <string.h>
 
@@ -13,20 +15,14 @@
  * Private defines
  */
 
-/**
- * @brief Check whether the input is a null pointer
- */
-#define CHECK_NULL_PRT(ptr) (((ptr) != NULL) ? QTIP_STATUS_OK : QTIP_STATUS_NULL_PTR)
-
 /**
  * @brief Check whether the queue is locked
  */
 #define IS_LOCKED(context) ((!is_locked((context))) ? QTIP_STATUS_OK : QTIP_STATUS_LOCKED)
 
-/**
- * @brief Combine the current status with a new expression
- */
-#define CHECK_STATUS(status, exp) (((status) == QTIP_STATUS_OK) ? (exp) : (status))
+#if !defined(DISABLE_SOJOURN) && !defined(REDUCED_API)
+_Static_assert(SOJOURN_BUCKETS <= 64U, "SOJOURN_BUCKETS must not exceed the log2 buckets of a 64-bit time");
+#endif
 
 /*
  * Private functions
@@ -37,19 +33,28 @@ static inline void* absolute_index_to_address(qtipContext_t* pContext, qtipSize_
     return pContext->start + index * pContext->itemSize;
 }
 
-static inline bool is_empty(qtipContext_t* pContext)
+static inline qtipSize_t wrap_index(qtipContext_t* pContext, qtipSize_t index)
+{
+#ifdef POWER_OF_TWO
+    return index & (pContext->maxItems - 1U);
+#else
+    return index % pContext->maxItems;
+#endif
+}
+
+static inline qtipSize_t count_items(qtipContext_t* pContext)
 {
-    return pContext->qty == 0U;
+    return qtip_fast_count_items(pContext);
 }
 
-static inline bool is_full(qtipContext_t* pContext)
+static inline bool is_empty(qtipContext_t* pContext)
 {
-    return pContext->qty == pContext->maxItems;
+    return count_items(pContext) == 0U;
 }
 
-static inline qtipSize_t count_items(qtipContext_t* pContext)
+static inline bool is_full(qtipContext_t* pContext)
 {
-    return pContext->qty;
+    return count_items(pContext) == pContext->maxItems;
 }
 
 static inline void write_item_absolute(qtipContext_t* pContext, qtipSize_t index, void* pItem)
@@ -69,7 +74,7 @@ static inline void delete_item_absolute(qtipContext_t* pContext, qtipSize_t inde
 
 static inline qtipSize_t relative_index_to_absolute(qtipContext_t* pContext, qtipSize_t index)
 {
-    return (pContext->front + index) % pContext->maxItems;
+    return wrap_index(pContext, pContext->front + index);
 }
 
 static inline void* relative_index_to_address(qtipContext_t* pContext, qtipSize_t index)
@@ -99,7 +104,7 @@ static inline void reset_queue(qtipContext_t* pContext)
 
 static inline qtipSize_t next_index_absolute(qtipContext_t* pContext, qtipSize_t index)
 {
-    return (index + 1U) % pContext->maxItems;
+    return wrap_index(pContext, index + 1U);
 }
 
 static inline qtipSize_t next_index_relative(qtipContext_t* pContext, qtipSize_t index)
@@ -107,6 +112,65 @@ static inline qtipSize_t next_index_relative(qtipContext_t* pContext, qtipSize_t
     return next_index_absolute(pContext, relative_index_to_absolute(pContext, index));
 }
 
+static inline qtipSize_t advance_index_absolute(qtipContext_t* pContext, qtipSize_t index, qtipSize_t n)
+{
+    const qtipSize_t untilEnd = pContext->maxItems - index;
+    return (n < untilEnd) ? (index + n) : (n - untilEnd);
+}
+
+static inline qtipSize_t retreat_index_absolute(qtipContext_t* pContext, qtipSize_t index, qtipSize_t n)
+{
+    return (n <= index) ? (index - n) : (index + pContext->maxItems - n);
+}
+
+static inline qtipSize_t count_until_end(qtipContext_t* pContext, qtipSize_t index, qtipSize_t n)
+{
+    const qtipSize_t untilEnd = pContext->maxItems - index;
+
+#if !defined(DISABLE_MIRROR) && !defined(REDUCED_API)
+    // The mirror makes the start of the buffer reachable past its end
+    if (pContext->mirrored)
+    {
+        return n;
+    }
+#endif
+
+    return (n < untilEnd) ? n : untilEnd;
+}
+
+static inline void write_items_absolute(qtipContext_t* pContext, qtipSize_t index, void* pItems, qtipSize_t n)
+{
+    const qtipSize_t first = count_until_end(pContext, index, n);
+
+    memcpy(absolute_index_to_address(pContext, index), pItems, first * pContext->itemSize);
+    if (first < n)
+    {
+        memcpy(pContext->start, pItems + first * pContext->itemSize, (n - first) * pContext->itemSize);
+    }
+}
+
+static inline void read_items_absolute(qtipContext_t* pContext, qtipSize_t index, void* pItems, qtipSize_t n)
+{
+    const qtipSize_t first = count_until_end(pContext, index, n);
+
+    memcpy(pItems, absolute_index_to_address(pContext, index), first * pContext->itemSize);
+    if (first < n)
+    {
+        memcpy(pItems + first * pContext->itemSize, pContext->start, (n - first) * pContext->itemSize);
+    }
+}
+
+static inline void delete_items_absolute(qtipContext_t* pContext, qtipSize_t index, qtipSize_t n)
+{
+    const qtipSize_t first = count_until_end(pContext, index, n);
+
+    memset(absolute_index_to_address(pContext, index), 0U, first * pContext->itemSize);
+    if (first < n)
+    {
+        memset(pContext->start, 0U, (n - first) * pContext->itemSize);
+    }
+}
+
 #ifndef DISABLE_LOCK
 
 static inline bool is_locked(qtipContext_t* pContext)
@@ -126,168 +190,1909 @@ static inline void unlock_queue(qtipContext_t* pContext)
 
 #endif // DISABLE_LOCK
 
-static qtipSize_t move_index(qtipContext_t* pContext, qtipSize_t index)
+static inline qtipSize_t front_index_absolute(qtipContext_t* pContext)
+{
+    return qtip_fast_front_index(pContext);
+}
+
+static inline qtipSize_t rear_index_absolute(qtipContext_t* pContext)
+{
+    return qtip_fast_rear_index(pContext);
+}
+
+static inline qtipSize_t tail_index_absolute(qtipContext_t* pContext)
+{
+    return qtip_fast_tail_index(pContext);
+}
+
+#if !defined(DISABLE_TOMBSTONE) && !defined(REDUCED_API)
+
+static inline bool is_tombstone(qtipContext_t* pContext, qtipSize_t index)
+{
+    return (pContext->pTombstones[index / 8U] & (1U << (index % 8U))) != 0U;
+}
+
+static inline void set_tombstone(qtipContext_t* pContext, qtipSize_t index)
+{
+    pContext->pTombstones[index / 8U] |= (uint8_t) (1U << (index % 8U));
+}
+
+static inline void clear_tombstone(qtipContext_t* pContext, qtipSize_t index)
+{
+    pContext->pTombstones[index / 8U] &= (uint8_t) ~(1U << (index % 8U));
+}
+
+static inline bool has_tombstones(qtipContext_t* pContext)
+{
+    return pContext->tombstones > 0U;
+}
+
+// Gets the bits of up to 56 slots from an absolute index, which fit in one word whatever the bit offset
+static inline uint64_t tombstone_bits(qtipContext_t* pContext, qtipSize_t index, qtipSize_t* pWidth)
+{
+    const qtipSize_t untilEnd = pContext->maxItems - index;
+    const qtipSize_t width    = (untilEnd < 56U) ? untilEnd : 56U;
+    const size_t offset       = index % 8U;
+    const size_t bytes        = (offset + width + 7U) / 8U;
+    uint64_t bits             = 0U;
+
+    for (size_t i = 0U; i < bytes; i++)
+    {
+        bits |= (uint64_t) pContext->pTombstones[(index / 8U) + i] << (8U * i);
+    }
+
+    *pWidth = width;
+    return (bits >> offset) & ((UINT64_C(1) << width) - 1U);
+}
+
+#endif // DISABLE_TOMBSTONE && REDUCED_API
+
+static inline qtipSize_t count_live_items(qtipContext_t* pContext)
+{
+#if !defined(DISABLE_TOMBSTONE) && !defined(REDUCED_API)
+    return count_items(pContext) - pContext->tombstones;
+#else
+    return count_items(pContext);
+#endif
+}
+
+static inline void record_put(qtipContext_t* pContext)
+{
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS) && !defined(REDUCED_API)
+    qtipStats_t* pStats = pContext->pStats;
+
+    if (pStats != NULL)
+    {
+        const qtipSize_t qty = count_items(pContext);
+
+        if (qty > pStats->highWatermark)
+        {
+            pStats->highWatermark = qty;
+        }
+        pStats->histogram[qtip_stats_bucket(qty)]++;
+    }
+#else
+    (void) pContext;
+#endif
+}
+
+static inline qtipStatus_t count_rejection(qtipContext_t* pContext, qtipStatus_t status)
+{
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS) && !defined(REDUCED_API)
+    // The context of a call rejected for its arguments may be NULL, so it is only read for the counted statuses
+    const bool counted =
+        (status == QTIP_STATUS_FULL) || (status == QTIP_STATUS_EMPTY) || (status == QTIP_STATUS_LOCKED);
+    qtipStats_t* pStats = counted ? pContext->pStats : NULL;
+
+    if (pStats != NULL)
+    {
+        if (status == QTIP_STATUS_FULL)
+        {
+            pStats->full++;
+        }
+        else if (status == QTIP_STATUS_EMPTY)
+        {
+            pStats->empty++;
+        }
+        else if (status == QTIP_STATUS_LOCKED)
+        {
+            pStats->locked++;
+        }
+    }
+#else
+    (void) pContext;
+#endif
+
+    return status;
+}
+
+static inline void advance_rear(qtipContext_t* pContext, qtipSize_t n)
+{
+#ifndef DISABLE_NOTIFY
+    const qtipSize_t before = count_items(pContext);
+#endif
+
+#ifdef POWER_OF_TWO
+    pContext->rear += n;
+#else
+    pContext->rear = advance_index_absolute(pContext, tail_index_absolute(pContext), n - 1U);
+    pContext->qty += n;
+#endif
+
+#ifndef DISABLE_NOTIFY
+    qtip_fast_notify(pContext, before);
+#endif
+}
+
+static inline void move_front(qtipContext_t* pContext, qtipSize_t n)
+{
+#ifdef POWER_OF_TWO
+    pContext->front += n;
+#else
+    pContext->qty -= n;
+    pContext->front = is_empty(pContext) ? 0U : advance_index_absolute(pContext, pContext->front, n);
+#endif
+}
+
+static inline void advance_front(qtipContext_t* pContext, qtipSize_t n)
+{
+    move_front(pContext, n);
+
+#if !defined(DISABLE_TOMBSTONE) && !defined(REDUCED_API)
+    // The rear item is never removed in place, so this stops before the queue is empty
+    while (has_tombstones(pContext) && is_tombstone(pContext, front_index_absolute(pContext)))
+    {
+        clear_tombstone(pContext, front_index_absolute(pContext));
+        pContext->tombstones--;
+        move_front(pContext, 1U);
+    }
+#endif
+}
+
+static inline void retreat_front(qtipContext_t* pContext, qtipSize_t n)
+{
+#ifndef DISABLE_NOTIFY
+    const qtipSize_t before = count_items(pContext);
+#endif
+
+#ifdef POWER_OF_TWO
+    pContext->front -= n;
+#else
+    if (is_empty(pContext))
+    {
+        pContext->rear = retreat_index_absolute(pContext, pContext->front, 1U);
+    }
+    pContext->front = retreat_index_absolute(pContext, pContext->front, n);
+    pContext->qty += n;
+#endif
+
+#ifndef DISABLE_NOTIFY
+    qtip_fast_notify(pContext, before);
+#endif
+}
+
+static inline void retreat_rear(qtipContext_t* pContext, qtipSize_t n)
 {
-    qtipSize_t newHeadIndex = index;
+#ifdef POWER_OF_TWO
+    pContext->rear -= n;
+#else
+    pContext->qty -= n;
     if (is_empty(pContext))
     {
-        newHeadIndex = 0U;
+        pContext->front = 0U;
+        pContext->rear  = 0U;
+    }
+    else
+    {
+        pContext->rear = retreat_index_absolute(pContext, pContext->rear, n);
+    }
+#endif
+}
+
+static inline void drop_rear(qtipContext_t* pContext)
+{
+    retreat_rear(pContext, 1U);
+
+#if !defined(DISABLE_TOMBSTONE) && !defined(REDUCED_API)
+    // The front item is never removed in place, so this stops before the queue is empty
+    while (has_tombstones(pContext) && is_tombstone(pContext, rear_index_absolute(pContext)))
+    {
+        clear_tombstone(pContext, rear_index_absolute(pContext));
+        pContext->tombstones--;
+        retreat_rear(pContext, 1U);
+    }
+#endif
+}
+
+#if !defined(DISABLE_SOJOURN) && !defined(REDUCED_API)
+
+static inline uint64_t read_clock(qtipContext_t* pContext)
+{
+    return pContext->pSojourn->clock(pContext->pSojourn->pClockArg);
+}
+
+static inline void record_sojourn(qtipContext_t* pContext, uint64_t sojourn)
+{
+    const size_t bucket = qtip_log2(sojourn);
+
+    pContext->pSojourn->histogram[(bucket < SOJOURN_BUCKETS) ? bucket : (SOJOURN_BUCKETS - 1U)]++;
+}
+
+static void record_sojourns(qtipContext_t* pContext, uint64_t now, qtipSize_t index, qtipSize_t n, bool toRear)
+{
+    // Walks from the absolute index over the next n live items
+    while (n > 0U)
+    {
+#ifndef DISABLE_TOMBSTONE
+        if (!has_tombstones(pContext) || !is_tombstone(pContext, index))
+#endif
+        {
+            record_sojourn(pContext, now - pContext->pSojourn->pTimestamps[index]);
+            n--;
+        }
+
+        index = toRear ? next_index_absolute(pContext, index) : retreat_index_absolute(pContext, index, 1U);
+    }
+}
+
+static uint64_t square_root(uint64_t value)
+{
+    uint64_t root = value;
+    uint64_t next = (value + 1U) / 2U;
+
+    while (next < root)
+    {
+        root = next;
+        next = (root + (value / root)) / 2U;
+    }
+
+    return root;
+}
+
+static inline uint64_t control_law(qtipCodel_t* pCodel, uint64_t time)
+{
+    return time + (pCodel->interval / square_root(pCodel->count));
+}
+
+static bool is_above_target(qtipContext_t* pContext, uint64_t now, uint64_t sojourn)
+{
+    qtipCodel_t* pCodel = &pContext->pSojourn->codel;
+    bool above          = false;
+
+    // A queue down to its last item is draining, whatever the sojourn time of that item
+    if ((sojourn < pCodel->target) || (count_live_items(pContext) <= 1U))
+    {
+        pCodel->firstAbove = 0U;
+    }
+    else if (pCodel->firstAbove == 0U)
+    {
+        pCodel->firstAbove = now + pCodel->interval;
     }
     else
     {
-        newHeadIndex = next_index_absolute(pContext, index);
+        above = now >= pCodel->firstAbove;
+    }
+
+    return above;
+}
+
+static bool is_late(qtipContext_t* pContext, uint64_t now, uint64_t sojourn)
+{
+    qtipCodel_t* pCodel = &pContext->pSojourn->codel;
+    bool late           = false;
+
+    if (pCodel->target > 0U)
+    {
+        const bool above = is_above_target(pContext, now, sojourn);
+
+        if (pCodel->dropping)
+        {
+            pCodel->dropping = above;
+            if (above && (now >= pCodel->dropNext))
+            {
+                late = true;
+                pCodel->count++;
+                pCodel->dropNext = control_law(pCodel, pCodel->dropNext);
+            }
+        }
+        else if (above)
+        {
+            // Dropping that stopped shortly before resumes near the rate it had reached
+            const uint32_t delta = pCodel->count - pCodel->lastCount;
+
+            late              = true;
+            pCodel->dropping  = true;
+            pCodel->count     = ((delta > 1U) && ((now - pCodel->dropNext) < (16U * pCodel->interval))) ? delta : 1U;
+            pCodel->dropNext  = control_law(pCodel, now);
+            pCodel->lastCount = pCodel->count;
+        }
+
+        if (late)
+        {
+            pCodel->late++;
+        }
+    }
+
+    return late;
+}
+
+#endif // DISABLE_SOJOURN && REDUCED_API
+
+static inline void stamp_items(qtipContext_t* pContext, qtipSize_t index, qtipSize_t n)
+{
+#if !defined(DISABLE_SOJOURN) && !defined(REDUCED_API)
+    if (pContext->pSojourn != NULL)
+    {
+        const uint64_t now = read_clock(pContext);
+
+        for (; n > 0U; n--)
+        {
+            pContext->pSojourn->pTimestamps[index] = now;
+            index                        = next_index_absolute(pContext, index);
+        }
+    }
+#else
+    (void) pContext;
+    (void) index;
+    (void) n;
+#endif
+}
+
+static inline void move_stamp(qtipContext_t* pContext, qtipSize_t to, qtipSize_t from)
+{
+#if !defined(DISABLE_SOJOURN) && !defined(REDUCED_API)
+    if (pContext->pSojourn != NULL)
+    {
+        pContext->pSojourn->pTimestamps[to] = pContext->pSojourn->pTimestamps[from];
+    }
+#else
+    (void) pContext;
+    (void) to;
+    (void) from;
+#endif
+}
+
+static bool time_front(qtipContext_t* pContext, qtipSize_t n, bool mayDrop, uint64_t* pSojourn)
+{
+    uint64_t sojourn = 0U;
+    bool late        = false;
+
+#if !defined(DISABLE_SOJOURN) && !defined(REDUCED_API)
+    // Every removal from the front comes through here, and the policy judges the oldest of the n items
+    if (pContext->pSojourn != NULL)
+    {
+        const uint64_t now = read_clock(pContext);
+
+        sojourn = now - pContext->pSojourn->pTimestamps[front_index_absolute(pContext)];
+        late    = is_late(pContext, now, sojourn);
+
+        // The last item is never late, and the n items of the caller are always left
+        while (late && mayDrop && pContext->pSojourn->codel.drop && (count_live_items(pContext) > n))
+        {
+            delete_item_absolute(pContext, front_index_absolute(pContext));
+            advance_front(pContext, 1U);
+
+            sojourn = now - pContext->pSojourn->pTimestamps[front_index_absolute(pContext)];
+            late    = is_late(pContext, now, sojourn);
+        }
+
+        record_sojourns(pContext, now, front_index_absolute(pContext), n, true);
+    }
+#else
+    (void) pContext;
+    (void) n;
+    (void) mayDrop;
+#endif
+
+    if (pSojourn != NULL)
+    {
+        *pSojourn = sojourn;
+    }
+
+    return late;
+}
+
+static inline void time_rear(qtipContext_t* pContext, qtipSize_t n)
+{
+#if !defined(DISABLE_SOJOURN) && !defined(REDUCED_API)
+    if (pContext->pSojourn != NULL)
+    {
+        record_sojourns(pContext, read_clock(pContext), rear_index_absolute(pContext), n, false);
     }
+#else
+    (void) pContext;
+    (void) n;
+#endif
+}
+
+#if !defined(DISABLE_OVERWRITE) && !defined(REDUCED_API)
 
-    return newHeadIndex;
+static inline void overwrite_item(qtipContext_t* pContext, void* pItem)
+{
+    // The queue is full, so the tail slot is the front slot
+    write_item_absolute(pContext, front_index_absolute(pContext), pItem);
+    stamp_items(pContext, front_index_absolute(pContext), 1U);
+#ifdef POWER_OF_TWO
+    pContext->front++;
+    pContext->rear++;
+#else
+    pContext->front = next_index_absolute(pContext, pContext->front);
+    pContext->rear  = next_index_absolute(pContext, pContext->rear);
+#endif
+    pContext->overwritten++;
+    record_put(pContext);
+
+#ifndef DISABLE_TELEMETRY
+    pContext->total++;
+#endif
+}
+
+#endif // DISABLE_OVERWRITE && REDUCED_API
+
+static inline void reset_indexes(qtipContext_t* pContext)
+{
+    pContext->front = 0U;
+    pContext->rear  = 0U;
+#ifndef POWER_OF_TWO
+    pContext->qty = 0U;
+#endif
+}
+
+#ifndef REDUCED_API
+
+static inline qtipSize_t count_free(qtipContext_t* pContext)
+{
+    return pContext->maxItems - count_items(pContext);
 }
 
-static void sweep_items(qtipContext_t* pContext, qtipSize_t index)
-{
-    void* pHead  = relative_index_to_address(pContext, index);
-    qtipSize_t i = 0U;
+static void put_items(qtipContext_t* pContext, void* pItems, qtipSize_t n)
+{
+    write_items_absolute(pContext, tail_index_absolute(pContext), pItems, n);
+    stamp_items(pContext, tail_index_absolute(pContext), n);
+    advance_rear(pContext, n);
+    record_put(pContext);
+
+#ifndef DISABLE_TELEMETRY
+    pContext->total += n;
+#endif
+}
+
+static void pop_items(qtipContext_t* pContext, void* pItems, qtipSize_t n)
+{
+#ifndef DISABLE_TELEMETRY
+    pContext->processed += n;
+#endif
+
+    (void) time_front(pContext, n, true, NULL);
+
+#ifndef DISABLE_TOMBSTONE
+    // Removed slots split the run, so take one item at a time until they are gone
+    for (; has_tombstones(pContext) && (n > 0U); n--)
+    {
+        read_item_absolute(pContext, front_index_absolute(pContext), pItems);
+        delete_item_absolute(pContext, front_index_absolute(pContext));
+        advance_front(pContext, 1U);
+        pItems += pContext->itemSize;
+    }
+#endif
+
+    read_items_absolute(pContext, front_index_absolute(pContext), pItems, n);
+    delete_items_absolute(pContext, front_index_absolute(pContext), n);
+    advance_front(pContext, n);
+}
+
+static void push_front_items(qtipContext_t* pContext, void* pItems, qtipSize_t n)
+{
+    const qtipSize_t index = retreat_index_absolute(pContext, front_index_absolute(pContext), n);
+
+    write_items_absolute(pContext, index, pItems, n);
+    stamp_items(pContext, index, n);
+    retreat_front(pContext, n);
+    record_put(pContext);
+
+#ifndef DISABLE_TELEMETRY
+    pContext->total += n;
+#endif
+}
+
+static void pop_back_items(qtipContext_t* pContext, void* pItems, qtipSize_t n)
+{
+#ifndef DISABLE_TELEMETRY
+    pContext->processed += n;
+#endif
+
+    time_rear(pContext, n);
+
+#ifndef DISABLE_TOMBSTONE
+    // The items are stored in queue order, so the buffer is filled from its end
+    for (; has_tombstones(pContext) && (n > 0U); n--)
+    {
+        read_item_absolute(pContext, rear_index_absolute(pContext), pItems + ((n - 1U) * pContext->itemSize));
+        delete_item_absolute(pContext, rear_index_absolute(pContext));
+        drop_rear(pContext);
+    }
+#endif
+
+    const qtipSize_t index = relative_index_to_absolute(pContext, count_items(pContext) - n);
+
+    read_items_absolute(pContext, index, pItems, n);
+    delete_items_absolute(pContext, index, n);
+    retreat_rear(pContext, n);
+}
+
+static void drop_items(qtipContext_t* pContext, qtipSize_t n)
+{
+    // The caller already used the items in place, so none of them can be dropped
+    (void) time_front(pContext, n, false, NULL);
+
+#ifndef DISABLE_TOMBSTONE
+    for (; has_tombstones(pContext) && (n > 0U); n--)
+    {
+        advance_front(pContext, 1U);
+    }
+#endif
+
+    advance_front(pContext, n);
+}
+
+#ifndef DISABLE_GROW
+
+static inline bool is_growable(qtipContext_t* pContext)
+{
+    return pContext->pAllocator != NULL;
+}
+
+static bool resize_queue(qtipContext_t* pContext, qtipSize_t maxItems)
+{
+    const qtipSize_t count = count_items(pContext);
+    void* pBuffer          = pContext->pAllocator->alloc(maxItems * pContext->itemSize, pContext->pAllocator->pArg);
+
+    if (pBuffer != NULL)
+    {
+        // Unroll the wrapped items to the start of the new buffer
+        read_items_absolute(pContext, front_index_absolute(pContext), pBuffer, count);
+        memset(pBuffer + count * pContext->itemSize, 0U, (maxItems - count) * pContext->itemSize);
+        pContext->pAllocator->free(pContext->start, pContext->pAllocator->pArg);
+
+        pContext->start    = pBuffer;
+        pContext->maxItems = maxItems;
+        pContext->front    = 0U;
+#ifdef POWER_OF_TWO
+        pContext->rear = count;
+#else
+        pContext->rear = (count > 0U) ? (count - 1U) : 0U;
+#endif
+    }
+
+    return pBuffer != NULL;
+}
+
+static void make_room(qtipContext_t* pContext, qtipSize_t n)
+{
+    if (is_growable(pContext) && (count_free(pContext) < n) && (pContext->maxItems < pContext->capItems))
+    {
+        const qtipSize_t count = count_items(pContext);
+        qtipSize_t maxItems    = pContext->maxItems;
+
+        while (((maxItems - count) < n) && (maxItems < pContext->capItems))
+        {
+            maxItems = ((pContext->capItems / 2U) < maxItems) ? pContext->capItems : (maxItems * 2U);
+        }
+
+        // A failed allocation leaves the queue as it was, so the insertion reports FULL
+        (void) resize_queue(pContext, maxItems);
+    }
+}
+
+static void shrink_if_idle(qtipContext_t* pContext)
+{
+    if (is_growable(pContext) && (pContext->shrinkAfter > 0U) && (pContext->maxItems > pContext->minItems))
+    {
+        if (count_items(pContext) <= (pContext->maxItems / 4U))
+        {
+            pContext->lowPops++;
+        }
+        else
+        {
+            pContext->lowPops = 0U;
+        }
+
+        if (pContext->lowPops >= pContext->shrinkAfter)
+        {
+            const qtipSize_t half = pContext->maxItems / 2U;
+
+            (void) resize_queue(pContext, (half > pContext->minItems) ? half : pContext->minItems);
+            pContext->lowPops = 0U;
+        }
+    }
+}
+
+#endif // DISABLE_GROW
+
+#endif // REDUCED_API
+
+static void sweep_items(qtipContext_t* pContext, qtipSize_t index)
+{
+    void* pHead = relative_index_to_address(pContext, index);
+
+    for (qtipSize_t i = index + 1U; i < count_items(pContext); i++)
+    {
+        void* pNextItem = relative_index_to_address(pContext, i);
+        memcpy(pHead, pNextItem, pContext->itemSize);
+        move_stamp(pContext, relative_index_to_absolute(pContext, i - 1U), relative_index_to_absolute(pContext, i));
+        pHead = pNextItem;
+    }
+
+    memset(pHead, 0U, pContext->itemSize);
+    retreat_rear(pContext, 1U);
+}
+
+#ifndef REDUCED_API
+
+static inline bool take_tombstone(qtipContext_t* pContext, qtipSize_t index)
+{
+    bool taken = false;
+
+#ifndef DISABLE_TOMBSTONE
+    if (has_tombstones(pContext) && is_tombstone(pContext, index))
+    {
+        clear_tombstone(pContext, index);
+        pContext->tombstones--;
+        taken = true;
+    }
+#else
+    (void) pContext;
+    (void) index;
+#endif
+
+    return taken;
+}
+
+static bool transfer_item(qtipContext_t* pTarget, void* pItem)
+{
+#ifndef DISABLE_GROW
+    make_room(pTarget, 1U);
+#endif
+
+    const bool hasRoom = count_free(pTarget) > 0U;
+
+    if (hasRoom)
+    {
+        put_items(pTarget, pItem, 1U);
+    }
+
+    return hasRoom;
+}
+
+static qtipStatus_t filter_items(qtipContext_t* pContext,
+                                 qtipPredicate_t predicate,
+                                 void* pArg,
+                                 qtipContext_t* pTarget,
+                                 qtipSize_t* pRemoved)
+{
+    const qtipSize_t count = count_items(pContext);
+    qtipStatus_t status    = QTIP_STATUS_OK;
+    qtipSize_t kept        = 0U;
+
+    *pRemoved = 0U;
+
+    // Every kept item moves forward over the removed ones, so the order is kept in one pass
+    for (qtipSize_t i = 0U; i < count; i++)
+    {
+        void* pItem = relative_index_to_address(pContext, i);
+        bool keep   = !take_tombstone(pContext, relative_index_to_absolute(pContext, i));
+
+        if (keep && (predicate != NULL) && predicate(pItem, pArg))
+        {
+            keep = (pTarget != NULL) && !transfer_item(pTarget, pItem);
+            if (keep)
+            {
+                status = QTIP_STATUS_FULL;
+            }
+            else
+            {
+                (*pRemoved)++;
+            }
+        }
+
+        if (keep)
+        {
+            if (kept != i)
+            {
+                memcpy(relative_index_to_address(pContext, kept), pItem, pContext->itemSize);
+                move_stamp(pContext, relative_index_to_absolute(pContext, kept), relative_index_to_absolute(pContext, i));
+            }
+            kept++;
+        }
+    }
+
+    for (qtipSize_t i = kept; i < count; i++)
+    {
+        delete_item_absolute(pContext, relative_index_to_absolute(pContext, i));
+    }
+
+    if (kept == 0U)
+    {
+        reset_indexes(pContext);
+    }
+    else
+    {
+#ifdef POWER_OF_TWO
+        pContext->rear = pContext->front + kept;
+#else
+        pContext->qty  = kept;
+        pContext->rear = relative_index_to_absolute(pContext, kept - 1U);
+#endif
+    }
+
+    return status;
+}
+
+#ifndef DISABLE_TOMBSTONE
+
+static void compact_items(qtipContext_t* pContext)
+{
+    qtipSize_t removed = 0U;
+
+    (void) filter_items(pContext, NULL, NULL, NULL, &removed);
+}
+
+static inline void reclaim_slots(qtipContext_t* pContext, qtipSize_t n)
+{
+    if (has_tombstones(pContext) && (count_free(pContext) < n))
+    {
+        compact_items(pContext);
+    }
+}
+
+static void bury_item(qtipContext_t* pContext, qtipSize_t index)
+{
+    const qtipSize_t absolute = relative_index_to_absolute(pContext, index);
+
+    delete_item_absolute(pContext, absolute);
+
+    if (index == 0U)
+    {
+        advance_front(pContext, 1U);
+    }
+    else if (index == (count_items(pContext) - 1U))
+    {
+        drop_rear(pContext);
+    }
+    else
+    {
+        set_tombstone(pContext, absolute);
+        pContext->tombstones++;
+
+        if ((pContext->compactPercent > 0U) &&
+            ((pContext->tombstones * 100U) > (count_items(pContext) * pContext->compactPercent)))
+        {
+            compact_items(pContext);
+        }
+    }
+}
+
+#endif // DISABLE_TOMBSTONE
+
+static qtipSize_t live_to_relative(qtipContext_t* pContext, qtipSize_t index)
+{
+    qtipSize_t relative = index;
+
+#ifndef DISABLE_TOMBSTONE
+    if (has_tombstones(pContext))
+    {
+        qtipSize_t absolute = front_index_absolute(pContext);
+        qtipSize_t skip     = index;
+        qtipSize_t width    = 0U;
+        uint64_t bits       = tombstone_bits(pContext, absolute, &width);
+
+        // Whole words of slots are skipped by counting their live items
+        relative = 0U;
+        while ((width - qtip_popcount(bits)) <= skip)
+        {
+            skip -= width - qtip_popcount(bits);
+            relative += width;
+            absolute = ((absolute + width) < pContext->maxItems) ? (absolute + width) : 0U;
+            bits     = tombstone_bits(pContext, absolute, &width);
+        }
+
+        for (; ((bits & 1U) != 0U) || (skip > 0U); bits >>= 1U)
+        {
+            skip -= ((bits & 1U) == 0U) ? 1U : 0U;
+            relative++;
+        }
+    }
+#else
+    (void) pContext;
+#endif
+
+    return relative;
+}
+
+static void remove_item(qtipContext_t* pContext, qtipSize_t index)
+{
+#ifndef DISABLE_TOMBSTONE
+    if (pContext->pTombstones != NULL)
+    {
+        bury_item(pContext, index);
+        return;
+    }
+#endif
+
+    sweep_items(pContext, index);
+}
+
+#endif // REDUCED_API
+
+#if !defined(DISABLE_TOMBSTONE) && !defined(REDUCED_API)
+
+static void read_live_items(qtipContext_t* pContext, void* pItems)
+{
+    const qtipSize_t count = count_items(pContext);
+
+    if (!has_tombstones(pContext))
+    {
+        read_items_absolute(pContext, front_index_absolute(pContext), pItems, count);
+        return;
+    }
+
+    for (qtipSize_t i = 0U; i < count; i++)
+    {
+        const qtipSize_t index = relative_index_to_absolute(pContext, i);
+
+        if (!is_tombstone(pContext, index))
+        {
+            read_item_absolute(pContext, index, pItems);
+            pItems += pContext->itemSize;
+        }
+    }
+}
+
+#endif // DISABLE_TOMBSTONE && REDUCED_API
+
+/*
+ * Public API
+ */
+
+qtipStatus_t qtip_init(qtipContext_t* pContext, void* pBuffer, qtipSize_t maxItems, size_t itemSize)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pBuffer));
+    status = CHECK_STATUS(status, (maxItems > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status, (itemSize > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+#ifdef POWER_OF_TWO
+    status = CHECK_STATUS(status, ((maxItems & (maxItems - 1U)) == 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+#endif
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        pContext->itemSize = itemSize;
+        pContext->maxItems = maxItems;
+        pContext->start    = pBuffer;
+        reset_indexes(pContext);
+#ifndef DISABLE_LOCK
+        pContext->locked = false;
+#endif
+#ifndef REDUCED_API
+        pContext->reserved = false;
+#endif
+#if !defined(DISABLE_MIRROR) && !defined(REDUCED_API)
+        pContext->mirrored = false;
+#endif
+#if !defined(DISABLE_GROW) && !defined(REDUCED_API)
+        pContext->pAllocator  = NULL;
+        pContext->minItems    = maxItems;
+        pContext->capItems    = maxItems;
+        pContext->shrinkAfter = 0U;
+        pContext->lowPops     = 0U;
+#endif
+#if !defined(DISABLE_TOMBSTONE) && !defined(REDUCED_API)
+        pContext->pTombstones    = NULL;
+        pContext->tombstones     = 0U;
+        pContext->compactPercent = 0U;
+#endif
+#if !defined(DISABLE_OVERWRITE) && !defined(REDUCED_API)
+        pContext->overwrite   = false;
+        pContext->overwritten = 0U;
+#endif
+#if !defined(DISABLE_SOJOURN) && !defined(REDUCED_API)
+        pContext->pSojourn = NULL;
+#endif
+#ifndef DISABLE_TELEMETRY
+        pContext->total     = 0U;
+        pContext->processed = 0U;
+#endif
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS) && !defined(REDUCED_API)
+        pContext->pStats = NULL;
+#endif
+#ifndef DISABLE_NOTIFY
+        pContext->notify          = NULL;
+        pContext->pNotifyArg      = NULL;
+        pContext->notifyThreshold = 0U;
+#endif
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_put(qtipContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+#if !defined(DISABLE_TOMBSTONE) && !defined(REDUCED_API)
+        reclaim_slots(pContext, 1U);
+#endif
+#if !defined(DISABLE_GROW) && !defined(REDUCED_API)
+        make_room(pContext, 1U);
+#endif
+
+        if (!is_full(pContext))
+        {
+#ifndef DISABLE_LOCK
+            lock_queue(pContext);
+#endif
+            write_item_absolute(pContext, tail_index_absolute(pContext), pItem);
+            stamp_items(pContext, tail_index_absolute(pContext), 1U);
+            advance_rear(pContext, 1U);
+            record_put(pContext);
+
+#ifndef DISABLE_TELEMETRY
+            pContext->total++;
+#endif
+
+#ifndef DISABLE_LOCK
+            unlock_queue(pContext);
+#endif
+        }
+#if !defined(DISABLE_OVERWRITE) && !defined(REDUCED_API)
+        else if (pContext->overwrite)
+        {
+#ifndef DISABLE_LOCK
+            lock_queue(pContext);
+#endif
+            overwrite_item(pContext, pItem);
+
+#ifndef DISABLE_LOCK
+            unlock_queue(pContext);
+#endif
+        }
+#endif
+        else
+        {
+            status = QTIP_STATUS_FULL;
+        }
+    }
+
+    return count_rejection(pContext, status);
+}
+
+qtipStatus_t qtip_pop(qtipContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        if (!is_empty(pContext))
+        {
+#ifndef DISABLE_LOCK
+            lock_queue(pContext);
+#endif
+            (void) time_front(pContext, 1U, true, NULL);
+            read_item_absolute(pContext, front_index_absolute(pContext), pItem);
+            delete_item_absolute(pContext, front_index_absolute(pContext));
+            advance_front(pContext, 1U);
+
+#ifndef DISABLE_TELEMETRY
+            pContext->processed++;
+#endif
+
+#ifndef DISABLE_LOCK
+            unlock_queue(pContext);
+#endif
+
+#if !defined(DISABLE_GROW) && !defined(REDUCED_API)
+            shrink_if_idle(pContext);
+#endif
+        }
+        else
+        {
+            status = QTIP_STATUS_EMPTY;
+        }
+    }
+
+    return count_rejection(pContext, status);
+}
+
+qtipStatus_t qtip_peek(qtipContext_t* pContext, void* pBuffer, qtipSize_t* pSize)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pBuffer));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pSize));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+#ifndef DISABLE_LOCK
+        lock_queue(pContext);
+#endif
+        *pSize = count_live_items(pContext);
+#if !defined(DISABLE_TOMBSTONE) && !defined(REDUCED_API)
+        read_live_items(pContext, pBuffer);
+#else
+        read_items_absolute(pContext, front_index_absolute(pContext), pBuffer, count_items(pContext));
+#endif
+
+#ifndef DISABLE_LOCK
+        unlock_queue(pContext);
+#endif
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_purge(qtipContext_t* pContext)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+#ifndef DISABLE_LOCK
+        lock_queue(pContext);
+#endif
+
+        reset_queue(pContext);
+        reset_indexes(pContext);
+#ifndef REDUCED_API
+        pContext->reserved = false;
+#endif
+#if !defined(DISABLE_TOMBSTONE) && !defined(REDUCED_API)
+        if (pContext->pTombstones != NULL)
+        {
+            memset(pContext->pTombstones, 0U, QTIP_TOMBSTONE_BITMAP_SIZE(pContext->maxItems));
+        }
+        pContext->tombstones = 0U;
+#endif
+
+#ifndef DISABLE_LOCK
+        unlock_queue(pContext);
+#endif
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_get_rear(qtipContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        if (!is_empty(pContext))
+        {
+#ifndef DISABLE_LOCK
+            lock_queue(pContext);
+#endif
+
+            read_item_absolute(pContext, rear_index_absolute(pContext), pItem);
+
+#ifndef DISABLE_LOCK
+            unlock_queue(pContext);
+#endif
+        }
+        else
+        {
+            status = QTIP_STATUS_EMPTY;
+        }
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_get_front(qtipContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        if (!is_empty(pContext))
+        {
+#ifndef DISABLE_LOCK
+            lock_queue(pContext);
+#endif
+
+            read_item_absolute(pContext, front_index_absolute(pContext), pItem);
+
+#ifndef DISABLE_LOCK
+            unlock_queue(pContext);
+#endif
+        }
+        else
+        {
+            status = QTIP_STATUS_EMPTY;
+        }
+    }
+
+    return status;
+}
+
+#ifndef DISABLE_LOCK
+
+qtipStatus_t qtip_is_locked(qtipContext_t* pContext)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = IS_LOCKED(pContext);
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_lock(qtipContext_t* pContext)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        lock_queue(pContext);
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_unlock(qtipContext_t* pContext)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        unlock_queue(pContext);
+    }
+
+    return status;
+}
+
+#endif // DISABLE_LOCK
+
+#ifndef DISABLE_NOTIFY
+
+qtipStatus_t qtip_set_notifier(qtipContext_t* pContext,
+                               qtipNotifyCallback_t callback,
+                               void* pArg,
+                               qtipSize_t threshold)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, (threshold <= pContext->maxItems) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        pContext->notify          = callback;
+        pContext->pNotifyArg      = pArg;
+        pContext->notifyThreshold = threshold;
+    }
+
+    return status;
+}
+
+#endif // DISABLE_NOTIFY
+
+#ifndef REDUCED_API
+qtipStatus_t qtip_is_full(qtipContext_t* pContext)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = (count_live_items(pContext) == pContext->maxItems) ? QTIP_STATUS_FULL : QTIP_STATUS_OK;
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_is_empty(qtipContext_t* pContext)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = (is_empty(pContext)) ? QTIP_STATUS_FULL : QTIP_STATUS_OK;
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_count_items(qtipContext_t* pContext, qtipSize_t* pResult)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        *pResult = count_live_items(pContext);
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_get_item_index(qtipContext_t* pContext, qtipSize_t index, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    status = CHECK_STATUS(status, (index < count_live_items(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+
+    if (status == QTIP_STATUS_OK)
+    {
+        read_item_relative(pContext, live_to_relative(pContext, index), pItem);
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_remove_item_index(qtipContext_t* pContext, qtipSize_t index)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    status = CHECK_STATUS(status, (index < count_live_items(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+
+    if (status == QTIP_STATUS_OK)
+    {
+        remove_item(pContext, live_to_relative(pContext, index));
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_get_pop_index(qtipContext_t* pContext, qtipSize_t index, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    status = CHECK_STATUS(status, (index < count_live_items(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const qtipSize_t relative = live_to_relative(pContext, index);
+
+        read_item_relative(pContext, relative, pItem);
+        remove_item(pContext, relative);
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_put_n(qtipContext_t* pContext, void* pItems, qtipSize_t n)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItems));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+#ifndef DISABLE_TOMBSTONE
+    if (status == QTIP_STATUS_OK)
+    {
+        reclaim_slots(pContext, n);
+    }
+#endif
+
+#ifndef DISABLE_GROW
+    if (status == QTIP_STATUS_OK)
+    {
+        make_room(pContext, n);
+    }
+#endif
+
+    status = CHECK_STATUS(status, (n <= count_free(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_FULL);
+
+    if ((status == QTIP_STATUS_OK) && (n > 0U))
+    {
+#ifndef DISABLE_LOCK
+        lock_queue(pContext);
+#endif
+
+        put_items(pContext, pItems, n);
+
+#ifndef DISABLE_LOCK
+        unlock_queue(pContext);
+#endif
+    }
+
+    return count_rejection(pContext, status);
+}
+
+qtipStatus_t qtip_pop_n(qtipContext_t* pContext, void* pItems, qtipSize_t n)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItems));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    status = CHECK_STATUS(status, (n <= count_live_items(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY);
+
+    if ((status == QTIP_STATUS_OK) && (n > 0U))
+    {
+#ifndef DISABLE_LOCK
+        lock_queue(pContext);
+#endif
+
+        pop_items(pContext, pItems, n);
+
+#ifndef DISABLE_LOCK
+        unlock_queue(pContext);
+#endif
+
+#ifndef DISABLE_GROW
+        shrink_if_idle(pContext);
+#endif
+    }
+
+    return count_rejection(pContext, status);
+}
+
+qtipStatus_t qtip_put_up_to_n(qtipContext_t* pContext, void* pItems, qtipSize_t n, qtipSize_t* pPut)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+    qtipSize_t qty      = 0U;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItems));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pPut));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+#ifndef DISABLE_TOMBSTONE
+        reclaim_slots(pContext, n);
+#endif
+#ifndef DISABLE_GROW
+        make_room(pContext, n);
+#endif
+
+        qty    = (n < count_free(pContext)) ? n : count_free(pContext);
+        status = ((qty > 0U) || (n == 0U)) ? QTIP_STATUS_OK : QTIP_STATUS_FULL;
+        *pPut  = qty;
+    }
+
+    if ((status == QTIP_STATUS_OK) && (qty > 0U))
+    {
+#ifndef DISABLE_LOCK
+        lock_queue(pContext);
+#endif
+
+        put_items(pContext, pItems, qty);
+
+#ifndef DISABLE_LOCK
+        unlock_queue(pContext);
+#endif
+    }
+
+    return count_rejection(pContext, status);
+}
+
+qtipStatus_t qtip_pop_up_to_n(qtipContext_t* pContext, void* pItems, qtipSize_t n, qtipSize_t* pPopped)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+    qtipSize_t qty      = 0U;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItems));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pPopped));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        qty      = (n < count_live_items(pContext)) ? n : count_live_items(pContext);
+        status   = ((qty > 0U) || (n == 0U)) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY;
+        *pPopped = qty;
+    }
+
+    if ((status == QTIP_STATUS_OK) && (qty > 0U))
+    {
+#ifndef DISABLE_LOCK
+        lock_queue(pContext);
+#endif
+
+        pop_items(pContext, pItems, qty);
+
+#ifndef DISABLE_LOCK
+        unlock_queue(pContext);
+#endif
+
+#ifndef DISABLE_GROW
+        shrink_if_idle(pContext);
+#endif
+    }
+
+    return count_rejection(pContext, status);
+}
+
+qtipStatus_t qtip_push_front(qtipContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+#ifndef DISABLE_TOMBSTONE
+    if (status == QTIP_STATUS_OK)
+    {
+        reclaim_slots(pContext, 1U);
+    }
+#endif
+
+#ifndef DISABLE_GROW
+    if (status == QTIP_STATUS_OK)
+    {
+        make_room(pContext, 1U);
+    }
+#endif
+
+    status = CHECK_STATUS(status, (!is_full(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_FULL);
+
+    if (status == QTIP_STATUS_OK)
+    {
+#ifndef DISABLE_LOCK
+        lock_queue(pContext);
+#endif
+
+        push_front_items(pContext, pItem, 1U);
+
+#ifndef DISABLE_LOCK
+        unlock_queue(pContext);
+#endif
+    }
+
+    return count_rejection(pContext, status);
+}
+
+qtipStatus_t qtip_pop_back(qtipContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    status = CHECK_STATUS(status, (!is_empty(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY);
+
+    if (status == QTIP_STATUS_OK)
+    {
+#ifndef DISABLE_LOCK
+        lock_queue(pContext);
+#endif
+
+        pop_back_items(pContext, pItem, 1U);
+
+#ifndef DISABLE_LOCK
+        unlock_queue(pContext);
+#endif
+
+#ifndef DISABLE_GROW
+        shrink_if_idle(pContext);
+#endif
+    }
+
+    return count_rejection(pContext, status);
+}
+
+qtipStatus_t qtip_push_front_n(qtipContext_t* pContext, void* pItems, qtipSize_t n)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItems));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+#ifndef DISABLE_TOMBSTONE
+    if (status == QTIP_STATUS_OK)
+    {
+        reclaim_slots(pContext, n);
+    }
+#endif
+
+#ifndef DISABLE_GROW
+    if (status == QTIP_STATUS_OK)
+    {
+        make_room(pContext, n);
+    }
+#endif
+
+    status = CHECK_STATUS(status, (n <= count_free(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_FULL);
+
+    if ((status == QTIP_STATUS_OK) && (n > 0U))
+    {
+#ifndef DISABLE_LOCK
+        lock_queue(pContext);
+#endif
+
+        push_front_items(pContext, pItems, n);
+
+#ifndef DISABLE_LOCK
+        unlock_queue(pContext);
+#endif
+    }
+
+    return count_rejection(pContext, status);
+}
+
+qtipStatus_t qtip_pop_back_n(qtipContext_t* pContext, void* pItems, qtipSize_t n)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItems));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    status = CHECK_STATUS(status, (n <= count_live_items(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY);
+
+    if ((status == QTIP_STATUS_OK) && (n > 0U))
+    {
+#ifndef DISABLE_LOCK
+        lock_queue(pContext);
+#endif
+
+        pop_back_items(pContext, pItems, n);
+
+#ifndef DISABLE_LOCK
+        unlock_queue(pContext);
+#endif
+
+#ifndef DISABLE_GROW
+        shrink_if_idle(pContext);
+#endif
+    }
+
+    return count_rejection(pContext, status);
+}
+
+qtipStatus_t qtip_reserve(qtipContext_t* pContext, void** ppItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(ppItem));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+#ifndef DISABLE_TOMBSTONE
+    if (status == QTIP_STATUS_OK)
+    {
+        reclaim_slots(pContext, 1U);
+    }
+#endif
+
+#ifndef DISABLE_GROW
+    if (status == QTIP_STATUS_OK)
+    {
+        make_room(pContext, 1U);
+    }
+#endif
+
+    status = CHECK_STATUS(status, (!is_full(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_FULL);
+
+    if (status == QTIP_STATUS_OK)
+    {
+        *ppItem            = absolute_index_to_address(pContext, tail_index_absolute(pContext));
+        pContext->reserved = true;
+    }
+
+    return count_rejection(pContext, status);
+}
+
+qtipStatus_t qtip_commit(qtipContext_t* pContext)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    status = CHECK_STATUS(status, pContext->reserved ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY);
+    status = CHECK_STATUS(status, (!is_full(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_FULL);
+
+    if (status == QTIP_STATUS_OK)
+    {
+        pContext->reserved = false;
+        stamp_items(pContext, tail_index_absolute(pContext), 1U);
+        advance_rear(pContext, 1U);
+        record_put(pContext);
+
+#ifndef DISABLE_TELEMETRY
+        pContext->total++;
+#endif
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_acquire(qtipContext_t* pContext, void** ppItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(ppItem));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    status = CHECK_STATUS(status, (!is_empty(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY);
 
-    for (i = index; i < pContext->qty - 2U; i++)
+    if (status == QTIP_STATUS_OK)
     {
-        const void* pNextItem = relative_index_to_address(pContext, i + 1U);
-        memcpy(pHead, pNextItem, pContext->itemSize);
-        pHead = (void*) pNextItem;
+        *ppItem = absolute_index_to_address(pContext, front_index_absolute(pContext));
     }
 
-    delete_item_relative(pContext, i + 1U);
+    return count_rejection(pContext, status);
 }
 
-/*
- * Public API
- */
-
-qtipStatus_t qtip_init(qtipContext_t* pContext, void* pBuffer, qtipSize_t maxItems, size_t itemSize)
+qtipStatus_t qtip_release(qtipContext_t* pContext)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
 
 #ifndef SKIP_ARG_CHECK
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
-    status = CHECK_STATUS(status, CHECK_NULL_PRT(pBuffer));
-    status = CHECK_STATUS(status, (maxItems > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
-    status = CHECK_STATUS(status, (itemSize > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
 #endif
 
 #ifndef DISABLE_LOCK
     status = CHECK_STATUS(status, IS_LOCKED(pContext));
 #endif
 
+    status = CHECK_STATUS(status, (!is_empty(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY);
+
     if (status == QTIP_STATUS_OK)
     {
-        pContext->itemSize = itemSize;
-        pContext->maxItems = maxItems;
-        pContext->start    = pBuffer;
-        pContext->front    = 0U;
-        pContext->rear     = 0U;
-        pContext->qty      = 0U;
-#ifndef DISABLE_LOCK
-        pContext->locked = false;
-#endif
+        // The caller already used the item in place, so it cannot be dropped
+        (void) time_front(pContext, 1U, false, NULL);
+        advance_front(pContext, 1U);
+
 #ifndef DISABLE_TELEMETRY
-        pContext->total     = 0U;
-        pContext->processed = 0U;
+        pContext->processed++;
 #endif
     }
 
     return status;
 }
 
-qtipStatus_t qtip_put(qtipContext_t* pContext, void* pItem)
+qtipStatus_t qtip_get_view(qtipContext_t* pContext, void** ppItems, qtipSize_t* pCount)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
 
 #ifndef SKIP_ARG_CHECK
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
-    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(ppItems));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pCount));
 #endif
 
 #ifndef DISABLE_LOCK
     status = CHECK_STATUS(status, IS_LOCKED(pContext));
 #endif
 
+    status = CHECK_STATUS(status, (!is_empty(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY);
+
     if (status == QTIP_STATUS_OK)
     {
-        if (!is_full(pContext))
+#ifndef DISABLE_TOMBSTONE
+        // A view is a run of contiguous items, so the removed slots must go first
+        if (has_tombstones(pContext))
         {
-#ifndef DISABLE_LOCK
-            lock_queue(pContext);
+            compact_items(pContext);
+        }
 #endif
-            pContext->rear = move_index(pContext, pContext->rear);
 
-            write_item_absolute(pContext, pContext->rear, pItem);
-            pContext->qty++;
-
-#ifndef DISABLE_TELEMETRY
-            pContext->total++;
-#endif
+        const qtipSize_t front = front_index_absolute(pContext);
 
-#ifndef DISABLE_LOCK
-            unlock_queue(pContext);
-#endif
-        }
-        else
-        {
-            status = QTIP_STATUS_FULL;
-        }
+        *ppItems = absolute_index_to_address(pContext, front);
+        *pCount  = count_until_end(pContext, front, count_items(pContext));
     }
 
     return status;
 }
 
-qtipStatus_t qtip_pop(qtipContext_t* pContext, void* pItem)
+qtipStatus_t qtip_release_n(qtipContext_t* pContext, qtipSize_t n)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
 
 #ifndef SKIP_ARG_CHECK
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
-    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
 #endif
 
 #ifndef DISABLE_LOCK
     status = CHECK_STATUS(status, IS_LOCKED(pContext));
 #endif
 
-    if (status == QTIP_STATUS_OK)
-    {
-        if (!is_empty(pContext))
-        {
-#ifndef DISABLE_LOCK
-            lock_queue(pContext);
-#endif
-            read_item_absolute(pContext, pContext->front, pItem);
-            delete_item_absolute(pContext, pContext->front);
-            pContext->qty--;
+    status = CHECK_STATUS(status, (n <= count_live_items(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY);
 
-            pContext->front = move_index(pContext, pContext->front);
+    if ((status == QTIP_STATUS_OK) && (n > 0U))
+    {
+        drop_items(pContext, n);
 
 #ifndef DISABLE_TELEMETRY
-            pContext->processed++;
-#endif
-
-#ifndef DISABLE_LOCK
-            unlock_queue(pContext);
+        pContext->processed += n;
 #endif
-        }
-        else
-        {
-            status = QTIP_STATUS_EMPTY;
-        }
     }
 
     return status;
 }
 
-qtipStatus_t qtip_peek(qtipContext_t* pContext, void* pBuffer, qtipSize_t* pSize)
+qtipStatus_t qtip_remove_if(qtipContext_t* pContext, qtipPredicate_t predicate, void* pArg, qtipSize_t* pRemoved)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
 
 #ifndef SKIP_ARG_CHECK
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
-    status = CHECK_STATUS(status, CHECK_NULL_PRT(pBuffer));
-    status = CHECK_STATUS(status, CHECK_NULL_PRT(pSize));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(predicate));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pRemoved));
 #endif
 
 #ifndef DISABLE_LOCK
@@ -299,11 +2104,8 @@ qtipStatus_t qtip_peek(qtipContext_t* pContext, void* pBuffer, qtipSize_t* pSize
 #ifndef DISABLE_LOCK
         lock_queue(pContext);
 #endif
-        *pSize = count_items(pContext);
-        for (qtipSize_t i = 0U; i < pContext->qty; i++)
-        {
-            read_item_relative(pContext, i, pBuffer + i * pContext->itemSize);
-        }
+
+        status = filter_items(pContext, predicate, pArg, NULL, pRemoved);
 
 #ifndef DISABLE_LOCK
         unlock_queue(pContext);
@@ -313,30 +2115,47 @@ qtipStatus_t qtip_peek(qtipContext_t* pContext, void* pBuffer, qtipSize_t* pSize
     return status;
 }
 
-qtipStatus_t qtip_purge(qtipContext_t* pContext)
+qtipStatus_t qtip_extract_if(qtipContext_t* pContext,
+                             qtipContext_t* pTarget,
+                             qtipPredicate_t predicate,
+                             void* pArg,
+                             qtipSize_t* pMoved)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
 
 #ifndef SKIP_ARG_CHECK
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pTarget));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(predicate));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pMoved));
+    status = CHECK_STATUS(status, (pTarget != pContext) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status,
+                          (pTarget->itemSize == pContext->itemSize) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
 #endif
 
 #ifndef DISABLE_LOCK
     status = CHECK_STATUS(status, IS_LOCKED(pContext));
+    status = CHECK_STATUS(status, IS_LOCKED(pTarget));
 #endif
 
     if (status == QTIP_STATUS_OK)
     {
 #ifndef DISABLE_LOCK
         lock_queue(pContext);
+        lock_queue(pTarget);
 #endif
 
-        reset_queue(pContext);
-        pContext->qty   = 0U;
-        pContext->front = move_index(pContext, pContext->front);
-        pContext->rear  = move_index(pContext, pContext->rear);
+#ifndef DISABLE_TOMBSTONE
+        if (has_tombstones(pTarget))
+        {
+            compact_items(pTarget);
+        }
+#endif
+
+        status = filter_items(pContext, predicate, pArg, pTarget, pMoved);
 
 #ifndef DISABLE_LOCK
+        unlock_queue(pTarget);
         unlock_queue(pContext);
 #endif
     }
@@ -344,13 +2163,29 @@ qtipStatus_t qtip_purge(qtipContext_t* pContext)
     return status;
 }
 
-qtipStatus_t qtip_get_rear(qtipContext_t* pContext, void* pItem)
+#ifndef DISABLE_GROW
+
+qtipStatus_t qtip_init_growable(qtipContext_t* pContext,
+                                const qtipAllocator_t* pAllocator,
+                                qtipSize_t initialItems,
+                                qtipSize_t capItems,
+                                size_t itemSize,
+                                qtipSize_t shrinkAfter)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
+    void* pBuffer       = NULL;
 
 #ifndef SKIP_ARG_CHECK
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
-    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pAllocator));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pAllocator->alloc));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pAllocator->free));
+    status = CHECK_STATUS(status, (initialItems > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status, (itemSize > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status, (capItems >= initialItems) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+#ifdef POWER_OF_TWO
+    status = CHECK_STATUS(status, ((capItems & (capItems - 1U)) == 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+#endif
 #endif
 
 #ifndef DISABLE_LOCK
@@ -359,66 +2194,94 @@ qtipStatus_t qtip_get_rear(qtipContext_t* pContext, void* pItem)
 
     if (status == QTIP_STATUS_OK)
     {
-        if (!is_empty(pContext))
-        {
-#ifndef DISABLE_LOCK
-            lock_queue(pContext);
-#endif
+        pBuffer = pAllocator->alloc(initialItems * itemSize, pAllocator->pArg);
+        status  = (pBuffer != NULL) ? QTIP_STATUS_OK : QTIP_STATUS_SYSTEM_ERROR;
+    }
 
-            read_item_absolute(pContext, pContext->rear, pItem);
+    if (status == QTIP_STATUS_OK)
+    {
+        memset(pBuffer, 0U, initialItems * itemSize);
+        status = qtip_init(pContext, pBuffer, initialItems, itemSize);
 
-#ifndef DISABLE_LOCK
-            unlock_queue(pContext);
-#endif
+        if (status == QTIP_STATUS_OK)
+        {
+            pContext->pAllocator  = pAllocator;
+            pContext->capItems    = capItems;
+            pContext->shrinkAfter = shrinkAfter;
         }
         else
         {
-            status = QTIP_STATUS_EMPTY;
+            pAllocator->free(pBuffer, pAllocator->pArg);
         }
     }
 
     return status;
 }
 
-qtipStatus_t qtip_get_front(qtipContext_t* pContext, void* pItem)
+qtipStatus_t qtip_free_growable(qtipContext_t* pContext)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
 
 #ifndef SKIP_ARG_CHECK
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
-    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
 #endif
 
 #ifndef DISABLE_LOCK
     status = CHECK_STATUS(status, IS_LOCKED(pContext));
 #endif
 
+    status = CHECK_STATUS(status, is_growable(pContext) ? QTIP_STATUS_OK : QTIP_STATUS_NULL_PTR);
+
     if (status == QTIP_STATUS_OK)
     {
-        if (!is_empty(pContext))
-        {
-#ifndef DISABLE_LOCK
-            lock_queue(pContext);
-#endif
+        pContext->pAllocator->free(pContext->start, pContext->pAllocator->pArg);
+        pContext->pAllocator = NULL;
+        pContext->start      = NULL;
+        reset_indexes(pContext);
+    }
+
+    return status;
+}
 
-            read_item_absolute(pContext, pContext->front, pItem);
+#endif // DISABLE_GROW
+
+#ifndef DISABLE_TOMBSTONE
+
+qtipStatus_t qtip_enable_tombstones(qtipContext_t* pContext, uint8_t* pBitmap, uint32_t compactPercent)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pBitmap));
+    status = CHECK_STATUS(status, (compactPercent <= 100U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+#endif
 
 #ifndef DISABLE_LOCK
-            unlock_queue(pContext);
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
 #endif
-        }
-        else
+
+#ifndef DISABLE_GROW
+    // A growable queue moves its items to a new buffer, which the bitmap cannot follow
+    status = CHECK_STATUS(status, !is_growable(pContext) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        if (has_tombstones(pContext))
         {
-            status = QTIP_STATUS_EMPTY;
+            compact_items(pContext);
         }
+
+        memset(pBitmap, 0U, QTIP_TOMBSTONE_BITMAP_SIZE(pContext->maxItems));
+        pContext->pTombstones    = pBitmap;
+        pContext->compactPercent = compactPercent;
     }
 
     return status;
 }
 
-#ifndef DISABLE_LOCK
-
-qtipStatus_t qtip_is_locked(qtipContext_t* pContext)
+qtipStatus_t qtip_compact(qtipContext_t* pContext)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
 
@@ -426,15 +2289,31 @@ qtipStatus_t qtip_is_locked(qtipContext_t* pContext)
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
 #endif
 
-    if (status == QTIP_STATUS_OK)
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    if ((status == QTIP_STATUS_OK) && has_tombstones(pContext))
     {
-        status = IS_LOCKED(pContext);
+#ifndef DISABLE_LOCK
+        lock_queue(pContext);
+#endif
+
+        compact_items(pContext);
+
+#ifndef DISABLE_LOCK
+        unlock_queue(pContext);
+#endif
     }
 
     return status;
 }
 
-qtipStatus_t qtip_lock(qtipContext_t* pContext)
+#endif // DISABLE_TOMBSTONE
+
+#ifndef DISABLE_OVERWRITE
+
+qtipStatus_t qtip_set_overwrite(qtipContext_t* pContext, bool enabled)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
 
@@ -442,154 +2321,231 @@ qtipStatus_t qtip_lock(qtipContext_t* pContext)
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
 #endif
 
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
     if (status == QTIP_STATUS_OK)
     {
-        lock_queue(pContext);
+        pContext->overwrite = enabled;
     }
 
     return status;
 }
 
-qtipStatus_t qtip_unlock(qtipContext_t* pContext)
+qtipStatus_t qtip_total_overwritten_items(qtipContext_t* pContext, size_t* pResult)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
 
 #ifndef SKIP_ARG_CHECK
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
 #endif
 
     if (status == QTIP_STATUS_OK)
     {
-        unlock_queue(pContext);
+        *pResult = pContext->overwritten;
     }
 
     return status;
 }
 
-#endif // DISABLE_LOCK
+#endif // DISABLE_OVERWRITE
 
-#ifndef REDUCED_API
-qtipStatus_t qtip_is_full(qtipContext_t* pContext)
+#ifndef DISABLE_SOJOURN
+
+qtipStatus_t qtip_enable_sojourn(qtipContext_t* pContext,
+                                 qtipSojourn_t* pSojourn,
+                                 uint64_t* pTimestamps,
+                                 qtipClock_t clock,
+                                 void* pClockArg)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
 
 #ifndef SKIP_ARG_CHECK
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pSojourn));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pTimestamps));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(clock));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+#ifndef DISABLE_GROW
+    // A growable queue moves its items to a new buffer, which the timestamps cannot follow
+    status = CHECK_STATUS(status, !is_growable(pContext) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
 #endif
 
     if (status == QTIP_STATUS_OK)
     {
-        status = (is_full(pContext)) ? QTIP_STATUS_FULL : QTIP_STATUS_OK;
+        memset(pSojourn, 0, sizeof(*pSojourn));
+        pSojourn->pTimestamps = pTimestamps;
+        pSojourn->clock       = clock;
+        pSojourn->pClockArg   = pClockArg;
+        pContext->pSojourn    = pSojourn;
+        stamp_items(pContext, front_index_absolute(pContext), count_items(pContext));
     }
 
     return status;
 }
 
-qtipStatus_t qtip_is_empty(qtipContext_t* pContext)
+qtipStatus_t qtip_pop_timed(qtipContext_t* pContext, void* pItem, uint64_t* pSojourn, bool* pLate)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
 
 #ifndef SKIP_ARG_CHECK
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pSojourn));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pLate));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
 #endif
 
+    status = CHECK_STATUS(status, (!is_empty(pContext)) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY);
+
     if (status == QTIP_STATUS_OK)
     {
-        status = (is_empty(pContext)) ? QTIP_STATUS_FULL : QTIP_STATUS_OK;
+#ifndef DISABLE_LOCK
+        lock_queue(pContext);
+#endif
+
+        *pLate = time_front(pContext, 1U, true, pSojourn);
+        read_item_absolute(pContext, front_index_absolute(pContext), pItem);
+        delete_item_absolute(pContext, front_index_absolute(pContext));
+        advance_front(pContext, 1U);
+
+#ifndef DISABLE_TELEMETRY
+        pContext->processed++;
+#endif
+
+#ifndef DISABLE_LOCK
+        unlock_queue(pContext);
+#endif
+
+#ifndef DISABLE_GROW
+        shrink_if_idle(pContext);
+#endif
     }
 
-    return status;
+    return count_rejection(pContext, status);
 }
 
-qtipStatus_t qtip_count_items(qtipContext_t* pContext, qtipSize_t* pResult)
+qtipStatus_t qtip_get_sojourn_percentile(qtipContext_t* pContext, uint32_t percent, uint64_t* pResult)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
+    size_t total        = 0U;
 
 #ifndef SKIP_ARG_CHECK
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
+    status = CHECK_STATUS(status, (percent <= 100U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
 #endif
 
+    if ((status == QTIP_STATUS_OK) && (pContext->pSojourn != NULL))
+    {
+        for (size_t i = 0U; i < SOJOURN_BUCKETS; i++)
+        {
+            total += pContext->pSojourn->histogram[i];
+        }
+    }
+
+    if (status == QTIP_STATUS_OK)
+    {
+
+        status = (total > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY;
+    }
+
     if (status == QTIP_STATUS_OK)
     {
-        *pResult = count_items(pContext);
+        // Rank of the sample at the percentile, rounded up so that any percentile selects a sample
+        const size_t rank = ((total * percent) + 99U) / 100U;
+        size_t seen       = pContext->pSojourn->histogram[0U];
+        size_t bucket     = 0U;
+
+        while ((seen < rank) || (seen == 0U))
+        {
+            bucket++;
+            seen += pContext->pSojourn->histogram[bucket];
+        }
+
+        *pResult = (bucket < (SOJOURN_BUCKETS - 1U)) ? (((uint64_t) 2U << bucket) - 1U) : UINT64_MAX;
     }
 
     return status;
 }
 
-qtipStatus_t qtip_get_item_index(qtipContext_t* pContext, qtipSize_t index, void* pItem)
+qtipStatus_t qtip_reset_sojourns(qtipContext_t* pContext)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
 
 #ifndef SKIP_ARG_CHECK
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
-    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
-#endif
-
-#ifndef DISABLE_LOCK
-    status = CHECK_STATUS(status, IS_LOCKED(pContext));
 #endif
 
-    status = CHECK_STATUS(status, (index <= pContext->qty) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
-
-    if (status == QTIP_STATUS_OK)
+    if ((status == QTIP_STATUS_OK) && (pContext->pSojourn != NULL))
     {
-        read_item_relative(pContext, index, pItem);
+        memset(pContext->pSojourn->histogram, 0, sizeof(pContext->pSojourn->histogram));
     }
 
     return status;
 }
 
-qtipStatus_t qtip_remove_item_index(qtipContext_t* pContext, qtipSize_t index)
+qtipStatus_t qtip_set_codel(qtipContext_t* pContext, uint64_t target, uint64_t interval, bool drop)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
 
 #ifndef SKIP_ARG_CHECK
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, ((target == 0U) || (interval > 0U)) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
 #endif
 
 #ifndef DISABLE_LOCK
     status = CHECK_STATUS(status, IS_LOCKED(pContext));
 #endif
 
-    status = CHECK_STATUS(status, (index <= pContext->qty) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status, (pContext->pSojourn != NULL) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
 
     if (status == QTIP_STATUS_OK)
     {
-        delete_item_relative(pContext, index);
-        sweep_items(pContext, index);
-        pContext->qty--;
+        qtipCodel_t* pCodel = &pContext->pSojourn->codel;
+
+        pCodel->target     = target;
+        pCodel->interval   = interval;
+        pCodel->drop       = drop;
+        pCodel->firstAbove = 0U;
+        pCodel->dropNext   = 0U;
+        pCodel->count      = 0U;
+        pCodel->lastCount  = 0U;
+        pCodel->dropping   = false;
     }
 
     return status;
 }
 
-qtipStatus_t qtip_get_pop_index(qtipContext_t* pContext, qtipSize_t index, void* pItem)
+qtipStatus_t qtip_total_late_items(qtipContext_t* pContext, size_t* pResult)
 {
     qtipStatus_t status = QTIP_STATUS_OK;
 
 #ifndef SKIP_ARG_CHECK
     status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
-    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
-#endif
-
-#ifndef DISABLE_LOCK
-    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
 #endif
 
-    status = CHECK_STATUS(status, (index <= pContext->qty) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
-
     if (status == QTIP_STATUS_OK)
     {
-        read_item_relative(pContext, index, pItem);
-        delete_item_relative(pContext, index);
-        sweep_items(pContext, index);
-        pContext->qty--;
+        *pResult = (pContext->pSojourn != NULL) ? pContext->pSojourn->codel.late : 0U;
     }
 
     return status;
 }
 
+#endif // DISABLE_SOJOURN
+
 #endif // REDUCED_API
 
 #ifndef DISABLE_TELEMETRY
@@ -628,4 +2584,58 @@ qtipStatus_t qtip_total_processed_items(qtipContext_t* pContext, size_t* pResult
     return status;
 }
 
-#endif // DISABLE_TELEMETRY
\ No newline at end of file
+#if !defined(DISABLE_STATS) && !defined(REDUCED_API)
+
+qtipStatus_t qtip_enable_stats(qtipContext_t* pContext, qtipStats_t* pStats)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pStats));
+#endif
+
+#ifndef DISABLE_LOCK
+    status = CHECK_STATUS(status, IS_LOCKED(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        memset(pStats, 0, sizeof(*pStats));
+        pContext->pStats = pStats;
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_get_stats(qtipContext_t* pContext, qtipStats_t* pStats, bool reset)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pStats));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        if (pContext->pStats != NULL)
+        {
+            *pStats = *pContext->pStats;
+            if (reset)
+            {
+                memset(pContext->pStats, 0, sizeof(*pContext->pStats));
+            }
+        }
+        else
+        {
+            memset(pStats, 0, sizeof(*pStats));
+        }
+    }
+
+    return status;
+}
+
+#endif // DISABLE_STATS && REDUCED_API
+
+#endif // DISABLE_TELEMETRY
@@ -0,0 +1,43 @@
+/**
+ * @file qtip_eventfd.c
+ * @brief eventfd readiness notification for queues
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#include "qtip_eventfd.h"
+#include "qtip_private.h"
+
+#if defined(__linux__) && !defined(DISABLE_NOTIFY)
+
+#include <stdint.h>
+#include <unistd.h>
+
+/*
+ * Private functions
+ */
+
+static void signal_eventfd(void* pArg)
+{
+    const uint64_t increment = 1U;
+
+    // A full counter already makes the descriptor readable, so a failed write loses nothing
+    (void) write((int) (intptr_t) pArg, &increment, sizeof(increment));
+}
+
+/*
+ * Library API
+ */
+
+qtipStatus_t qtip_eventfd_attach(qtipContext_t* pContext, int fd, qtipSize_t threshold)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, (fd >= 0) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+#endif
+
+    return CHECK_STATUS(status, qtip_set_notifier(pContext, signal_eventfd, (void*) (intptr_t) fd, threshold));
+}
+
+#endif // __linux__ && DISABLE_NOTIFY
@@ -0,0 +1,420 @@
+/**
+ * @file qtip_file.c
+ * @brief API for queues persisted in a memory-mapped file
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "qtip_file.h"
+#include "qtip_fast.h"
+#include "qtip_private.h"
+
+#if !defined(DISABLE_FILE) && !defined(REDUCED_API)
+
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Private defines
+ */
+
+#define FILE_MODE         0600
+#define FLAG_POWER_OF_TWO 0x1U
+#define FNV_OFFSET_BASIS  0xcbf29ce484222325U
+#define FNV_PRIME         0x100000001b3U
+#define NS_PER_MS         1000000U
+#define NS_PER_S          1000000000U
+
+#ifdef POWER_OF_TWO
+#define FILE_FLAGS FLAG_POWER_OF_TWO
+#else
+#define FILE_FLAGS 0U
+#endif
+
+/*
+ * Private functions
+ */
+
+static uint64_t now_ns(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return ((uint64_t) time.tv_sec * NS_PER_S) + (uint64_t) time.tv_nsec;
+}
+
+static uint64_t state_checksum(const qtipFileState_t* pState)
+{
+    const uint8_t* pBytes = (const uint8_t*) pState;
+    uint64_t hash         = FNV_OFFSET_BASIS;
+
+    for (size_t i = 0U; i < offsetof(qtipFileState_t, checksum); i++)
+    {
+        hash = (hash ^ pBytes[i]) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+static inline bool is_valid_state(const qtipFileHeader_t* pHeader, const qtipFileState_t* pState)
+{
+    bool valid = (pState->checksum == state_checksum(pState)) && (pState->count <= pHeader->maxItems);
+
+#ifdef POWER_OF_TWO
+    valid = valid && ((qtipSize_t) (pState->rear - pState->front) == pState->count);
+#else
+    valid = valid && (pState->front < pHeader->maxItems) && (pState->rear < pHeader->maxItems);
+#endif
+
+    return valid;
+}
+
+static const qtipFileState_t* newest_state(const qtipFileHeader_t* pHeader)
+{
+    const qtipFileState_t* pNewest = NULL;
+
+    for (size_t i = 0U; i < 2U; i++)
+    {
+        const qtipFileState_t* pState = &pHeader->states[i];
+
+        if (is_valid_state(pHeader, pState) && ((pNewest == NULL) || (pState->sequence > pNewest->sequence)))
+        {
+            pNewest = pState;
+        }
+    }
+
+    return pNewest;
+}
+
+static void write_state(qtipFileContext_t* pContext)
+{
+    const uint64_t sequence = pContext->sequence + 1U;
+    qtipFileState_t* pState = &pContext->pHeader->states[sequence % 2U];
+
+    pState->sequence = sequence;
+    pState->front    = pContext->queue.front;
+    pState->rear     = pContext->queue.rear;
+    pState->count    = qtip_fast_count_items(&pContext->queue);
+#ifndef DISABLE_TELEMETRY
+    pState->total     = pContext->queue.total;
+    pState->processed = pContext->queue.processed;
+#else
+    pState->total     = 0U;
+    pState->processed = 0U;
+#endif
+    pState->checksum   = state_checksum(pState);
+    pContext->sequence = sequence;
+}
+
+static qtipStatus_t flush(qtipFileContext_t* pContext)
+{
+    const size_t itemsOffset = (size_t) pContext->pHeader->itemsOffset;
+    qtipStatus_t status      = QTIP_STATUS_OK;
+
+    // The kernel may write the header back at any time, so the state only reaches it once its items are on the disk
+    if (msync((void*) pContext->pHeader + itemsOffset, pContext->mapSize - itemsOffset, MS_SYNC) != 0)
+    {
+        status = QTIP_STATUS_SYSTEM_ERROR;
+    }
+
+    if ((status == QTIP_STATUS_OK) && (pContext->pending > 0U))
+    {
+        write_state(pContext);
+    }
+
+    if ((status == QTIP_STATUS_OK) && (msync(pContext->pHeader, itemsOffset, MS_SYNC) != 0))
+    {
+        status = QTIP_STATUS_SYSTEM_ERROR;
+    }
+
+    pContext->pending    = 0U;
+    pContext->lastSyncNs = now_ns();
+
+    return status;
+}
+
+static qtipStatus_t persist_state(qtipFileContext_t* pContext)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+    pContext->pending++;
+
+    if (((pContext->syncEvery > 0U) && (pContext->pending >= pContext->syncEvery)) ||
+        ((pContext->syncIntervalMs > 0U) &&
+         ((now_ns() - pContext->lastSyncNs) >= ((uint64_t) pContext->syncIntervalMs * NS_PER_MS))))
+    {
+        status = flush(pContext);
+    }
+
+    return status;
+}
+
+static bool is_persisted_slot(qtipFileContext_t* pContext, qtipSize_t index)
+{
+    const qtipFileState_t* pState = &pContext->pHeader->states[pContext->sequence % 2U];
+    const qtipSize_t maxItems     = pContext->queue.maxItems;
+#ifdef POWER_OF_TWO
+    const qtipSize_t front = (qtipSize_t) pState->front & (maxItems - 1U);
+#else
+    const qtipSize_t front = (qtipSize_t) pState->front;
+#endif
+    const qtipSize_t distance = (index >= front) ? (index - front) : (index + (maxItems - front));
+
+    return distance < pState->count;
+}
+
+static void format_header(qtipFileHeader_t* pHeader, qtipSize_t maxItems, size_t itemSize, size_t itemsOffset)
+{
+    memset(pHeader, 0, sizeof(*pHeader));
+    pHeader->version     = QTIP_FILE_VERSION;
+    pHeader->flags       = FILE_FLAGS;
+    pHeader->maxItems    = maxItems;
+    pHeader->itemSize    = itemSize;
+    pHeader->itemsOffset = itemsOffset;
+    for (size_t i = 0U; i < 2U; i++)
+    {
+        pHeader->states[i].checksum = state_checksum(&pHeader->states[i]);
+    }
+
+    // The magic goes last, so a file that was not fully formatted is formatted again
+    atomic_thread_fence(memory_order_release);
+    pHeader->magic = QTIP_FILE_MAGIC;
+}
+
+static bool matches_header(const qtipFileHeader_t* pHeader, qtipSize_t maxItems, size_t itemSize, size_t mapSize)
+{
+    return (pHeader->version == QTIP_FILE_VERSION) && (pHeader->flags == FILE_FLAGS) &&
+           (pHeader->maxItems == maxItems) && (pHeader->itemSize == itemSize) &&
+           (pHeader->itemsOffset >= sizeof(qtipFileHeader_t)) && (pHeader->itemsOffset < mapSize) &&
+           ((mapSize - pHeader->itemsOffset) / itemSize >= maxItems);
+}
+
+static qtipStatus_t restore_queue(qtipFileContext_t* pContext, qtipSize_t maxItems, size_t itemSize)
+{
+    qtipFileHeader_t* pHeader     = pContext->pHeader;
+    const qtipFileState_t* pState = newest_state(pHeader);
+    qtipStatus_t status           = (pState != NULL) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE;
+
+    status = CHECK_STATUS(status,
+                          qtip_init(&pContext->queue, (void*) pHeader + pHeader->itemsOffset, maxItems, itemSize));
+
+    if (status == QTIP_STATUS_OK)
+    {
+        pContext->queue.front = (qtipSize_t) pState->front;
+        pContext->queue.rear  = (qtipSize_t) pState->rear;
+#ifndef POWER_OF_TWO
+        pContext->queue.qty = (qtipSize_t) pState->count;
+#endif
+#ifndef DISABLE_TELEMETRY
+        pContext->queue.total     = (size_t) pState->total;
+        pContext->queue.processed = (size_t) pState->processed;
+#endif
+        pContext->sequence = pState->sequence;
+    }
+
+    return status;
+}
+
+static qtipStatus_t map_file(qtipFileContext_t* pContext, qtipSize_t maxItems, size_t itemSize)
+{
+    const size_t pageSize    = (size_t) sysconf(_SC_PAGESIZE);
+    const size_t itemsOffset = ((sizeof(qtipFileHeader_t) + pageSize - 1U) / pageSize) * pageSize;
+    const size_t fileSize    = itemsOffset + (size_t) maxItems * itemSize;
+    qtipStatus_t status      = QTIP_STATUS_OK;
+    struct stat info;
+    bool isNew = false;
+
+    if (fstat(pContext->fd, &info) == 0)
+    {
+        isNew             = info.st_size == 0;
+        pContext->mapSize = isNew ? fileSize : (size_t) info.st_size;
+    }
+    else
+    {
+        status = QTIP_STATUS_SYSTEM_ERROR;
+    }
+
+    status = CHECK_STATUS(status,
+                          (pContext->mapSize >= sizeof(qtipFileHeader_t)) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    if (isNew && (status == QTIP_STATUS_OK) && (ftruncate(pContext->fd, (off_t) fileSize) != 0))
+    {
+        status = QTIP_STATUS_SYSTEM_ERROR;
+    }
+
+    if (status == QTIP_STATUS_OK)
+    {
+        void* pMemory = mmap(NULL, pContext->mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, pContext->fd, 0);
+        pContext->pHeader = (pMemory != MAP_FAILED) ? pMemory : NULL;
+        status            = (pContext->pHeader != NULL) ? QTIP_STATUS_OK : QTIP_STATUS_SYSTEM_ERROR;
+    }
+
+    // Only a file left behind by a creation that did not finish is formatted again
+    if ((status == QTIP_STATUS_OK) && (pContext->pHeader->magic == 0U) && (pContext->mapSize == fileSize))
+    {
+        format_header(pContext->pHeader, maxItems, itemSize, itemsOffset);
+        status = flush(pContext);
+    }
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = ((pContext->pHeader->magic == QTIP_FILE_MAGIC) &&
+                  matches_header(pContext->pHeader, maxItems, itemSize, pContext->mapSize))
+                     ? QTIP_STATUS_OK
+                     : QTIP_STATUS_INVALID_SIZE;
+    }
+
+    return status;
+}
+
+static void release_file(qtipFileContext_t* pContext)
+{
+    if (pContext->pHeader != NULL)
+    {
+        (void) munmap(pContext->pHeader, pContext->mapSize);
+    }
+    if (pContext->fd >= 0)
+    {
+        (void) close(pContext->fd);
+    }
+    memset(pContext, 0, sizeof(*pContext));
+    pContext->fd = -1;
+}
+
+/*
+ * Public API
+ */
+
+qtipStatus_t qtip_file_open(qtipFileContext_t* pContext,
+                            const char* path,
+                            qtipSize_t maxItems,
+                            size_t itemSize,
+                            uint32_t syncEvery,
+                            uint32_t syncIntervalMs)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(path));
+    status = CHECK_STATUS(status, (maxItems > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status, (itemSize > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status,
+                          (maxItems <= (((size_t) -1 - sizeof(qtipFileHeader_t)) / 2U / itemSize))
+                              ? QTIP_STATUS_OK
+                              : QTIP_STATUS_INVALID_SIZE);
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        memset(pContext, 0, sizeof(*pContext));
+        pContext->syncEvery      = syncEvery;
+        pContext->syncIntervalMs = syncIntervalMs;
+        pContext->lastSyncNs     = now_ns();
+        pContext->fd             = open(path, O_RDWR | O_CREAT, FILE_MODE);
+
+        status = (pContext->fd >= 0) ? QTIP_STATUS_OK : QTIP_STATUS_SYSTEM_ERROR;
+        status = CHECK_STATUS(status, map_file(pContext, maxItems, itemSize));
+        status = CHECK_STATUS(status, restore_queue(pContext, maxItems, itemSize));
+
+        if (status != QTIP_STATUS_OK)
+        {
+            release_file(pContext);
+        }
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_file_put(qtipFileContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+    // A slot popped since the last flush still holds an item of the state on the disk, so it is flushed before reuse
+    if ((status == QTIP_STATUS_OK) && !qtip_fast_is_full(&pContext->queue) &&
+        is_persisted_slot(pContext, qtip_fast_tail_index(&pContext->queue)))
+    {
+        status = flush(pContext);
+    }
+
+    status = CHECK_STATUS(status, qtip_put(&pContext->queue, pItem));
+    if (status == QTIP_STATUS_OK)
+    {
+        status = persist_state(pContext);
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_file_pop(qtipFileContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+    void* pSlot         = NULL;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    // The slot is released without clearing it, since the state on the disk may still cover it
+    status = CHECK_STATUS(status, qtip_acquire(&pContext->queue, &pSlot));
+    if (status == QTIP_STATUS_OK)
+    {
+        memcpy(pItem, pSlot, pContext->queue.itemSize);
+        status = CHECK_STATUS(status, qtip_release(&pContext->queue));
+        status = CHECK_STATUS(status, persist_state(pContext));
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_file_sync(qtipFileContext_t* pContext)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext->pHeader));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = flush(pContext);
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_file_close(qtipFileContext_t* pContext)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext->pHeader));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = flush(pContext);
+        if (munmap(pContext->pHeader, pContext->mapSize) != 0)
+        {
+            status = QTIP_STATUS_SYSTEM_ERROR;
+        }
+        pContext->pHeader = NULL;
+        release_file(pContext);
+    }
+
+    return status;
+}
+
+#endif // DISABLE_FILE && REDUCED_API
@@ -0,0 +1,120 @@
+/**
+ * @file qtip_mirror.c
+ * @brief API for queues on a buffer mapped twice back-to-back
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#define _GNU_SOURCE
+
+#include "qtip_mirror.h"
+#include "qtip_private.h"
+
+#if defined(__linux__) && !defined(DISABLE_MIRROR) && !defined(REDUCED_API)
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*
+ * Private functions
+ */
+
+static qtipStatus_t map_mirror(void** ppBuffer, size_t size)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+    const int fd        = memfd_create("qtip", MFD_CLOEXEC);
+    void* pBuffer       = MAP_FAILED;
+
+    status = CHECK_STATUS(status, (fd >= 0) ? QTIP_STATUS_OK : QTIP_STATUS_SYSTEM_ERROR);
+    status = CHECK_STATUS(status, (ftruncate(fd, (off_t) size) == 0) ? QTIP_STATUS_OK : QTIP_STATUS_SYSTEM_ERROR);
+
+    if (status == QTIP_STATUS_OK)
+    {
+        // Reserve both halves at once so nothing else can be mapped between them
+        pBuffer = mmap(NULL, size * 2U, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        status  = (pBuffer != MAP_FAILED) ? QTIP_STATUS_OK : QTIP_STATUS_SYSTEM_ERROR;
+    }
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const int prot  = PROT_READ | PROT_WRITE;
+        const int flags = MAP_SHARED | MAP_FIXED;
+
+        if ((mmap(pBuffer, size, prot, flags, fd, 0) == MAP_FAILED) ||
+            (mmap(pBuffer + size, size, prot, flags, fd, 0) == MAP_FAILED))
+        {
+            status = QTIP_STATUS_SYSTEM_ERROR;
+            (void) munmap(pBuffer, size * 2U);
+        }
+    }
+
+    if (fd >= 0)
+    {
+        // The mappings keep the memory alive
+        close(fd);
+    }
+
+    *ppBuffer = pBuffer;
+    return status;
+}
+
+/*
+ * Library API
+ */
+
+qtipStatus_t qtip_mirror_init(qtipContext_t* pContext, qtipSize_t maxItems, size_t itemSize)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+    const size_t size   = (size_t) maxItems * itemSize;
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    void* pBuffer       = NULL;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+    status = CHECK_STATUS(status, (pageSize > 0) ? QTIP_STATUS_OK : QTIP_STATUS_SYSTEM_ERROR);
+    status = CHECK_STATUS(status,
+                          ((size > 0U) && ((size % (size_t) pageSize) == 0U)) ? QTIP_STATUS_OK
+                                                                              : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status, map_mirror(&pBuffer, size));
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = qtip_init(pContext, pBuffer, maxItems, itemSize);
+        if (status == QTIP_STATUS_OK)
+        {
+            pContext->mirrored = true;
+        }
+        else
+        {
+            (void) munmap(pBuffer, size * 2U);
+        }
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_mirror_free(qtipContext_t* pContext)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+    status = CHECK_STATUS(status, pContext->mirrored ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const size_t size = (size_t) pContext->maxItems * pContext->itemSize;
+
+        status = (munmap(pContext->start, size * 2U) == 0) ? QTIP_STATUS_OK : QTIP_STATUS_SYSTEM_ERROR;
+        pContext->start    = NULL;
+        pContext->mirrored = false;
+    }
+
+    return status;
+}
+
+#endif // __linux__ && DISABLE_MIRROR && REDUCED_API
@@ -0,0 +1,455 @@
+/**
+ * @file qtip_mpmc.c
+ * @brief API for bounded lock-free multi-producer/multi-consumer queues
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#include "qtip_mpmc.h"
+#include "qtip_private.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+_Static_assert(STATS_SAMPLE_RATE > 0U, "STATS_SAMPLE_RATE must be at least one put");
+#endif
+
+/*
+ * Private typedefs
+ */
+
+/**
+ * @brief Sequence number at the start of every slot
+ */
+typedef QTIP_ATOMIC(size_t) qtipMpmcSequence_t;
+
+/*
+ * Private functions
+ */
+
+static inline size_t position_to_index(qtipMpmcContext_t* pContext, size_t position)
+{
+#ifdef POWER_OF_TWO
+    return position & (pContext->maxItems - 1U);
+#else
+    return position % pContext->maxItems;
+#endif
+}
+
+static inline qtipMpmcSequence_t* position_to_sequence(qtipMpmcContext_t* pContext, size_t position)
+{
+    return (qtipMpmcSequence_t*) (pContext->start + position_to_index(pContext, position) * pContext->slotSize);
+}
+
+static inline void* sequence_to_item(qtipMpmcSequence_t* pSequence)
+{
+    return (void*) (pSequence + 1);
+}
+
+static inline intptr_t sequence_distance(size_t sequence, size_t position)
+{
+    return (intptr_t) (sequence - position);
+}
+
+static qtipMpmcSequence_t* claim_rear(qtipMpmcContext_t* pContext, size_t* pPosition)
+{
+    qtipMpmcSequence_t* pSequence = NULL;
+    size_t position               = atomic_load_explicit(&pContext->rear, memory_order_relaxed);
+
+    while (pSequence == NULL)
+    {
+        qtipMpmcSequence_t* pSlot = position_to_sequence(pContext, position);
+        const intptr_t distance =
+            sequence_distance(atomic_load_explicit(pSlot, memory_order_acquire), position);
+
+        if (distance == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(
+                    &pContext->rear, &position, position + 1U, memory_order_relaxed, memory_order_relaxed))
+            {
+                pSequence = pSlot;
+            }
+        }
+        else if (distance < 0)
+        {
+            break;
+        }
+        else
+        {
+            position = atomic_load_explicit(&pContext->rear, memory_order_relaxed);
+        }
+    }
+
+    *pPosition = position;
+    return pSequence;
+}
+
+static qtipMpmcSequence_t* claim_front(qtipMpmcContext_t* pContext, size_t* pPosition)
+{
+    qtipMpmcSequence_t* pSequence = NULL;
+    size_t position               = atomic_load_explicit(&pContext->front, memory_order_relaxed);
+
+    while (pSequence == NULL)
+    {
+        qtipMpmcSequence_t* pSlot = position_to_sequence(pContext, position);
+        const intptr_t distance =
+            sequence_distance(atomic_load_explicit(pSlot, memory_order_acquire), position + 1U);
+
+        if (distance == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(
+                    &pContext->front, &position, position + 1U, memory_order_relaxed, memory_order_relaxed))
+            {
+                pSequence = pSlot;
+            }
+        }
+        else if (distance < 0)
+        {
+            break;
+        }
+        else
+        {
+            position = atomic_load_explicit(&pContext->front, memory_order_relaxed);
+        }
+    }
+
+    *pPosition = position;
+    return pSequence;
+}
+
+static inline void record_put(qtipMpmcContext_t* pContext, size_t position)
+{
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    // Producers do not share a countdown, so the claimed position picks the sampled puts
+    if ((position % STATS_SAMPLE_RATE) == 0U)
+    {
+        const size_t qty       = position + 1U - atomic_load_explicit(&pContext->front, memory_order_relaxed);
+        const qtipSize_t level = (qty < pContext->maxItems) ? (qtipSize_t) qty : pContext->maxItems;
+        qtipSize_t highest     = atomic_load_explicit(&pContext->highWatermark, memory_order_relaxed);
+
+        // A failed exchange reloads the highest level, so this stops as soon as another put raised it further
+        while ((level > highest) && !atomic_compare_exchange_weak_explicit(&pContext->highWatermark,
+                                                                           &highest,
+                                                                           level,
+                                                                           memory_order_relaxed,
+                                                                           memory_order_relaxed))
+        {
+        }
+
+        atomic_fetch_add_explicit(&pContext->histogram[qtip_stats_bucket(level)], 1U, memory_order_relaxed);
+    }
+#else
+    (void) pContext;
+    (void) position;
+#endif
+}
+
+static qtipStatus_t put_item(qtipMpmcContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status           = QTIP_STATUS_OK;
+    size_t position               = 0U;
+    qtipMpmcSequence_t* pSequence = claim_rear(pContext, &position);
+
+    if (pSequence != NULL)
+    {
+        memcpy(sequence_to_item(pSequence), pItem, pContext->itemSize);
+        // Sampled before the item is published, so no consumer can have moved the front past it
+        record_put(pContext, position);
+        atomic_store_explicit(pSequence, position + 1U, memory_order_release);
+#ifndef DISABLE_WAIT
+        qtip_wait_notify(&pContext->notEmpty);
+#endif
+
+#ifndef DISABLE_TELEMETRY
+        atomic_fetch_add_explicit(&pContext->total, 1U, memory_order_relaxed);
+#endif
+    }
+    else
+    {
+        status = QTIP_STATUS_FULL;
+    }
+
+    return status;
+}
+
+static qtipStatus_t pop_item(qtipMpmcContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status           = QTIP_STATUS_OK;
+    size_t position               = 0U;
+    qtipMpmcSequence_t* pSequence = claim_front(pContext, &position);
+
+    if (pSequence != NULL)
+    {
+        memcpy(pItem, sequence_to_item(pSequence), pContext->itemSize);
+        atomic_store_explicit(pSequence, position + pContext->maxItems, memory_order_release);
+#ifndef DISABLE_WAIT
+        qtip_wait_notify(&pContext->notFull);
+#endif
+
+#ifndef DISABLE_TELEMETRY
+        atomic_fetch_add_explicit(&pContext->processed, 1U, memory_order_relaxed);
+#endif
+    }
+    else
+    {
+        status = QTIP_STATUS_EMPTY;
+    }
+
+    return status;
+}
+
+static inline qtipStatus_t count_rejection(qtipMpmcContext_t* pContext, qtipStatus_t status)
+{
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    // Each side counts on its own cache line, which its threads already contend for
+    if (status == QTIP_STATUS_FULL)
+    {
+        atomic_fetch_add_explicit(&pContext->full, 1U, memory_order_relaxed);
+    }
+    else if (status == QTIP_STATUS_EMPTY)
+    {
+        atomic_fetch_add_explicit(&pContext->empty, 1U, memory_order_relaxed);
+    }
+#else
+    (void) pContext;
+#endif
+
+    return status;
+}
+
+#ifndef DISABLE_WAIT
+
+// The retries of a blocking call are not rejections, so they skip the statistics
+static qtipStatus_t put_operation(void* pContext, void* pItem)
+{
+    return put_item(pContext, pItem);
+}
+
+static qtipStatus_t pop_operation(void* pContext, void* pItem)
+{
+    return pop_item(pContext, pItem);
+}
+
+#endif // DISABLE_WAIT
+
+/*
+ * Public API
+ */
+
+qtipStatus_t qtip_mpmc_init(qtipMpmcContext_t* pContext, void* pBuffer, qtipSize_t maxItems, size_t itemSize)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pBuffer));
+    status = CHECK_STATUS(status, (maxItems > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status, (itemSize > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(
+        status, (((uintptr_t) pBuffer % _Alignof(qtipMpmcSequence_t)) == 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+#ifdef POWER_OF_TWO
+    status = CHECK_STATUS(status, ((maxItems & (maxItems - 1U)) == 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+#endif
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        pContext->start    = pBuffer;
+        pContext->maxItems = maxItems;
+        pContext->itemSize = itemSize;
+        pContext->slotSize = QTIP_MPMC_SLOT_SIZE(itemSize);
+        atomic_init(&pContext->rear, 0U);
+        atomic_init(&pContext->front, 0U);
+#ifndef DISABLE_TELEMETRY
+        atomic_init(&pContext->total, 0U);
+        atomic_init(&pContext->processed, 0U);
+#endif
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+        atomic_init(&pContext->full, 0U);
+        atomic_init(&pContext->empty, 0U);
+        atomic_init(&pContext->highWatermark, 0U);
+        for (size_t i = 0U; i < STATS_BUCKETS; i++)
+        {
+            atomic_init(&pContext->histogram[i], 0U);
+        }
+#endif
+#ifndef DISABLE_WAIT
+        qtip_wait_init(&pContext->notEmpty);
+        qtip_wait_init(&pContext->notFull);
+#endif
+
+        for (size_t i = 0U; i < maxItems; i++)
+        {
+            atomic_init(position_to_sequence(pContext, i), i);
+        }
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_mpmc_put(qtipMpmcContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = count_rejection(pContext, put_item(pContext, pItem));
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_mpmc_pop(qtipMpmcContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = count_rejection(pContext, pop_item(pContext, pItem));
+    }
+
+    return status;
+}
+
+#ifndef DISABLE_WAIT
+
+qtipStatus_t qtip_mpmc_put_wait(qtipMpmcContext_t* pContext, void* pItem, uint32_t timeoutUs, qtipWaitStrategy_t strategy)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = count_rejection(
+            pContext, qtip_wait_for(&pContext->notFull, strategy, timeoutUs, put_operation, pContext, pItem));
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_mpmc_pop_wait(qtipMpmcContext_t* pContext, void* pItem, uint32_t timeoutUs, qtipWaitStrategy_t strategy)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = count_rejection(
+            pContext, qtip_wait_for(&pContext->notEmpty, strategy, timeoutUs, pop_operation, pContext, pItem));
+    }
+
+    return status;
+}
+
+#endif // DISABLE_WAIT
+
+qtipStatus_t qtip_mpmc_count_items(qtipMpmcContext_t* pContext, qtipSize_t* pResult)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const size_t front = atomic_load_explicit(&pContext->front, memory_order_acquire);
+        const size_t rear  = atomic_load_explicit(&pContext->rear, memory_order_acquire);
+        const size_t qty   = rear - front;
+
+        *pResult = (qty < pContext->maxItems) ? (qtipSize_t) qty : pContext->maxItems;
+    }
+
+    return status;
+}
+
+#ifndef DISABLE_TELEMETRY
+
+qtipStatus_t qtip_mpmc_total_enqueued_items(qtipMpmcContext_t* pContext, size_t* pResult)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        *pResult = atomic_load_explicit(&pContext->total, memory_order_relaxed);
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_mpmc_total_processed_items(qtipMpmcContext_t* pContext, size_t* pResult)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        *pResult = atomic_load_explicit(&pContext->processed, memory_order_relaxed);
+    }
+
+    return status;
+}
+
+#ifndef DISABLE_STATS
+
+qtipStatus_t qtip_mpmc_get_stats(qtipMpmcContext_t* pContext, qtipStats_t* pStats, bool reset)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pStats));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        pStats->highWatermark = reset ? atomic_exchange_explicit(&pContext->highWatermark, 0U, memory_order_relaxed)
+                                      : atomic_load_explicit(&pContext->highWatermark, memory_order_relaxed);
+        pStats->full          = reset ? atomic_exchange_explicit(&pContext->full, 0U, memory_order_relaxed)
+                                      : atomic_load_explicit(&pContext->full, memory_order_relaxed);
+        pStats->empty         = reset ? atomic_exchange_explicit(&pContext->empty, 0U, memory_order_relaxed)
+                                      : atomic_load_explicit(&pContext->empty, memory_order_relaxed);
+        pStats->locked        = 0U;
+
+        for (size_t i = 0U; i < STATS_BUCKETS; i++)
+        {
+            pStats->histogram[i] = reset ? atomic_exchange_explicit(&pContext->histogram[i], 0U, memory_order_relaxed)
+                                         : atomic_load_explicit(&pContext->histogram[i], memory_order_relaxed);
+        }
+    }
+
+    return status;
+}
+
+#endif // DISABLE_STATS
+
+#endif // DISABLE_TELEMETRY
@@ -0,0 +1,158 @@
+/**
+ * @file qtip_priority.c
+ * @brief API for queues with a fixed number of priority levels
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#include "qtip_priority.h"
+#include "qtip_fast.h"
+#include "qtip_private.h"
+
+#ifndef DISABLE_PRIORITY
+
+#include <string.h>
+
+_Static_assert(PRIORITY_LEVELS <= 32U, "PRIORITY_LEVELS must fit in the 32-bit ready mask");
+
+/*
+ * Private functions
+ */
+
+static inline uint32_t first_ready(uint32_t ready)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t) __builtin_ctz(ready);
+#else
+    uint32_t level = 0U;
+    while ((ready & 1U) == 0U)
+    {
+        ready >>= 1U;
+        level++;
+    }
+    return level;
+#endif
+}
+
+/*
+ * Library API
+ */
+
+qtipStatus_t qtip_priority_init(qtipPriorityContext_t* pContext,
+                                void* pBuffer,
+                                uint32_t levels,
+                                qtipSize_t maxItemsPerLevel,
+                                size_t itemSize)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pBuffer));
+    status = CHECK_STATUS(status,
+                          ((levels > 0U) && (levels <= PRIORITY_LEVELS)) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+#endif
+
+    for (uint32_t i = 0U; (status == QTIP_STATUS_OK) && (i < levels); i++)
+    {
+        memset(&pContext->levels[i], 0U, sizeof(pContext->levels[i]));
+        status = qtip_init(&pContext->levels[i], pBuffer + (i * maxItemsPerLevel * itemSize), maxItemsPerLevel, itemSize);
+    }
+
+    if (status == QTIP_STATUS_OK)
+    {
+        pContext->levelCount = levels;
+        pContext->ready      = 0U;
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_priority_put(qtipPriorityContext_t* pContext, void* pItem, uint32_t priority)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    status = CHECK_STATUS(status, (priority < pContext->levelCount) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status, qtip_fast_put(&pContext->levels[priority], pItem));
+
+    if (status == QTIP_STATUS_OK)
+    {
+        pContext->ready |= 1U << priority;
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_priority_pop(qtipPriorityContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    status = CHECK_STATUS(status, (pContext->ready != 0U) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY);
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const uint32_t level = first_ready(pContext->ready);
+
+        (void) qtip_fast_pop(&pContext->levels[level], pItem);
+        if (qtip_fast_is_empty(&pContext->levels[level]))
+        {
+            pContext->ready &= ~(1U << level);
+        }
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_priority_get_front(qtipPriorityContext_t* pContext, void* pItem, uint32_t* pPriority)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pPriority));
+#endif
+
+    status = CHECK_STATUS(status, (pContext->ready != 0U) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY);
+
+    if (status == QTIP_STATUS_OK)
+    {
+        *pPriority = first_ready(pContext->ready);
+        (void) qtip_fast_get_front(&pContext->levels[*pPriority], pItem);
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_priority_count_items(qtipPriorityContext_t* pContext, qtipSize_t* pResult)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        *pResult = 0U;
+        for (uint32_t i = 0U; i < pContext->levelCount; i++)
+        {
+            *pResult += qtip_fast_count_items(&pContext->levels[i]);
+        }
+    }
+
+    return status;
+}
+
+#endif // DISABLE_PRIORITY
@@ -0,0 +1,139 @@
+/**
+ * @file qtip_private.h
+ * @brief Private helpers shared by the QTip sources
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#ifndef QTIP_PRIVATE_H
+#define QTIP_PRIVATE_H
+
+#include "qtip.h"
+
+/*
+ * Private defines
+ */
+
+/**
+ * @brief Check whether the input is a null pointer
+ */
+#define CHECK_NULL_PRT(ptr) (((ptr) != NULL) ? QTIP_STATUS_OK : QTIP_STATUS_NULL_PTR)
+
+/**
+ * @brief Combine the current status with a new expression
+ */
+#define CHECK_STATUS(status, exp) (((status) == QTIP_STATUS_OK) ? (exp) : (status))
+
+/*
+ * Private functions
+ */
+
+/**
+ * @brief Gets the base-2 logarithm of a value, rounded down, with `0` for `0`
+ */
+static inline size_t qtip_log2(uint64_t value)
+{
+    size_t result = 0U;
+
+#if defined(__GNUC__) || defined(__clang__)
+    // Setting the lowest bit maps 0 to 0 without changing the logarithm of the other values
+    result = 63U - (size_t) __builtin_clzll((unsigned long long) (value | 1U));
+#else
+    for (; value > 1U; value >>= 1U)
+    {
+        result++;
+    }
+#endif
+
+    return result;
+}
+
+/**
+ * @brief Gets the number of bits set in a value
+ */
+static inline size_t qtip_popcount(uint64_t value)
+{
+    size_t result = 0U;
+
+#if defined(__GNUC__) || defined(__clang__)
+    result = (size_t) __builtin_popcountll((unsigned long long) value);
+#else
+    for (; value != 0U; value &= value - 1U)
+    {
+        result++;
+    }
+#endif
+
+    return result;
+}
+
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+
+/**
+ * @brief Gets the histogram bucket of a fill level, see @ref qtipStats_t
+ */
+static inline size_t qtip_stats_bucket(size_t count)
+{
+    const size_t bucket = qtip_log2(count);
+
+    return (bucket < STATS_BUCKETS) ? bucket : (STATS_BUCKETS - 1U);
+}
+
+#endif // DISABLE_TELEMETRY && DISABLE_STATS
+
+#ifndef DISABLE_WAIT
+
+#include "qtip_wait.h"
+
+/*
+ * Private typedefs
+ */
+
+/**
+ * @brief Non-blocking operation retried by @ref qtip_wait_for
+ */
+typedef qtipStatus_t (*qtipWaitOperation_t)(void* pContext, void* pItem);
+
+/*
+ * Library API
+ */
+
+/**
+ * @brief Initializes a set of parked threads
+ */
+void qtip_wait_init(qtipWaiters_t* pWaiters);
+
+/**
+ * @brief Wakes every thread parked on a set of waiters
+ */
+void qtip_wait_wake(qtipWaiters_t* pWaiters);
+
+/**
+ * @brief Retries an operation until it stops returning `FULL` or `EMPTY`, or the timeout expires
+ */
+qtipStatus_t qtip_wait_for(qtipWaiters_t* pWaiters,
+                           qtipWaitStrategy_t strategy,
+                           uint32_t timeoutUs,
+                           qtipWaitOperation_t operation,
+                           void* pContext,
+                           void* pItem);
+
+/**
+ * @brief Wakes the threads parked on a set of waiters, if there are any
+ * @details Must be called after the change the waiters wait for is published.
+ *          The fence orders that change before the read of the waiter count,
+ *          so a thread that is about to park either sees the change or is
+ *          counted and woken up.
+ */
+static inline void qtip_wait_notify(qtipWaiters_t* pWaiters)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&pWaiters->waiters, memory_order_relaxed) > 0U)
+    {
+        qtip_wait_wake(pWaiters);
+    }
+}
+
+#endif // DISABLE_WAIT
+
+#endif // QTIP_PRIVATE_H
@@ -0,0 +1,300 @@
+/**
+ * @file qtip_record.c
+ * @brief API for queues of variable-length records
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#include "qtip_record.h"
+#include "qtip_private.h"
+
+#ifndef DISABLE_RECORD
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Private defines
+ */
+
+#define RECORD_PADDING UINT32_MAX //!< Header of the unused bytes at the end of the buffer
+
+/*
+ * Private functions
+ */
+
+static inline void write_header(qtipRecordContext_t* pContext, size_t offset, uint32_t header)
+{
+    memcpy(pContext->start + offset, &header, sizeof(header));
+}
+
+static inline uint32_t read_header(qtipRecordContext_t* pContext, size_t offset)
+{
+    uint32_t header = 0U;
+    memcpy(&header, pContext->start + offset, sizeof(header));
+    return header;
+}
+
+static inline void* record_data(qtipRecordContext_t* pContext, size_t offset)
+{
+    return pContext->start + offset + QTIP_RECORD_ALIGNMENT;
+}
+
+static inline qtipStatus_t check_length(qtipRecordContext_t* pContext, size_t length)
+{
+    return ((length > 0U) && (length < RECORD_PADDING) && (QTIP_RECORD_SIZE(length) <= pContext->size))
+               ? QTIP_STATUS_OK
+               : QTIP_STATUS_INVALID_SIZE;
+}
+
+static qtipStatus_t find_space(qtipRecordContext_t* pContext, size_t length, size_t* pOffset)
+{
+    const size_t span   = QTIP_RECORD_SIZE(length);
+    qtipStatus_t status = QTIP_STATUS_FULL;
+
+    if (pContext->used == 0U)
+    {
+        *pOffset = 0U;
+        status   = QTIP_STATUS_OK;
+    }
+    else if (pContext->rear > pContext->front)
+    {
+        // The free space is split between the end and the start of the buffer
+        if (span <= (pContext->size - pContext->rear))
+        {
+            *pOffset = pContext->rear;
+            status   = QTIP_STATUS_OK;
+        }
+        else if (span <= pContext->front)
+        {
+            *pOffset = 0U;
+            status   = QTIP_STATUS_OK;
+        }
+    }
+    else if (span <= (pContext->front - pContext->rear))
+    {
+        *pOffset = pContext->rear;
+        status   = QTIP_STATUS_OK;
+    }
+
+    return status;
+}
+
+static void add_record(qtipRecordContext_t* pContext, size_t offset, size_t length)
+{
+    const size_t span = QTIP_RECORD_SIZE(length);
+
+    if (pContext->used == 0U)
+    {
+        pContext->front = offset;
+    }
+    else if (offset != pContext->rear)
+    {
+        // The record wrapped to the start, skip the end of the buffer
+        write_header(pContext, pContext->rear, RECORD_PADDING);
+        pContext->used += pContext->size - pContext->rear;
+    }
+
+    write_header(pContext, offset, (uint32_t) length);
+    pContext->rear = offset + span;
+    pContext->rear = (pContext->rear < pContext->size) ? pContext->rear : 0U;
+    pContext->used += span;
+    pContext->qty++;
+}
+
+static uint32_t front_length(qtipRecordContext_t* pContext)
+{
+    uint32_t length = read_header(pContext, pContext->front);
+
+    if (length == RECORD_PADDING)
+    {
+        pContext->used -= pContext->size - pContext->front;
+        pContext->front = 0U;
+        length          = read_header(pContext, pContext->front);
+    }
+
+    return length;
+}
+
+static void remove_record(qtipRecordContext_t* pContext, size_t length)
+{
+    const size_t span = QTIP_RECORD_SIZE(length);
+
+    pContext->front += span;
+    pContext->front = (pContext->front < pContext->size) ? pContext->front : 0U;
+    pContext->used -= span;
+    pContext->qty--;
+
+    if (pContext->used == 0U)
+    {
+        pContext->front = 0U;
+        pContext->rear  = 0U;
+    }
+}
+
+/*
+ * Library API
+ */
+
+qtipStatus_t qtip_record_init(qtipRecordContext_t* pContext, void* pBuffer, size_t size)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pBuffer));
+    status = CHECK_STATUS(status,
+                          ((size > 0U) && ((size % QTIP_RECORD_ALIGNMENT) == 0U)) ? QTIP_STATUS_OK
+                                                                                  : QTIP_STATUS_INVALID_SIZE);
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        pContext->start         = pBuffer;
+        pContext->size          = size;
+        pContext->front         = 0U;
+        pContext->rear          = 0U;
+        pContext->used          = 0U;
+        pContext->qty           = 0U;
+        pContext->reserveOffset = 0U;
+        pContext->reserveLength = 0U;
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_record_put(qtipRecordContext_t* pContext, const void* pRecord, size_t length)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+    size_t offset       = 0U;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pRecord));
+#endif
+
+    status = CHECK_STATUS(status, check_length(pContext, length));
+    status = CHECK_STATUS(status, find_space(pContext, length, &offset));
+
+    if (status == QTIP_STATUS_OK)
+    {
+        memcpy(record_data(pContext, offset), pRecord, length);
+        add_record(pContext, offset, length);
+        pContext->reserveLength = 0U;
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_record_pop(qtipRecordContext_t* pContext, void* pBuffer, size_t bufferSize, size_t* pLength)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pBuffer));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pLength));
+#endif
+
+    status = CHECK_STATUS(status, (pContext->qty > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY);
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const size_t length = front_length(pContext);
+
+        *pLength = length;
+        if (length <= bufferSize)
+        {
+            memcpy(pBuffer, record_data(pContext, pContext->front), length);
+            remove_record(pContext, length);
+        }
+        else
+        {
+            status = QTIP_STATUS_INVALID_SIZE;
+        }
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_record_next_size(qtipRecordContext_t* pContext, size_t* pLength)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pLength));
+#endif
+
+    status = CHECK_STATUS(status, (pContext->qty > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY);
+
+    if (status == QTIP_STATUS_OK)
+    {
+        *pLength = front_length(pContext);
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_record_reserve(qtipRecordContext_t* pContext, size_t length, void** ppRecord)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+    size_t offset       = 0U;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(ppRecord));
+#endif
+
+    status = CHECK_STATUS(status, check_length(pContext, length));
+    status = CHECK_STATUS(status, find_space(pContext, length, &offset));
+
+    if (status == QTIP_STATUS_OK)
+    {
+        pContext->reserveOffset = offset;
+        pContext->reserveLength = length;
+        *ppRecord               = record_data(pContext, offset);
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_record_commit(qtipRecordContext_t* pContext, size_t length)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+    status = CHECK_STATUS(status,
+                          ((length > 0U) && (length <= pContext->reserveLength)) ? QTIP_STATUS_OK
+                                                                                 : QTIP_STATUS_INVALID_SIZE);
+
+    if (status == QTIP_STATUS_OK)
+    {
+        add_record(pContext, pContext->reserveOffset, length);
+        pContext->reserveLength = 0U;
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_record_count(qtipRecordContext_t* pContext, qtipSize_t* pCount)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pCount));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        *pCount = pContext->qty;
+    }
+
+    return status;
+}
+
+#endif // DISABLE_RECORD
@@ -0,0 +1,267 @@
+/**
+ * @file qtip_segment.c
+ * @brief API for unbounded queues made of chained fixed-size chunks
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#include "qtip_segment.h"
+#include "qtip_fast.h"
+#include "qtip_private.h"
+
+#ifndef DISABLE_SEGMENT
+
+#include <string.h>
+
+/*
+ * Private defines
+ */
+
+/**
+ * @brief Offset of the items from the start of a chunk
+ */
+#define CHUNK_ITEMS_OFFSET \
+    (((sizeof(qtipSegmentChunk_t) + _Alignof(max_align_t) - 1U) / _Alignof(max_align_t)) * _Alignof(max_align_t))
+
+/*
+ * Private Structs
+ */
+
+struct qtipSegmentChunk
+{
+    qtipSegmentChunk_t* pNext; //!< Next chunk towards the rear, or in the pool
+    qtipContext_t ring;        //!< Ring on the items of the chunk
+};
+
+/*
+ * Private functions
+ */
+
+static qtipStatus_t new_chunk(qtipSegmentContext_t* pContext, qtipSegmentChunk_t** ppChunk)
+{
+    const size_t size          = CHUNK_ITEMS_OFFSET + (pContext->chunkItems * pContext->itemSize);
+    qtipSegmentChunk_t* pChunk = pContext->pAllocator->alloc(size, pContext->pAllocator->pArg);
+    qtipStatus_t status        = (pChunk != NULL) ? QTIP_STATUS_OK : QTIP_STATUS_SYSTEM_ERROR;
+
+    if (status == QTIP_STATUS_OK)
+    {
+        memset(pChunk, 0U, sizeof(*pChunk));
+        status = qtip_init(&pChunk->ring, (void*) pChunk + CHUNK_ITEMS_OFFSET, pContext->chunkItems, pContext->itemSize);
+
+        if (status == QTIP_STATUS_OK)
+        {
+            pContext->chunks++;
+            *ppChunk = pChunk;
+        }
+        else
+        {
+            pContext->pAllocator->free(pChunk, pContext->pAllocator->pArg);
+        }
+    }
+
+    return status;
+}
+
+static qtipSegmentChunk_t* take_chunk(qtipSegmentContext_t* pContext)
+{
+    qtipSegmentChunk_t* pChunk = pContext->pPool;
+
+    if (pChunk != NULL)
+    {
+        pContext->pPool = pChunk->pNext;
+        pContext->pooled--;
+    }
+    else if ((pContext->maxChunks == 0U) || (pContext->chunks < pContext->maxChunks))
+    {
+        (void) new_chunk(pContext, &pChunk);
+    }
+
+    if (pChunk != NULL)
+    {
+        pChunk->pNext = NULL;
+    }
+
+    return pChunk;
+}
+
+static void give_chunk(qtipSegmentContext_t* pContext, qtipSegmentChunk_t* pChunk)
+{
+    if (pContext->pooled < pContext->maxPooled)
+    {
+        pChunk->pNext   = pContext->pPool;
+        pContext->pPool = pChunk;
+        pContext->pooled++;
+    }
+    else
+    {
+        pContext->pAllocator->free(pChunk, pContext->pAllocator->pArg);
+        pContext->chunks--;
+    }
+}
+
+static void free_chunks(qtipSegmentContext_t* pContext, qtipSegmentChunk_t* pChunk)
+{
+    while (pChunk != NULL)
+    {
+        qtipSegmentChunk_t* pNext = pChunk->pNext;
+        pContext->pAllocator->free(pChunk, pContext->pAllocator->pArg);
+        pChunk = pNext;
+    }
+}
+
+/*
+ * Library API
+ */
+
+qtipStatus_t qtip_segment_init(qtipSegmentContext_t* pContext,
+                               const qtipAllocator_t* pAllocator,
+                               qtipSize_t chunkItems,
+                               size_t itemSize,
+                               size_t maxChunks,
+                               size_t maxPooled)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pAllocator));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pAllocator->alloc));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pAllocator->free));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        pContext->pHead      = NULL;
+        pContext->pTail      = NULL;
+        pContext->pPool      = NULL;
+        pContext->pAllocator = pAllocator;
+        pContext->chunkItems = chunkItems;
+        pContext->itemSize   = itemSize;
+        pContext->maxChunks  = maxChunks;
+        pContext->maxPooled  = maxPooled;
+        pContext->chunks     = 0U;
+        pContext->pooled     = 0U;
+        pContext->qty        = 0U;
+
+        status = new_chunk(pContext, &pContext->pHead);
+        pContext->pTail = pContext->pHead;
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_segment_put(qtipSegmentContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    if ((status == QTIP_STATUS_OK) && qtip_fast_is_full(&pContext->pTail->ring))
+    {
+        qtipSegmentChunk_t* pChunk = take_chunk(pContext);
+
+        if (pChunk != NULL)
+        {
+            pContext->pTail->pNext = pChunk;
+            pContext->pTail        = pChunk;
+        }
+        else
+        {
+            status = QTIP_STATUS_FULL;
+        }
+    }
+
+    if (status == QTIP_STATUS_OK)
+    {
+        (void) qtip_fast_put(&pContext->pTail->ring, pItem);
+        pContext->qty++;
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_segment_pop(qtipSegmentContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    status = CHECK_STATUS(status, (pContext->qty > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY);
+
+    if (status == QTIP_STATUS_OK)
+    {
+        qtipSegmentChunk_t* pHead = pContext->pHead;
+
+        (void) qtip_fast_pop(&pHead->ring, pItem);
+        pContext->qty--;
+
+        // Only the tail chunk can be empty, so the front is always in the head chunk
+        if (qtip_fast_is_empty(&pHead->ring) && (pHead != pContext->pTail))
+        {
+            pContext->pHead = pHead->pNext;
+            give_chunk(pContext, pHead);
+        }
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_segment_get_front(qtipSegmentContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    return CHECK_STATUS(status, qtip_fast_get_front(&pContext->pHead->ring, pItem));
+}
+
+qtipStatus_t qtip_segment_count_items(qtipSegmentContext_t* pContext, size_t* pResult)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        *pResult = pContext->qty;
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_segment_free(qtipSegmentContext_t* pContext)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        free_chunks(pContext, pContext->pHead);
+        free_chunks(pContext, pContext->pPool);
+        pContext->pHead  = NULL;
+        pContext->pTail  = NULL;
+        pContext->pPool  = NULL;
+        pContext->chunks = 0U;
+        pContext->pooled = 0U;
+        pContext->qty    = 0U;
+    }
+
+    return status;
+}
+
+#endif // DISABLE_SEGMENT
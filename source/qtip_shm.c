@@ -0,0 +1,518 @@
+/**
+ * @file qtip_shm.c
+ * @brief API for single-producer/single-consumer queues shared between processes
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "qtip_shm.h"
+#include "qtip_private.h"
+
+#ifndef DISABLE_SHM
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+_Static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+               "Shared memory queues need lock-free 32 and 64-bit atomics, define DISABLE_SHM");
+
+/*
+ * Private defines
+ */
+
+#define SHM_MODE 0600
+
+/*
+ * Private functions
+ */
+
+static inline uint64_t counter_range(qtipShmContext_t* pContext)
+{
+    return (uint64_t) pContext->maxItems * 2U;
+}
+
+static inline qtipSize_t counter_to_index(qtipShmContext_t* pContext, uint64_t counter)
+{
+    return (qtipSize_t) ((counter < pContext->maxItems) ? counter : (counter - pContext->maxItems));
+}
+
+static inline uint64_t advance_counter(qtipShmContext_t* pContext, uint64_t counter, qtipSize_t n)
+{
+    const uint64_t untilEnd = counter_range(pContext) - counter;
+    return (n < untilEnd) ? (counter + n) : (n - untilEnd);
+}
+
+static inline qtipSize_t counter_distance(qtipShmContext_t* pContext, uint64_t from, uint64_t to)
+{
+    return (qtipSize_t) ((to >= from) ? (to - from) : ((counter_range(pContext) - from) + to));
+}
+
+static inline void* index_to_address(qtipShmContext_t* pContext, qtipSize_t index)
+{
+    return pContext->start + index * pContext->itemSize;
+}
+
+static void write_items(qtipShmContext_t* pContext, uint64_t counter, void* pItems, qtipSize_t n)
+{
+    const qtipSize_t index    = counter_to_index(pContext, counter);
+    const qtipSize_t untilEnd = pContext->maxItems - index;
+    const qtipSize_t first    = (n < untilEnd) ? n : untilEnd;
+
+    memcpy(index_to_address(pContext, index), pItems, first * pContext->itemSize);
+    if (first < n)
+    {
+        memcpy(pContext->start, pItems + first * pContext->itemSize, (n - first) * pContext->itemSize);
+    }
+}
+
+static void read_items(qtipShmContext_t* pContext, uint64_t counter, void* pItems, qtipSize_t n)
+{
+    const qtipSize_t index    = counter_to_index(pContext, counter);
+    const qtipSize_t untilEnd = pContext->maxItems - index;
+    const qtipSize_t first    = (n < untilEnd) ? n : untilEnd;
+
+    memcpy(pItems, index_to_address(pContext, index), first * pContext->itemSize);
+    if (first < n)
+    {
+        memcpy(pItems + first * pContext->itemSize, pContext->start, (n - first) * pContext->itemSize);
+    }
+}
+
+static qtipSize_t count_free(qtipShmContext_t* pContext, uint64_t rear, qtipSize_t wanted)
+{
+    qtipSize_t room = pContext->maxItems - counter_distance(pContext, pContext->frontCache, rear);
+
+    if (room < wanted)
+    {
+        pContext->frontCache = atomic_load_explicit(&pContext->pHeader->front, memory_order_acquire);
+        room                 = pContext->maxItems - counter_distance(pContext, pContext->frontCache, rear);
+    }
+
+    return room;
+}
+
+static qtipSize_t count_available(qtipShmContext_t* pContext, uint64_t front, qtipSize_t wanted)
+{
+    qtipSize_t available = counter_distance(pContext, front, pContext->rearCache);
+
+    if (available < wanted)
+    {
+        pContext->rearCache = atomic_load_explicit(&pContext->pHeader->rear, memory_order_acquire);
+        available           = counter_distance(pContext, front, pContext->rearCache);
+    }
+
+    return available;
+}
+
+static void put_items(qtipShmContext_t* pContext, uint64_t rear, void* pItems, qtipSize_t n)
+{
+    qtipShmHeader_t* pHeader = pContext->pHeader;
+
+    write_items(pContext, rear, pItems, n);
+    atomic_store_explicit(&pHeader->rear, advance_counter(pContext, rear, n), memory_order_release);
+
+#ifndef DISABLE_TELEMETRY
+    atomic_store_explicit(
+        &pHeader->total, atomic_load_explicit(&pHeader->total, memory_order_relaxed) + n, memory_order_relaxed);
+#endif
+}
+
+static void pop_items(qtipShmContext_t* pContext, uint64_t front, void* pItems, qtipSize_t n)
+{
+    qtipShmHeader_t* pHeader = pContext->pHeader;
+
+    read_items(pContext, front, pItems, n);
+    atomic_store_explicit(&pHeader->front, advance_counter(pContext, front, n), memory_order_release);
+
+#ifndef DISABLE_TELEMETRY
+    atomic_store_explicit(
+        &pHeader->processed, atomic_load_explicit(&pHeader->processed, memory_order_relaxed) + n, memory_order_relaxed);
+#endif
+}
+
+static inline bool fits_memory(qtipSize_t maxItems, size_t itemSize, size_t size)
+{
+    return (size >= sizeof(qtipShmHeader_t)) && (maxItems <= ((size - sizeof(qtipShmHeader_t)) / itemSize));
+}
+
+static void bind_context(qtipShmContext_t* pContext, qtipShmHeader_t* pHeader)
+{
+    pContext->pHeader    = pHeader;
+    pContext->start      = (void*) pHeader + pHeader->itemsOffset;
+    pContext->maxItems   = (qtipSize_t) pHeader->maxItems;
+    pContext->itemSize   = (size_t) pHeader->itemSize;
+    pContext->mapSize    = 0U;
+    pContext->frontCache = atomic_load_explicit(&pHeader->front, memory_order_acquire);
+    pContext->rearCache  = atomic_load_explicit(&pHeader->rear, memory_order_acquire);
+}
+
+static void* map_object(int fd, size_t size)
+{
+    void* pMemory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return (pMemory != MAP_FAILED) ? pMemory : NULL;
+}
+
+/*
+ * Public API
+ */
+
+qtipStatus_t qtip_shm_init(qtipShmContext_t* pContext, void* pMemory, size_t size, qtipSize_t maxItems, size_t itemSize)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pMemory));
+    status = CHECK_STATUS(status, (maxItems > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status, (itemSize > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status, fits_memory(maxItems, itemSize, size) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(
+        status, (((uintptr_t) pMemory % CACHE_LINE_SIZE) == 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+#else
+    (void) size;
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        qtipShmHeader_t* pHeader = pMemory;
+
+        atomic_store_explicit(&pHeader->magic, 0U, memory_order_relaxed);
+        pHeader->version     = QTIP_SHM_VERSION;
+        pHeader->maxItems    = maxItems;
+        pHeader->itemSize    = itemSize;
+        pHeader->itemsOffset = sizeof(qtipShmHeader_t);
+        atomic_store_explicit(&pHeader->rear, 0U, memory_order_relaxed);
+        atomic_store_explicit(&pHeader->total, 0U, memory_order_relaxed);
+        atomic_store_explicit(&pHeader->front, 0U, memory_order_relaxed);
+        atomic_store_explicit(&pHeader->processed, 0U, memory_order_relaxed);
+        atomic_store_explicit(&pHeader->magic, QTIP_SHM_MAGIC, memory_order_release);
+
+        bind_context(pContext, pHeader);
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_shm_attach_memory(qtipShmContext_t* pContext, void* pMemory, size_t size)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pMemory));
+#endif
+    status = CHECK_STATUS(status, (size >= sizeof(qtipShmHeader_t)) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+
+    if (status == QTIP_STATUS_OK)
+    {
+        qtipShmHeader_t* pHeader = pMemory;
+        const bool formatted     = atomic_load_explicit(&pHeader->magic, memory_order_acquire) == QTIP_SHM_MAGIC;
+
+        // The header comes from another process, so it is validated even with SKIP_ARG_CHECK
+        if (formatted && (pHeader->version == QTIP_SHM_VERSION) && (pHeader->maxItems > 0U) &&
+            (pHeader->maxItems == (qtipSize_t) pHeader->maxItems) && (pHeader->maxItems <= (UINT64_MAX / 2U)) &&
+            (pHeader->itemSize > 0U) &&
+            (pHeader->itemsOffset == sizeof(qtipShmHeader_t)) &&
+            fits_memory((qtipSize_t) pHeader->maxItems, (size_t) pHeader->itemSize, size))
+        {
+            bind_context(pContext, pHeader);
+        }
+        else
+        {
+            status = QTIP_STATUS_INVALID_SIZE;
+        }
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_shm_create(qtipShmContext_t* pContext, const char* name, qtipSize_t maxItems, size_t itemSize)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(name));
+    status = CHECK_STATUS(status, (maxItems > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status, (itemSize > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status,
+                          fits_memory(maxItems, itemSize, (size_t) -1) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const size_t size = QTIP_SHM_SIZE(maxItems, itemSize);
+        const int fd      = shm_open(name, O_RDWR | O_CREAT | O_EXCL, SHM_MODE);
+        void* pMemory     = NULL;
+
+        if ((fd >= 0) && (ftruncate(fd, (off_t) size) == 0))
+        {
+            pMemory = map_object(fd, size);
+        }
+
+        if (pMemory != NULL)
+        {
+            status            = qtip_shm_init(pContext, pMemory, size, maxItems, itemSize);
+            pContext->mapSize = size;
+        }
+        else
+        {
+            status = QTIP_STATUS_SYSTEM_ERROR;
+            if (fd >= 0)
+            {
+                (void) shm_unlink(name);
+            }
+        }
+
+        if (fd >= 0)
+        {
+            (void) close(fd);
+        }
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_shm_attach(qtipShmContext_t* pContext, const char* name)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(name));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const int fd  = shm_open(name, O_RDWR, SHM_MODE);
+        struct stat info;
+        void* pMemory = NULL;
+
+        if ((fd >= 0) && (fstat(fd, &info) == 0) && (info.st_size > 0))
+        {
+            pMemory = map_object(fd, (size_t) info.st_size);
+        }
+
+        if (pMemory != NULL)
+        {
+            status = qtip_shm_attach_memory(pContext, pMemory, (size_t) info.st_size);
+            if (status == QTIP_STATUS_OK)
+            {
+                pContext->mapSize = (size_t) info.st_size;
+            }
+            else
+            {
+                (void) munmap(pMemory, (size_t) info.st_size);
+            }
+        }
+        else
+        {
+            status = QTIP_STATUS_SYSTEM_ERROR;
+        }
+
+        if (fd >= 0)
+        {
+            (void) close(fd);
+        }
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_shm_detach(qtipShmContext_t* pContext)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext->pHeader));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        if ((pContext->mapSize > 0U) && (munmap(pContext->pHeader, pContext->mapSize) != 0))
+        {
+            status = QTIP_STATUS_SYSTEM_ERROR;
+        }
+        else
+        {
+            memset(pContext, 0, sizeof(*pContext));
+        }
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_shm_put(qtipShmContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const uint64_t rear = atomic_load_explicit(&pContext->pHeader->rear, memory_order_relaxed);
+
+        if (count_free(pContext, rear, 1U) > 0U)
+        {
+            put_items(pContext, rear, pItem, 1U);
+        }
+        else
+        {
+            status = QTIP_STATUS_FULL;
+        }
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_shm_pop(qtipShmContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const uint64_t front = atomic_load_explicit(&pContext->pHeader->front, memory_order_relaxed);
+
+        if (count_available(pContext, front, 1U) > 0U)
+        {
+            pop_items(pContext, front, pItem, 1U);
+        }
+        else
+        {
+            status = QTIP_STATUS_EMPTY;
+        }
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_shm_put_up_to_n(qtipShmContext_t* pContext, void* pItems, qtipSize_t n, qtipSize_t* pPut)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItems));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pPut));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const uint64_t rear   = atomic_load_explicit(&pContext->pHeader->rear, memory_order_relaxed);
+        const qtipSize_t room = count_free(pContext, rear, n);
+        const qtipSize_t qty  = (n < room) ? n : room;
+
+        if (qty > 0U)
+        {
+            put_items(pContext, rear, pItems, qty);
+        }
+
+        status = ((qty > 0U) || (n == 0U)) ? QTIP_STATUS_OK : QTIP_STATUS_FULL;
+        *pPut  = qty;
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_shm_pop_up_to_n(qtipShmContext_t* pContext, void* pItems, qtipSize_t n, qtipSize_t* pPopped)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItems));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pPopped));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const uint64_t front       = atomic_load_explicit(&pContext->pHeader->front, memory_order_relaxed);
+        const qtipSize_t available = count_available(pContext, front, n);
+        const qtipSize_t qty       = (n < available) ? n : available;
+
+        if (qty > 0U)
+        {
+            pop_items(pContext, front, pItems, qty);
+        }
+
+        status   = ((qty > 0U) || (n == 0U)) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY;
+        *pPopped = qty;
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_shm_count_items(qtipShmContext_t* pContext, qtipSize_t* pResult)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const uint64_t front = atomic_load_explicit(&pContext->pHeader->front, memory_order_acquire);
+        const uint64_t rear  = atomic_load_explicit(&pContext->pHeader->rear, memory_order_acquire);
+        const qtipSize_t qty = counter_distance(pContext, front, rear);
+
+        *pResult = (qty < pContext->maxItems) ? qty : pContext->maxItems;
+    }
+
+    return status;
+}
+
+#ifndef DISABLE_TELEMETRY
+
+qtipStatus_t qtip_shm_total_enqueued_items(qtipShmContext_t* pContext, size_t* pResult)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        *pResult = (size_t) atomic_load_explicit(&pContext->pHeader->total, memory_order_relaxed);
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_shm_total_processed_items(qtipShmContext_t* pContext, size_t* pResult)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        *pResult = (size_t) atomic_load_explicit(&pContext->pHeader->processed, memory_order_relaxed);
+    }
+
+    return status;
+}
+
+#endif // DISABLE_TELEMETRY
+
+#endif // DISABLE_SHM
@@ -0,0 +1,712 @@
+/**
+ * @file qtip_spsc.c
+ * @brief API for lock-free single-producer/single-consumer queues
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#include "qtip_spsc.h"
+#include "qtip_private.h"
+
+#include <string.h>
+
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+_Static_assert(STATS_SAMPLE_RATE > 0U, "STATS_SAMPLE_RATE must be at least one put");
+#endif
+
+/*
+ * Private functions
+ */
+
+static inline qtipSize_t counter_range(qtipSpscContext_t* pContext)
+{
+    return pContext->maxItems * 2U;
+}
+
+static inline qtipSize_t counter_to_index(qtipSpscContext_t* pContext, qtipSize_t counter)
+{
+    return (counter < pContext->maxItems) ? counter : (counter - pContext->maxItems);
+}
+
+static inline qtipSize_t advance_counter(qtipSpscContext_t* pContext, qtipSize_t counter, qtipSize_t n)
+{
+    const qtipSize_t untilEnd = counter_range(pContext) - counter;
+    return (n < untilEnd) ? (counter + n) : (n - untilEnd);
+}
+
+static inline qtipSize_t counter_distance(qtipSpscContext_t* pContext, qtipSize_t from, qtipSize_t to)
+{
+    return (to >= from) ? (to - from) : ((counter_range(pContext) - from) + to);
+}
+
+static inline void* index_to_address(qtipSpscContext_t* pContext, qtipSize_t index)
+{
+    return pContext->start + index * pContext->itemSize;
+}
+
+static void write_items(qtipSpscContext_t* pContext, qtipSize_t counter, void* pItems, qtipSize_t n)
+{
+    const qtipSize_t index    = counter_to_index(pContext, counter);
+    const qtipSize_t untilEnd = pContext->maxItems - index;
+    const qtipSize_t first    = (n < untilEnd) ? n : untilEnd;
+
+    memcpy(index_to_address(pContext, index), pItems, first * pContext->itemSize);
+    if (first < n)
+    {
+        memcpy(pContext->start, pItems + first * pContext->itemSize, (n - first) * pContext->itemSize);
+    }
+}
+
+static void read_items(qtipSpscContext_t* pContext, qtipSize_t counter, void* pItems, qtipSize_t n)
+{
+    const qtipSize_t index    = counter_to_index(pContext, counter);
+    const qtipSize_t untilEnd = pContext->maxItems - index;
+    const qtipSize_t first    = (n < untilEnd) ? n : untilEnd;
+
+    memcpy(pItems, index_to_address(pContext, index), first * pContext->itemSize);
+    if (first < n)
+    {
+        memcpy(pItems + first * pContext->itemSize, pContext->start, (n - first) * pContext->itemSize);
+    }
+}
+
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+
+// Each counter has a single writer, so it is incremented without a locked instruction
+static inline void increment_counter(QTIP_ATOMIC(size_t) * pCounter)
+{
+    atomic_store_explicit(pCounter, atomic_load_explicit(pCounter, memory_order_relaxed) + 1U, memory_order_relaxed);
+}
+
+static inline size_t read_counter(QTIP_ATOMIC(size_t) * pCounter, size_t* pBase, bool reset)
+{
+    const size_t value = atomic_load_explicit(pCounter, memory_order_relaxed);
+    const size_t count = value - *pBase;
+
+    if (reset)
+    {
+        *pBase = value;
+    }
+
+    return count;
+}
+
+#endif // DISABLE_TELEMETRY && DISABLE_STATS
+
+static inline void raise_watermark(qtipSpscContext_t* pContext, qtipSize_t qty)
+{
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    // A reset that lands between the load and the store is overwritten by a level the queue really had
+    if (qty > atomic_load_explicit(&pContext->highWatermark, memory_order_relaxed))
+    {
+        atomic_store_explicit(&pContext->highWatermark, qty, memory_order_relaxed);
+    }
+#else
+    (void) pContext;
+    (void) qty;
+#endif
+}
+
+static qtipSize_t count_free(qtipSpscContext_t* pContext, qtipSize_t rear, qtipSize_t wanted)
+{
+    qtipSize_t room = pContext->maxItems - counter_distance(pContext, pContext->frontCache, rear);
+
+    if (room < wanted)
+    {
+        pContext->frontCache = atomic_load_explicit(&pContext->front, memory_order_acquire);
+        room                 = pContext->maxItems - counter_distance(pContext, pContext->frontCache, rear);
+        raise_watermark(pContext, pContext->maxItems - room);
+    }
+
+    return room;
+}
+
+static qtipSize_t count_available(qtipSpscContext_t* pContext, qtipSize_t front, qtipSize_t wanted)
+{
+    qtipSize_t available = counter_distance(pContext, front, pContext->rearCache);
+
+    // A front moved by a dropping producer can be past the cached rear, which looks like more than a full queue
+    if ((available < wanted) || (available > pContext->maxItems))
+    {
+        pContext->rearCache = atomic_load_explicit(&pContext->rear, memory_order_acquire);
+        available           = counter_distance(pContext, front, pContext->rearCache);
+    }
+
+    return available;
+}
+
+static inline void record_put(qtipSpscContext_t* pContext, qtipSize_t rear)
+{
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    // The cached front can be far behind the real one, so only a sampled put pays for a fresh load
+    pContext->sampleCountdown--;
+    if (pContext->sampleCountdown == 0U)
+    {
+        pContext->sampleCountdown = STATS_SAMPLE_RATE;
+        pContext->frontCache      = atomic_load_explicit(&pContext->front, memory_order_acquire);
+
+        const qtipSize_t qty = counter_distance(pContext, pContext->frontCache, rear);
+
+        raise_watermark(pContext, qty);
+        increment_counter(&pContext->histogram[qtip_stats_bucket(qty)]);
+    }
+#else
+    (void) pContext;
+    (void) rear;
+#endif
+}
+
+static inline qtipStatus_t count_rejection(qtipSpscContext_t* pContext, qtipStatus_t status)
+{
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    if (status == QTIP_STATUS_FULL)
+    {
+        increment_counter(&pContext->full);
+    }
+    else if (status == QTIP_STATUS_EMPTY)
+    {
+        increment_counter(&pContext->empty);
+    }
+#else
+    (void) pContext;
+#endif
+
+    return status;
+}
+
+static void put_items(qtipSpscContext_t* pContext, qtipSize_t rear, void* pItems, qtipSize_t n)
+{
+    const qtipSize_t next = advance_counter(pContext, rear, n);
+
+    write_items(pContext, rear, pItems, n);
+    atomic_store_explicit(&pContext->rear, next, memory_order_release);
+#ifndef DISABLE_WAIT
+    qtip_wait_notify(&pContext->notEmpty);
+#endif
+    record_put(pContext, next);
+
+#ifndef DISABLE_TELEMETRY
+    atomic_store_explicit(
+        &pContext->total, atomic_load_explicit(&pContext->total, memory_order_relaxed) + n, memory_order_relaxed);
+#endif
+}
+
+static inline qtipSize_t load_front(qtipSpscContext_t* pContext)
+{
+#ifndef DISABLE_OVERWRITE
+    // A front moved by the producer must come with the rear it was moved against
+    if (pContext->overwrite)
+    {
+        return atomic_load_explicit(&pContext->front, memory_order_acquire);
+    }
+#endif
+
+    return atomic_load_explicit(&pContext->front, memory_order_relaxed);
+}
+
+static inline size_t begin_read(qtipSpscContext_t* pContext)
+{
+    size_t drops = 0U;
+
+#ifndef DISABLE_OVERWRITE
+    if (pContext->overwrite)
+    {
+        drops = atomic_load_explicit(&pContext->drops, memory_order_acquire);
+    }
+#else
+    (void) pContext;
+#endif
+
+    return drops;
+}
+
+static inline bool is_overrun(qtipSpscContext_t* pContext, qtipSize_t front, size_t drops)
+{
+    bool overrun = false;
+
+#ifndef DISABLE_OVERWRITE
+    if (pContext->overwrite)
+    {
+        // The copy must be complete before the counters are checked again
+        atomic_thread_fence(memory_order_acquire);
+        overrun = (atomic_load_explicit(&pContext->drops, memory_order_relaxed) != drops) ||
+                  (atomic_load_explicit(&pContext->front, memory_order_relaxed) != front);
+    }
+#else
+    (void) pContext;
+    (void) front;
+    (void) drops;
+#endif
+
+    return overrun;
+}
+
+static bool pop_items(qtipSpscContext_t* pContext, qtipSize_t front, void* pItems, qtipSize_t n)
+{
+    const qtipSize_t next = advance_counter(pContext, front, n);
+    const size_t drops    = begin_read(pContext);
+    bool popped           = true;
+
+    read_items(pContext, front, pItems, n);
+#ifndef DISABLE_OVERWRITE
+    if (pContext->overwrite)
+    {
+        // A drop during the copy may have torn it, and the swap only claims items that were not dropped since
+        qtipSize_t expected = front;
+        popped              = !is_overrun(pContext, front, drops) &&
+                 atomic_compare_exchange_strong_explicit(
+                     &pContext->front, &expected, next, memory_order_acq_rel, memory_order_relaxed);
+    }
+    else
+    {
+        atomic_store_explicit(&pContext->front, next, memory_order_release);
+    }
+#else
+    (void) drops;
+    atomic_store_explicit(&pContext->front, next, memory_order_release);
+#endif
+
+    if (popped)
+    {
+#ifndef DISABLE_WAIT
+        qtip_wait_notify(&pContext->notFull);
+#endif
+
+#ifndef DISABLE_TELEMETRY
+        atomic_store_explicit(&pContext->processed,
+                              atomic_load_explicit(&pContext->processed, memory_order_relaxed) + n,
+                              memory_order_relaxed);
+#endif
+    }
+
+    return popped;
+}
+
+#ifndef DISABLE_OVERWRITE
+
+static void drop_front(qtipSpscContext_t* pContext)
+{
+    // count_free just reloaded the front, which the consumer may have moved since
+    qtipSize_t front = pContext->frontCache;
+
+    // The attempt is published before the slot can be reused, so a consumer copying it retries
+    atomic_store_explicit(
+        &pContext->drops, atomic_load_explicit(&pContext->drops, memory_order_relaxed) + 1U, memory_order_relaxed);
+
+    if (atomic_compare_exchange_strong_explicit(&pContext->front,
+                                                &front,
+                                                advance_counter(pContext, front, 1U),
+                                                memory_order_acq_rel,
+                                                memory_order_acquire))
+    {
+        front = advance_counter(pContext, front, 1U);
+        atomic_store_explicit(&pContext->overwritten,
+                              atomic_load_explicit(&pContext->overwritten, memory_order_relaxed) + 1U,
+                              memory_order_relaxed);
+    }
+    pContext->frontCache = front;
+}
+
+#endif // DISABLE_OVERWRITE
+
+static qtipStatus_t put_item(qtipSpscContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status   = QTIP_STATUS_OK;
+    const qtipSize_t rear = atomic_load_explicit(&pContext->rear, memory_order_relaxed);
+    qtipSize_t room       = count_free(pContext, rear, 1U);
+
+#ifndef DISABLE_OVERWRITE
+    if ((room == 0U) && pContext->overwrite)
+    {
+        drop_front(pContext);
+        room = 1U;
+    }
+#endif
+
+    if (room > 0U)
+    {
+        put_items(pContext, rear, pItem, 1U);
+    }
+    else
+    {
+        status = QTIP_STATUS_FULL;
+    }
+
+    return status;
+}
+
+static qtipStatus_t pop_item(qtipSpscContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+    bool popped         = false;
+
+    while ((status == QTIP_STATUS_OK) && !popped)
+    {
+        const qtipSize_t front = load_front(pContext);
+
+        if (count_available(pContext, front, 1U) > 0U)
+        {
+            popped = pop_items(pContext, front, pItem, 1U);
+        }
+        else
+        {
+            status = QTIP_STATUS_EMPTY;
+        }
+    }
+
+    return status;
+}
+
+#ifndef DISABLE_WAIT
+
+// The retries of a blocking call are not rejections, so they skip the statistics
+static qtipStatus_t put_operation(void* pContext, void* pItem)
+{
+    return put_item(pContext, pItem);
+}
+
+static qtipStatus_t pop_operation(void* pContext, void* pItem)
+{
+    return pop_item(pContext, pItem);
+}
+
+#endif // DISABLE_WAIT
+
+/*
+ * Public API
+ */
+
+qtipStatus_t qtip_spsc_init(qtipSpscContext_t* pContext, void* pBuffer, qtipSize_t maxItems, size_t itemSize)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pBuffer));
+    status = CHECK_STATUS(status, (maxItems > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(status, (itemSize > 0U) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+    status = CHECK_STATUS(
+        status, (maxItems <= (qtipSize_t) (((qtipSize_t) -1) / 2U)) ? QTIP_STATUS_OK : QTIP_STATUS_INVALID_SIZE);
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        pContext->start      = pBuffer;
+        pContext->maxItems   = maxItems;
+        pContext->itemSize   = itemSize;
+#ifndef DISABLE_OVERWRITE
+        pContext->overwrite = false;
+        atomic_init(&pContext->overwritten, 0U);
+        atomic_init(&pContext->drops, 0U);
+#endif
+        pContext->frontCache = 0U;
+        pContext->rearCache  = 0U;
+        atomic_init(&pContext->rear, 0U);
+        atomic_init(&pContext->front, 0U);
+#ifndef DISABLE_TELEMETRY
+        atomic_init(&pContext->total, 0U);
+        atomic_init(&pContext->processed, 0U);
+#endif
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+        atomic_init(&pContext->highWatermark, 0U);
+        atomic_init(&pContext->full, 0U);
+        atomic_init(&pContext->empty, 0U);
+        for (size_t i = 0U; i < STATS_BUCKETS; i++)
+        {
+            atomic_init(&pContext->histogram[i], 0U);
+        }
+        pContext->sampleCountdown = 1U;
+        memset(&pContext->statsBase, 0, sizeof(pContext->statsBase));
+#endif
+#ifndef DISABLE_WAIT
+        qtip_wait_init(&pContext->notEmpty);
+        qtip_wait_init(&pContext->notFull);
+#endif
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_spsc_put(qtipSpscContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = count_rejection(pContext, put_item(pContext, pItem));
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_spsc_pop(qtipSpscContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = count_rejection(pContext, pop_item(pContext, pItem));
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_spsc_put_up_to_n(qtipSpscContext_t* pContext, void* pItems, qtipSize_t n, qtipSize_t* pPut)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItems));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pPut));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const qtipSize_t rear = atomic_load_explicit(&pContext->rear, memory_order_relaxed);
+        const qtipSize_t room = count_free(pContext, rear, n);
+        const qtipSize_t qty  = (n < room) ? n : room;
+
+        if (qty > 0U)
+        {
+            put_items(pContext, rear, pItems, qty);
+        }
+
+        status = ((qty > 0U) || (n == 0U)) ? QTIP_STATUS_OK : QTIP_STATUS_FULL;
+        *pPut  = qty;
+    }
+
+    return count_rejection(pContext, status);
+}
+
+qtipStatus_t qtip_spsc_pop_up_to_n(qtipSpscContext_t* pContext, void* pItems, qtipSize_t n, qtipSize_t* pPopped)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+    bool popped         = false;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItems));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pPopped));
+#endif
+
+    while ((status == QTIP_STATUS_OK) && !popped)
+    {
+        const qtipSize_t front     = load_front(pContext);
+        const qtipSize_t available = count_available(pContext, front, n);
+        const qtipSize_t qty       = (n < available) ? n : available;
+
+        popped = (qty == 0U) || pop_items(pContext, front, pItems, qty);
+
+        status   = ((qty > 0U) || (n == 0U)) ? QTIP_STATUS_OK : QTIP_STATUS_EMPTY;
+        *pPopped = qty;
+    }
+
+    return count_rejection(pContext, status);
+}
+
+qtipStatus_t qtip_spsc_get_front(qtipSpscContext_t* pContext, void* pItem)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+    bool read           = false;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    while ((status == QTIP_STATUS_OK) && !read)
+    {
+        const qtipSize_t front = load_front(pContext);
+
+        if (count_available(pContext, front, 1U) > 0U)
+        {
+            const size_t drops = begin_read(pContext);
+
+            read_items(pContext, front, pItem, 1U);
+            read = !is_overrun(pContext, front, drops);
+        }
+        else
+        {
+            status = QTIP_STATUS_EMPTY;
+        }
+    }
+
+    return status;
+}
+
+#ifndef DISABLE_WAIT
+
+qtipStatus_t qtip_spsc_put_wait(qtipSpscContext_t* pContext, void* pItem, uint32_t timeoutUs, qtipWaitStrategy_t strategy)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = count_rejection(
+            pContext, qtip_wait_for(&pContext->notFull, strategy, timeoutUs, put_operation, pContext, pItem));
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_spsc_pop_wait(qtipSpscContext_t* pContext, void* pItem, uint32_t timeoutUs, qtipWaitStrategy_t strategy)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pItem));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        status = count_rejection(
+            pContext, qtip_wait_for(&pContext->notEmpty, strategy, timeoutUs, pop_operation, pContext, pItem));
+    }
+
+    return status;
+}
+
+#endif // DISABLE_WAIT
+
+qtipStatus_t qtip_spsc_count_items(qtipSpscContext_t* pContext, qtipSize_t* pResult)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        const qtipSize_t front = atomic_load_explicit(&pContext->front, memory_order_acquire);
+        const qtipSize_t rear  = atomic_load_explicit(&pContext->rear, memory_order_acquire);
+        const qtipSize_t qty   = counter_distance(pContext, front, rear);
+
+        *pResult = (qty < pContext->maxItems) ? qty : pContext->maxItems;
+    }
+
+    return status;
+}
+
+#ifndef DISABLE_OVERWRITE
+
+qtipStatus_t qtip_spsc_set_overwrite(qtipSpscContext_t* pContext, bool enabled)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        pContext->overwrite = enabled;
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_spsc_total_overwritten_items(qtipSpscContext_t* pContext, size_t* pResult)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        *pResult = atomic_load_explicit(&pContext->overwritten, memory_order_relaxed);
+    }
+
+    return status;
+}
+
+#endif // DISABLE_OVERWRITE
+
+#ifndef DISABLE_TELEMETRY
+
+qtipStatus_t qtip_spsc_total_enqueued_items(qtipSpscContext_t* pContext, size_t* pResult)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        *pResult = atomic_load_explicit(&pContext->total, memory_order_relaxed);
+    }
+
+    return status;
+}
+
+qtipStatus_t qtip_spsc_total_processed_items(qtipSpscContext_t* pContext, size_t* pResult)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pResult));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        *pResult = atomic_load_explicit(&pContext->processed, memory_order_relaxed);
+    }
+
+    return status;
+}
+
+#ifndef DISABLE_STATS
+
+qtipStatus_t qtip_spsc_get_stats(qtipSpscContext_t* pContext, qtipStats_t* pStats, bool reset)
+{
+    qtipStatus_t status = QTIP_STATUS_OK;
+
+#ifndef SKIP_ARG_CHECK
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pContext));
+    status = CHECK_STATUS(status, CHECK_NULL_PRT(pStats));
+#endif
+
+    if (status == QTIP_STATUS_OK)
+    {
+        pStats->highWatermark = reset ? atomic_exchange_explicit(&pContext->highWatermark, 0U, memory_order_relaxed)
+                                      : atomic_load_explicit(&pContext->highWatermark, memory_order_relaxed);
+        pStats->full          = read_counter(&pContext->full, &pContext->statsBase.full, reset);
+        pStats->empty         = read_counter(&pContext->empty, &pContext->statsBase.empty, reset);
+        pStats->locked        = 0U;
+
+        for (size_t i = 0U; i < STATS_BUCKETS; i++)
+        {
+            pStats->histogram[i] = read_counter(&pContext->histogram[i], &pContext->statsBase.histogram[i], reset);
+        }
+    }
+
+    return status;
+}
+
+#endif // DISABLE_STATS
+
+#endif // DISABLE_TELEMETRY
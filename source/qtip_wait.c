@@ -0,0 +1,141 @@
+/**
+ * @file qtip_wait.c
+ * @brief Wait strategies for the blocking operations of the concurrent queues
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#define _GNU_SOURCE
+
+#include "qtip_wait.h"
+#include "qtip_private.h"
+
+#ifndef DISABLE_WAIT
+
+#include <limits.h>
+#include <sched.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Private defines
+ */
+
+#define NS_PER_US 1000U
+#define NS_PER_S  1000000000U
+
+/*
+ * Private functions
+ */
+
+static inline void cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ volatile("yield");
+#endif
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return ((uint64_t) time.tv_sec * NS_PER_S) + (uint64_t) time.tv_nsec;
+}
+
+static inline bool is_retryable(qtipStatus_t status)
+{
+    return (status == QTIP_STATUS_FULL) || (status == QTIP_STATUS_EMPTY);
+}
+
+static void park(qtipWaiters_t* pWaiters, uint32_t sequence, uint64_t timeoutNs)
+{
+#ifdef __linux__
+    struct timespec timeout = {.tv_sec = (time_t) (timeoutNs / NS_PER_S), .tv_nsec = (long) (timeoutNs % NS_PER_S)};
+
+    (void) syscall(SYS_futex, &pWaiters->sequence, FUTEX_WAIT_PRIVATE, sequence, &timeout, NULL, 0);
+#else
+    (void) pWaiters;
+    (void) sequence;
+    (void) timeoutNs;
+    sched_yield();
+#endif
+}
+
+/*
+ * Library API
+ */
+
+void qtip_wait_init(qtipWaiters_t* pWaiters)
+{
+    atomic_init(&pWaiters->sequence, 0U);
+    atomic_init(&pWaiters->waiters, 0U);
+}
+
+void qtip_wait_wake(qtipWaiters_t* pWaiters)
+{
+    atomic_fetch_add_explicit(&pWaiters->sequence, 1U, memory_order_release);
+#ifdef __linux__
+    (void) syscall(SYS_futex, &pWaiters->sequence, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+qtipStatus_t qtip_wait_for(qtipWaiters_t* pWaiters,
+                           qtipWaitStrategy_t strategy,
+                           uint32_t timeoutUs,
+                           qtipWaitOperation_t operation,
+                           void* pContext,
+                           void* pItem)
+{
+    qtipStatus_t status     = operation(pContext, pItem);
+    const bool forever      = timeoutUs == QTIP_WAIT_FOREVER;
+    const uint64_t deadline = now_ns() + (uint64_t) timeoutUs * NS_PER_US;
+    uint32_t spins          = 0U;
+
+    while (is_retryable(status) && (timeoutUs > 0U))
+    {
+        if ((strategy == QTIP_WAIT_SPIN) || (spins < WAIT_SPIN_COUNT))
+        {
+            cpu_relax();
+            spins++;
+        }
+        else if (strategy == QTIP_WAIT_YIELD)
+        {
+            sched_yield();
+        }
+        else
+        {
+            atomic_fetch_add_explicit(&pWaiters->waiters, 1U, memory_order_seq_cst);
+            const uint32_t sequence = atomic_load_explicit(&pWaiters->sequence, memory_order_acquire);
+
+            status = operation(pContext, pItem);
+            if (is_retryable(status))
+            {
+                const uint64_t now = now_ns();
+                park(pWaiters, sequence, forever ? NS_PER_S : ((deadline > now) ? (deadline - now) : 0U));
+            }
+            atomic_fetch_sub_explicit(&pWaiters->waiters, 1U, memory_order_relaxed);
+
+            if (!is_retryable(status))
+            {
+                break;
+            }
+        }
+
+        status = operation(pContext, pItem);
+        if (!forever && is_retryable(status) && (now_ns() >= deadline))
+        {
+            break;
+        }
+    }
+
+    return status;
+}
+
+#endif // DISABLE_WAIT
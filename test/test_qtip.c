@@ -6,8 +6,10 @@
  */
 
 #include "qtip.h"
+#include "qtip_fast.h"
 #include "unity.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #define QTIP_ASSERT_OK(exp)           TEST_ASSERT(QTIP_STATUS_OK == (exp))
@@ -19,14 +21,25 @@
 
 #define QTIP_ASSERT_ITEM(expected, actual) TEST_ASSERT_EQUAL_size_t((expected), (actual))
 
+#ifdef POWER_OF_TWO
+#define QUEUE_SIZE 8U
+#else
 #define QUEUE_SIZE 10U
+#endif
+
+#define LARGE_QUEUE_SIZE ((((qtipSize_t) -1) < 256U) ? 128U : 256U)
 
 typedef uint32_t type_t;
 
 qtipContext_t context;
+QTIP_DEFINE_QUEUE(typedQueue, type_t, QUEUE_SIZE)
 type_t queue[QUEUE_SIZE];
 type_t buffer[QUEUE_SIZE];
 
+#ifndef DISABLE_GROW
+static size_t allocations;
+#endif
+
 void setUp(void)
 {
     qtip_init(&context, queue, QUEUE_SIZE, sizeof(type_t));
@@ -232,6 +245,834 @@ void test_pop_index(void) // NOLINT(readability-function-cognitive-complexity)
     QTIP_ASSERT_ITEM(4U, item);
 }
 
+void test_put_pop_n(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t items[QUEUE_SIZE] = {0U};
+    qtipSize_t size          = 0U;
+
+    for (int i = 0; i < QUEUE_SIZE; i++)
+    {
+        items[i] = i;
+    }
+
+    QTIP_ASSERT_OK(qtip_put_n(&context, items, QUEUE_SIZE - 1U));
+    QTIP_ASSERT_FULL(qtip_put_n(&context, items, 2U));
+    QTIP_ASSERT_OK(qtip_count_items(&context, &size));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE - 1U, size);
+
+    QTIP_ASSERT_EMPTY(qtip_pop_n(&context, buffer, QUEUE_SIZE));
+    QTIP_ASSERT_OK(qtip_pop_n(&context, buffer, QUEUE_SIZE - 1U));
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(items, buffer, QUEUE_SIZE - 1U);
+    QTIP_ASSERT_EMPTY(qtip_pop(&context, &items[0U]));
+}
+
+void test_put_pop_n_rollover(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    const qtipSize_t firstPut = QUEUE_SIZE - 3U;
+    const qtipSize_t firstPop = firstPut - 1U;
+    type_t items[QUEUE_SIZE]  = {0U};
+    type_t item               = 0U;
+
+    for (int i = 0; i < QUEUE_SIZE; i++)
+    {
+        items[i] = i;
+    }
+
+    QTIP_ASSERT_OK(qtip_put_n(&context, items, firstPut));
+    QTIP_ASSERT_OK(qtip_pop_n(&context, buffer, firstPop));
+    QTIP_ASSERT_OK(qtip_put_n(&context, items, QUEUE_SIZE - 1U));
+
+    QTIP_ASSERT_OK(qtip_get_rear(&context, &item));
+    QTIP_ASSERT_ITEM(QUEUE_SIZE - 2U, item);
+
+    QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    QTIP_ASSERT_ITEM(firstPut - 1U, item);
+    QTIP_ASSERT_OK(qtip_pop_n(&context, buffer, QUEUE_SIZE - 1U));
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(items, buffer, QUEUE_SIZE - 1U);
+}
+
+void test_put_pop_up_to_n(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t items[QUEUE_SIZE + 2U] = {0U};
+    qtipSize_t qty                = 0U;
+
+    for (int i = 0; i < QUEUE_SIZE + 2U; i++)
+    {
+        items[i] = i;
+    }
+
+    QTIP_ASSERT_OK(qtip_put_up_to_n(&context, items, QUEUE_SIZE + 2U, &qty));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE, qty);
+    QTIP_ASSERT_FULL(qtip_put_up_to_n(&context, items, 1U, &qty));
+    TEST_ASSERT_EQUAL_size_t(0U, qty);
+
+    QTIP_ASSERT_OK(qtip_pop_up_to_n(&context, buffer, 4U, &qty));
+    TEST_ASSERT_EQUAL_size_t(4U, qty);
+    QTIP_ASSERT_OK(qtip_pop_up_to_n(&context, buffer, QUEUE_SIZE, &qty));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE - 4U, qty);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(&items[4U], buffer, QUEUE_SIZE - 4U);
+    QTIP_ASSERT_EMPTY(qtip_pop_up_to_n(&context, buffer, 1U, &qty));
+    TEST_ASSERT_EQUAL_size_t(0U, qty);
+}
+
+void test_remove_index_rollover(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    const qtipSize_t firstPop = 3U;
+    qtipSize_t size           = 0U;
+    type_t item               = 0U;
+
+    for (int i = 0; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+    for (int i = 0; i < firstPop; i++)
+    {
+        QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    }
+    for (int i = QUEUE_SIZE; i < QUEUE_SIZE + firstPop; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+
+    QTIP_ASSERT_INVALID_SIZE(qtip_remove_item_index(&context, QUEUE_SIZE));
+    QTIP_ASSERT_OK(qtip_remove_item_index(&context, QUEUE_SIZE - 2U));
+    QTIP_ASSERT_OK(qtip_count_items(&context, &size));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE - 1U, size);
+
+    QTIP_ASSERT_OK(qtip_get_rear(&context, &item));
+    QTIP_ASSERT_ITEM(QUEUE_SIZE + firstPop - 1U, item);
+
+    item = QUEUE_SIZE + firstPop;
+    QTIP_ASSERT_OK(qtip_put(&context, &item));
+    QTIP_ASSERT_OK(qtip_peek(&context, buffer, &size));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE, size);
+    QTIP_ASSERT_ITEM(firstPop, buffer[0U]);
+    QTIP_ASSERT_ITEM(QUEUE_SIZE + firstPop - 3U, buffer[QUEUE_SIZE - 3U]);
+    QTIP_ASSERT_ITEM(QUEUE_SIZE + firstPop - 1U, buffer[QUEUE_SIZE - 2U]);
+    QTIP_ASSERT_ITEM(QUEUE_SIZE + firstPop, buffer[QUEUE_SIZE - 1U]);
+}
+
+void test_reserve_commit(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t* pSlot   = NULL;
+    type_t item     = 0U;
+    qtipSize_t size = 0U;
+
+    QTIP_ASSERT_EMPTY(qtip_commit(&context));
+    QTIP_ASSERT_OK(qtip_reserve(&context, (void**) &pSlot));
+    QTIP_ASSERT_OK(qtip_purge(&context));
+    QTIP_ASSERT_EMPTY(qtip_commit(&context));
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_reserve(&context, (void**) &pSlot));
+        *pSlot = i;
+        QTIP_ASSERT_OK(qtip_commit(&context));
+    }
+    QTIP_ASSERT_FULL(qtip_reserve(&context, (void**) &pSlot));
+    QTIP_ASSERT_EMPTY(qtip_commit(&context));
+
+    QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    QTIP_ASSERT_ITEM(0U, item);
+    QTIP_ASSERT_OK(qtip_reserve(&context, (void**) &pSlot));
+    TEST_ASSERT_EQUAL_PTR(&queue[0U], pSlot);
+    *pSlot = QUEUE_SIZE;
+    QTIP_ASSERT_OK(qtip_commit(&context));
+    QTIP_ASSERT_EMPTY(qtip_commit(&context));
+
+    QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    QTIP_ASSERT_EMPTY(qtip_commit(&context));
+    QTIP_ASSERT_OK(qtip_count_items(&context, &size));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE - 1U, size);
+
+    QTIP_ASSERT_OK(qtip_get_rear(&context, &item));
+    QTIP_ASSERT_ITEM(QUEUE_SIZE, item);
+}
+
+void test_acquire_release(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t* pItem   = NULL;
+    qtipSize_t size = 0U;
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_acquire(&context, (void**) &pItem));
+        QTIP_ASSERT_ITEM(i, *pItem);
+        QTIP_ASSERT_OK(qtip_release(&context));
+    }
+    QTIP_ASSERT_EMPTY(qtip_acquire(&context, (void**) &pItem));
+    QTIP_ASSERT_EMPTY(qtip_release(&context));
+    QTIP_ASSERT_OK(qtip_count_items(&context, &size));
+    TEST_ASSERT_EQUAL_size_t(0U, size);
+}
+
+void test_get_view(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t* pItems   = NULL;
+    qtipSize_t count = 0U;
+    type_t item      = 0U;
+
+    QTIP_ASSERT_EMPTY(qtip_get_view(&context, (void**) &pItems, &count));
+    QTIP_ASSERT_EMPTY(qtip_release_n(&context, 1U));
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+    QTIP_ASSERT_OK(qtip_release_n(&context, QUEUE_SIZE - 2U));
+    item = QUEUE_SIZE;
+    QTIP_ASSERT_OK(qtip_put(&context, &item));
+
+    QTIP_ASSERT_OK(qtip_get_view(&context, (void**) &pItems, &count));
+    TEST_ASSERT_EQUAL_PTR(&queue[QUEUE_SIZE - 2U], pItems);
+    TEST_ASSERT_EQUAL_size_t(2U, count);
+    QTIP_ASSERT_ITEM(QUEUE_SIZE - 2U, pItems[0U]);
+    QTIP_ASSERT_ITEM(QUEUE_SIZE - 1U, pItems[1U]);
+    QTIP_ASSERT_OK(qtip_release_n(&context, count));
+
+    QTIP_ASSERT_OK(qtip_get_view(&context, (void**) &pItems, &count));
+    TEST_ASSERT_EQUAL_PTR(&queue[0U], pItems);
+    TEST_ASSERT_EQUAL_size_t(1U, count);
+    QTIP_ASSERT_ITEM(QUEUE_SIZE, pItems[0U]);
+    QTIP_ASSERT_EMPTY(qtip_release_n(&context, 2U));
+    QTIP_ASSERT_OK(qtip_release_n(&context, 1U));
+    QTIP_ASSERT_OK(qtip_count_items(&context, &count));
+    TEST_ASSERT_EQUAL_size_t(0U, count);
+}
+
+#ifndef DISABLE_GROW
+
+static void* counted_alloc(size_t size, void* pArg)
+{
+    (void) pArg;
+    allocations++;
+    return malloc(size);
+}
+
+static void counted_free(void* pBuffer, void* pArg)
+{
+    (void) pArg;
+    allocations--;
+    free(pBuffer);
+}
+
+void test_growable(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    const qtipAllocator_t allocator = {.alloc = counted_alloc, .free = counted_free, .pArg = NULL};
+    qtipContext_t growable;
+    type_t item = 0U;
+
+    QTIP_ASSERT_OK(qtip_init_growable(&growable, &allocator, 2U, 8U, sizeof(type_t), 2U));
+    for (type_t i = 0U; i < 2U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&growable, &i));
+    }
+    QTIP_ASSERT_OK(qtip_pop(&growable, &item));
+
+    // The queue is wrapped when it grows
+    for (type_t i = 2U; i <= 8U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&growable, &i));
+    }
+    TEST_ASSERT_EQUAL_size_t(8U, growable.maxItems);
+    QTIP_ASSERT_FULL(qtip_put(&growable, &item));
+
+    for (type_t i = 1U; i <= 8U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_pop(&growable, &item));
+        QTIP_ASSERT_ITEM(i, item);
+    }
+    TEST_ASSERT_EQUAL_size_t(4U, growable.maxItems);
+
+    QTIP_ASSERT_OK(qtip_free_growable(&growable));
+    TEST_ASSERT_EQUAL_size_t(0U, allocations);
+    QTIP_ASSERT_NULL_PTR(qtip_free_growable(&context));
+}
+
+#endif // DISABLE_GROW
+
+#ifndef DISABLE_TOMBSTONE
+
+void test_tombstones(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    uint8_t bitmap[QTIP_TOMBSTONE_BITMAP_SIZE(QUEUE_SIZE)];
+    const type_t expected[] = {1U, 3U, 4U, 100U, 101U};
+    type_t item             = 0U;
+    qtipSize_t size         = 0U;
+    void* pView             = NULL;
+
+    QTIP_ASSERT_OK(qtip_enable_tombstones(&context, bitmap, 0U));
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+
+    // Removed slots are skipped by the indexes and counts
+    QTIP_ASSERT_OK(qtip_remove_item_index(&context, 2U));
+    QTIP_ASSERT_OK(qtip_remove_item_index(&context, 4U));
+    TEST_ASSERT_EQUAL_size_t(2U, context.tombstones);
+    QTIP_ASSERT_OK(qtip_count_items(&context, &size));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE - 2U, size);
+    QTIP_ASSERT_OK(qtip_is_full(&context));
+    QTIP_ASSERT_OK(qtip_get_item_index(&context, 4U, &item));
+    QTIP_ASSERT_ITEM(6U, item);
+    QTIP_ASSERT_OK(qtip_get_pop_index(&context, 0U, &item));
+    QTIP_ASSERT_ITEM(0U, item);
+
+    // Removing the rear also drops the removed slots in front of it
+    QTIP_ASSERT_OK(qtip_count_items(&context, &size));
+    for (; size > 4U; size--)
+    {
+        QTIP_ASSERT_OK(qtip_remove_item_index(&context, size - 1U));
+    }
+    QTIP_ASSERT_OK(qtip_remove_item_index(&context, 3U));
+    TEST_ASSERT_EQUAL_size_t(1U, context.tombstones);
+
+    // Insertions into a full queue reclaim the removed slots
+    for (type_t i = 100U; i < 100U + QUEUE_SIZE - 3U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+    TEST_ASSERT_EQUAL_size_t(0U, context.tombstones);
+    QTIP_ASSERT_FULL(qtip_put(&context, &item));
+    QTIP_ASSERT_OK(qtip_remove_item_index(&context, 5U));
+    QTIP_ASSERT_OK(qtip_peek(&context, buffer, &size));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE - 1U, size);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, buffer, sizeof(expected) / sizeof(expected[0]));
+
+    // The view starts after a compaction, so it covers the items in order
+    QTIP_ASSERT_OK(qtip_remove_item_index(&context, 1U));
+    QTIP_ASSERT_OK(qtip_get_view(&context, &pView, &size));
+    TEST_ASSERT_EQUAL_size_t(0U, context.tombstones);
+    QTIP_ASSERT_ITEM(4U, ((type_t*) pView)[1]);
+
+    QTIP_ASSERT_OK(qtip_remove_item_index(&context, 2U));
+    QTIP_ASSERT_OK(qtip_release_n(&context, 2U));
+    QTIP_ASSERT_OK(qtip_pop_n(&context, &item, 1U));
+    QTIP_ASSERT_ITEM(101U, item);
+    QTIP_ASSERT_OK(qtip_compact(&context));
+}
+
+void test_tombstone_lookup(void)
+{
+    static type_t largeQueue[LARGE_QUEUE_SIZE];
+    uint8_t bitmap[QTIP_TOMBSTONE_BITMAP_SIZE(LARGE_QUEUE_SIZE)];
+    qtipContext_t large;
+    type_t item     = 0U;
+    qtipSize_t size = 0U;
+
+    QTIP_ASSERT_OK(qtip_init(&large, largeQueue, LARGE_QUEUE_SIZE, sizeof(type_t)));
+    QTIP_ASSERT_OK(qtip_enable_tombstones(&large, bitmap, 0U));
+
+    // Start in the middle of the buffer, so the lookups cross its end
+    for (type_t i = 0U; i < 100U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&large, &i));
+        QTIP_ASSERT_OK(qtip_pop(&large, &item));
+    }
+    for (type_t i = 0U; i < LARGE_QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&large, &i));
+    }
+
+    // Remove every odd item but the rear, which spreads the removed slots over many words
+    for (qtipSize_t i = 1U; i < (LARGE_QUEUE_SIZE / 2U); i++)
+    {
+        QTIP_ASSERT_OK(qtip_remove_item_index(&large, i));
+    }
+    TEST_ASSERT_EQUAL_size_t((LARGE_QUEUE_SIZE / 2U) - 1U, large.tombstones);
+
+    QTIP_ASSERT_OK(qtip_count_items(&large, &size));
+    TEST_ASSERT_EQUAL_size_t((LARGE_QUEUE_SIZE / 2U) + 1U, size);
+    for (qtipSize_t i = 0U; i < size; i++)
+    {
+        QTIP_ASSERT_OK(qtip_get_item_index(&large, i, &item));
+        QTIP_ASSERT_ITEM((i < (size - 1U)) ? (2U * i) : (LARGE_QUEUE_SIZE - 1U), item);
+    }
+}
+
+void test_tombstone_threshold(void)
+{
+    uint8_t bitmap[QTIP_TOMBSTONE_BITMAP_SIZE(QUEUE_SIZE)];
+    type_t item = 0U;
+
+    QTIP_ASSERT_OK(qtip_enable_tombstones(&context, bitmap, 25U));
+    for (type_t i = 0U; i < 8U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+
+    QTIP_ASSERT_OK(qtip_remove_item_index(&context, 1U));
+    QTIP_ASSERT_OK(qtip_remove_item_index(&context, 1U));
+    TEST_ASSERT_EQUAL_size_t(2U, context.tombstones);
+    QTIP_ASSERT_OK(qtip_remove_item_index(&context, 1U));
+    TEST_ASSERT_EQUAL_size_t(0U, context.tombstones);
+
+    for (type_t i = 0U; i < 5U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_pop(&context, &item));
+        QTIP_ASSERT_ITEM((i == 0U) ? 0U : i + 3U, item);
+    }
+    QTIP_ASSERT_EMPTY(qtip_pop(&context, &item));
+}
+
+#endif // DISABLE_TOMBSTONE
+
+static bool is_odd(const void* pItem, void* pArg)
+{
+    (void) pArg;
+    return (*(const type_t*) pItem % 2U) != 0U;
+}
+
+void test_remove_if(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    qtipSize_t removed = 0U;
+    type_t item        = 0U;
+
+    QTIP_ASSERT_OK(qtip_remove_if(&context, is_odd, NULL, &removed));
+    TEST_ASSERT_EQUAL_size_t(0U, removed);
+
+    // Start past the middle of the buffer, so the items wrap around
+    for (type_t i = 0U; i < QUEUE_SIZE - 2U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+    QTIP_ASSERT_OK(qtip_pop_n(&context, buffer, QUEUE_SIZE - 3U));
+    for (type_t i = 0U; i < QUEUE_SIZE - 1U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+
+    QTIP_ASSERT_OK(qtip_remove_if(&context, is_odd, NULL, &removed));
+    TEST_ASSERT_EQUAL_size_t((QUEUE_SIZE + 1U) / 2U, removed);
+    for (type_t i = 0U; i < QUEUE_SIZE - 1U; i += 2U)
+    {
+        QTIP_ASSERT_OK(qtip_pop(&context, &item));
+        QTIP_ASSERT_ITEM(i, item);
+    }
+    QTIP_ASSERT_EMPTY(qtip_pop(&context, &item));
+
+    for (type_t i = 1U; i < QUEUE_SIZE; i += 2U)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+    QTIP_ASSERT_OK(qtip_remove_if(&context, is_odd, NULL, &removed));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE / 2U, removed);
+    QTIP_ASSERT_EMPTY(qtip_pop(&context, &item));
+}
+
+void test_extract_if(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    qtipContext_t target;
+    type_t targetQueue[2U];
+    qtipSize_t moved = 0U;
+    type_t item      = 0U;
+
+    QTIP_ASSERT_OK(qtip_init(&target, targetQueue, 2U, sizeof(type_t)));
+    for (type_t i = 0U; i < 6U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+
+    // The target only takes two of the three odd items
+    QTIP_ASSERT_FULL(qtip_extract_if(&context, &target, is_odd, NULL, &moved));
+    TEST_ASSERT_EQUAL_size_t(2U, moved);
+    QTIP_ASSERT_OK(qtip_pop(&target, &item));
+    QTIP_ASSERT_ITEM(1U, item);
+    QTIP_ASSERT_OK(qtip_pop(&target, &item));
+    QTIP_ASSERT_ITEM(3U, item);
+
+    QTIP_ASSERT_OK(qtip_extract_if(&context, &target, is_odd, NULL, &moved));
+    TEST_ASSERT_EQUAL_size_t(1U, moved);
+    QTIP_ASSERT_OK(qtip_get_front(&target, &item));
+    QTIP_ASSERT_ITEM(5U, item);
+
+    for (type_t i = 0U; i < 6U; i += 2U)
+    {
+        QTIP_ASSERT_OK(qtip_pop(&context, &item));
+        QTIP_ASSERT_ITEM(i, item);
+    }
+    QTIP_ASSERT_EMPTY(qtip_pop(&context, &item));
+}
+
+void test_deque(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    const type_t front[] = {10U, 11U, 12U};
+    type_t item          = 0U;
+
+    QTIP_ASSERT_EMPTY(qtip_pop_back(&context, &item));
+
+    // Used as a stack
+    for (type_t i = 0U; i < 3U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+    for (type_t i = 3U; i > 0U; i--)
+    {
+        QTIP_ASSERT_OK(qtip_pop_back(&context, &item));
+        QTIP_ASSERT_ITEM(i - 1U, item);
+    }
+    QTIP_ASSERT_EMPTY(qtip_pop_back(&context, &item));
+
+    // Items pushed at the front of an empty queue wrap around the start of the buffer
+    item = 1U;
+    QTIP_ASSERT_OK(qtip_push_front(&context, &item));
+    item = 2U;
+    QTIP_ASSERT_OK(qtip_put(&context, &item));
+    QTIP_ASSERT_OK(qtip_push_front_n(&context, (void*) front, 3U));
+    QTIP_ASSERT_OK(qtip_get_front(&context, &item));
+    QTIP_ASSERT_ITEM(10U, item);
+    QTIP_ASSERT_OK(qtip_get_rear(&context, &item));
+    QTIP_ASSERT_ITEM(2U, item);
+
+    QTIP_ASSERT_FULL(qtip_push_front_n(&context, buffer, QUEUE_SIZE - 4U));
+    QTIP_ASSERT_OK(qtip_push_front_n(&context, buffer, QUEUE_SIZE - 5U));
+    QTIP_ASSERT_FULL(qtip_push_front(&context, &item));
+    QTIP_ASSERT_OK(qtip_pop_n(&context, buffer, QUEUE_SIZE - 5U));
+
+    QTIP_ASSERT_EMPTY(qtip_pop_back_n(&context, buffer, 6U));
+    QTIP_ASSERT_OK(qtip_pop_back_n(&context, buffer, 4U));
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(front + 1U, buffer, 2U);
+    QTIP_ASSERT_ITEM(1U, buffer[2]);
+    QTIP_ASSERT_ITEM(2U, buffer[3]);
+    QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    QTIP_ASSERT_ITEM(10U, item);
+    QTIP_ASSERT_EMPTY(qtip_pop(&context, &item));
+}
+
+#ifndef DISABLE_OVERWRITE
+
+void test_overwrite(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    size_t overwritten = 0U;
+    type_t item        = 0U;
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+    QTIP_ASSERT_FULL(qtip_put(&context, &item));
+
+    QTIP_ASSERT_OK(qtip_set_overwrite(&context, true));
+    for (type_t i = QUEUE_SIZE; i < QUEUE_SIZE + 3U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+    QTIP_ASSERT_OK(qtip_total_overwritten_items(&context, &overwritten));
+    TEST_ASSERT_EQUAL_size_t(3U, overwritten);
+    QTIP_ASSERT_OK(qtip_get_rear(&context, &item));
+    QTIP_ASSERT_ITEM(QUEUE_SIZE + 2U, item);
+
+    for (type_t i = 3U; i < QUEUE_SIZE + 3U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_pop(&context, &item));
+        QTIP_ASSERT_ITEM(i, item);
+    }
+    QTIP_ASSERT_EMPTY(qtip_pop(&context, &item));
+}
+
+#endif // DISABLE_OVERWRITE
+
+#ifndef DISABLE_SOJOURN
+
+static uint64_t read_time(void* pArg)
+{
+    return *(uint64_t*) pArg;
+}
+
+void test_sojourn(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    qtipSojourn_t tracking;
+    uint64_t timestamps[QUEUE_SIZE];
+    uint64_t now     = 100U;
+    uint64_t sojourn = 0U;
+    uint64_t result  = 0U;
+    bool late        = true;
+    type_t item      = 0U;
+
+    QTIP_ASSERT_OK(qtip_enable_sojourn(&context, &tracking, timestamps, read_time, &now));
+    QTIP_ASSERT_EMPTY(qtip_get_sojourn_percentile(&context, 50U, &result));
+
+    for (type_t i = 0U; i < 3U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+        now += 5U;
+    }
+
+    now = 120U;
+    QTIP_ASSERT_OK(qtip_pop_timed(&context, &item, &sojourn, &late));
+    QTIP_ASSERT_ITEM(0U, item);
+    TEST_ASSERT_EQUAL_UINT64(20U, sojourn);
+    TEST_ASSERT_FALSE(late);
+    QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    QTIP_ASSERT_OK(qtip_pop_n(&context, &item, 1U));
+
+    // Sojourn times of 10 and 15 share the bucket up to 15, and 20 is in the bucket up to 31
+    QTIP_ASSERT_OK(qtip_get_sojourn_percentile(&context, 0U, &result));
+    TEST_ASSERT_EQUAL_UINT64(15U, result);
+    QTIP_ASSERT_OK(qtip_get_sojourn_percentile(&context, 50U, &result));
+    TEST_ASSERT_EQUAL_UINT64(15U, result);
+    QTIP_ASSERT_OK(qtip_get_sojourn_percentile(&context, 100U, &result));
+    TEST_ASSERT_EQUAL_UINT64(31U, result);
+
+    // Removing an item from the middle moves the timestamps along with the items
+    for (type_t i = 0U; i < 3U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+        now += 10U;
+    }
+    QTIP_ASSERT_OK(qtip_remove_item_index(&context, 1U));
+    QTIP_ASSERT_OK(qtip_pop_timed(&context, &item, &sojourn, &late));
+    TEST_ASSERT_EQUAL_UINT64(30U, sojourn);
+    QTIP_ASSERT_OK(qtip_pop_timed(&context, &item, &sojourn, &late));
+    QTIP_ASSERT_ITEM(2U, item);
+    TEST_ASSERT_EQUAL_UINT64(10U, sojourn);
+
+    QTIP_ASSERT_OK(qtip_reset_sojourns(&context));
+    QTIP_ASSERT_EMPTY(qtip_get_sojourn_percentile(&context, 50U, &result));
+    QTIP_ASSERT_EMPTY(qtip_pop_timed(&context, &item, &sojourn, &late));
+}
+
+void test_sojourn_removals(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    qtipSojourn_t tracking;
+    uint64_t timestamps[QUEUE_SIZE] = {0U};
+    uint64_t now                    = 0U;
+    uint64_t result                 = 0U;
+    size_t late                     = 0U;
+    type_t items[2]                 = {0U};
+    type_t item                     = 0U;
+    void* pItem                     = NULL;
+
+    QTIP_ASSERT_OK(qtip_enable_sojourn(&context, &tracking, timestamps, read_time, &now));
+    for (type_t i = 0U; i < 3U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+    now  = 90U;
+    item = 3U;
+    QTIP_ASSERT_OK(qtip_fast_put(&context, &item));
+
+    // Back pops and releases record the sojourn times too, and the fast put stamps its item
+    now = 100U;
+    QTIP_ASSERT_OK(qtip_pop_back(&context, &item));
+    QTIP_ASSERT_ITEM(3U, item);
+    QTIP_ASSERT_OK(qtip_acquire(&context, &pItem));
+    QTIP_ASSERT_OK(qtip_release(&context));
+    QTIP_ASSERT_OK(qtip_release_n(&context, 2U));
+    QTIP_ASSERT_OK(qtip_get_sojourn_percentile(&context, 25U, &result));
+    TEST_ASSERT_EQUAL_UINT64(15U, result);
+    QTIP_ASSERT_OK(qtip_get_sojourn_percentile(&context, 50U, &result));
+    TEST_ASSERT_EQUAL_UINT64(127U, result);
+
+    // Bulk pops run the policy, but always leave the items they asked for
+    QTIP_ASSERT_OK(qtip_set_codel(&context, 10U, 100U, true));
+    now = 1000U;
+    for (type_t i = 0U; i < 6U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+    now = 1050U;
+    QTIP_ASSERT_OK(qtip_pop_n(&context, items, 1U));
+    now = 1200U;
+    QTIP_ASSERT_OK(qtip_pop_n(&context, items, 2U));
+    QTIP_ASSERT_ITEM(2U, items[0]);
+    QTIP_ASSERT_ITEM(3U, items[1]);
+
+    // A released item was already used in place, so it is only counted as late
+    now = 1300U;
+    QTIP_ASSERT_OK(qtip_acquire(&context, &pItem));
+    QTIP_ASSERT_ITEM(4U, *(type_t*) pItem);
+    QTIP_ASSERT_OK(qtip_release(&context));
+    QTIP_ASSERT_OK(qtip_total_late_items(&context, &late));
+    TEST_ASSERT_EQUAL_size_t(2U, late);
+    QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    QTIP_ASSERT_ITEM(5U, item);
+}
+
+void test_codel(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    qtipSojourn_t tracking;
+    uint64_t timestamps[QUEUE_SIZE];
+    uint64_t now     = 0U;
+    uint64_t sojourn = 0U;
+    size_t late      = 0U;
+    bool isLate      = false;
+    type_t item      = 0U;
+
+    QTIP_ASSERT_OK(qtip_enable_sojourn(&context, &tracking, timestamps, read_time, &now));
+    QTIP_ASSERT_OK(qtip_set_codel(&context, 10U, 100U, true));
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+
+    // Above the target, but not for a whole interval yet
+    now = 50U;
+    QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    QTIP_ASSERT_ITEM(0U, item);
+
+    // Above the target for an interval, so item 1 is dropped and the next drop is due at 300
+    now = 200U;
+    QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    QTIP_ASSERT_ITEM(2U, item);
+    now = 250U;
+    QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    QTIP_ASSERT_ITEM(3U, item);
+    now = 300U;
+    QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    QTIP_ASSERT_ITEM(5U, item);
+    QTIP_ASSERT_OK(qtip_total_late_items(&context, &late));
+    TEST_ASSERT_EQUAL_size_t(2U, late);
+
+    // Flagged items are returned instead
+    QTIP_ASSERT_OK(qtip_purge(&context));
+    QTIP_ASSERT_OK(qtip_set_codel(&context, 10U, 100U, false));
+    now = 1000U;
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+    now = 1050U;
+    QTIP_ASSERT_OK(qtip_pop_timed(&context, &item, &sojourn, &isLate));
+    TEST_ASSERT_FALSE(isLate);
+    now = 1200U;
+    QTIP_ASSERT_OK(qtip_pop_timed(&context, &item, &sojourn, &isLate));
+    QTIP_ASSERT_ITEM(1U, item);
+    TEST_ASSERT_EQUAL_UINT64(200U, sojourn);
+    TEST_ASSERT_TRUE(isLate);
+    QTIP_ASSERT_OK(qtip_total_late_items(&context, &late));
+    TEST_ASSERT_EQUAL_size_t(3U, late);
+}
+
+#endif // DISABLE_SOJOURN
+
+void test_typed_queue(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t item = 0U;
+
+    QTIP_ASSERT_EMPTY(typedQueue_pop(&item));
+    QTIP_ASSERT_EMPTY(typedQueue_get_front(&item));
+
+    for (type_t round = 0U; round < 3U; round++)
+    {
+        for (type_t i = 0U; i < QUEUE_SIZE - 1U; i++)
+        {
+            item = round + i;
+            QTIP_ASSERT_OK(typedQueue_put(&item));
+        }
+        TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE - 1U, typedQueue_count());
+
+        for (type_t i = 0U; i < QUEUE_SIZE - 1U; i++)
+        {
+            QTIP_ASSERT_OK(typedQueue_get_front(&item));
+            QTIP_ASSERT_ITEM(round + i, item);
+            QTIP_ASSERT_OK(typedQueue_pop(&item));
+            QTIP_ASSERT_ITEM(round + i, item);
+        }
+    }
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(typedQueue_put(&i));
+    }
+    QTIP_ASSERT_FULL(typedQueue_put(&item));
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(typedQueue_pop(&item));
+        QTIP_ASSERT_ITEM(i, item);
+    }
+    QTIP_ASSERT_EMPTY(typedQueue_pop(&item));
+}
+
+void test_fast(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t item     = 0U;
+    qtipSize_t size = 0U;
+
+    QTIP_ASSERT_EMPTY(qtip_fast_pop(&context, &item));
+    QTIP_ASSERT_EMPTY(qtip_fast_get_front(&context, &item));
+    QTIP_ASSERT_EMPTY(qtip_fast_get_rear(&context, &item));
+
+    for (type_t round = 0U; round < 3U; round++)
+    {
+        for (type_t i = 0U; i < QUEUE_SIZE - 1U; i++)
+        {
+            item = round + i;
+            QTIP_ASSERT_OK(qtip_fast_put(&context, &item));
+        }
+        QTIP_ASSERT_OK(qtip_fast_get_rear(&context, &item));
+        QTIP_ASSERT_ITEM(round + QUEUE_SIZE - 2U, item);
+
+        for (type_t i = 0U; i < QUEUE_SIZE - 1U; i++)
+        {
+            QTIP_ASSERT_OK(qtip_fast_get_front(&context, &item));
+            QTIP_ASSERT_ITEM(round + i, item);
+            QTIP_ASSERT_OK((i % 2U == 0U) ? qtip_fast_pop(&context, &item) : qtip_pop(&context, &item));
+            QTIP_ASSERT_ITEM(round + i, item);
+        }
+        TEST_ASSERT_TRUE(qtip_fast_is_empty(&context));
+    }
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK((i % 2U == 0U) ? qtip_fast_put(&context, &i) : qtip_put(&context, &i));
+    }
+    TEST_ASSERT_TRUE(qtip_fast_is_full(&context));
+    QTIP_ASSERT_FULL(qtip_fast_put(&context, &item));
+    QTIP_ASSERT_OK(qtip_count_items(&context, &size));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE, size);
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_fast_pop(&context, &item));
+        QTIP_ASSERT_ITEM(i, item);
+    }
+}
+
+#ifndef DISABLE_NOTIFY
+
+static void count_notification(void* pArg)
+{
+    (*(size_t*) pArg)++;
+}
+
+void test_notifier(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t item          = 0U;
+    size_t notifications = 0U;
+
+    QTIP_ASSERT_OK(qtip_set_notifier(&context, count_notification, &notifications, QUEUE_SIZE / 2U));
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+        TEST_ASSERT_EQUAL_size_t((i < (QUEUE_SIZE / 2U) - 1U) ? 1U : 2U, notifications);
+    }
+
+    QTIP_ASSERT_OK(qtip_pop_n(&context, buffer, QUEUE_SIZE - 1U));
+    QTIP_ASSERT_OK(qtip_put_n(&context, buffer, QUEUE_SIZE / 2U));
+    TEST_ASSERT_EQUAL_size_t(3U, notifications);
+
+    QTIP_ASSERT_OK(qtip_purge(&context));
+    QTIP_ASSERT_OK(qtip_fast_put(&context, &item));
+    TEST_ASSERT_EQUAL_size_t(4U, notifications);
+    QTIP_ASSERT_OK(qtip_fast_put(&context, &item));
+    TEST_ASSERT_EQUAL_size_t(4U, notifications);
+
+    QTIP_ASSERT_OK(qtip_set_notifier(&context, NULL, NULL, 0U));
+    QTIP_ASSERT_OK(qtip_purge(&context));
+    QTIP_ASSERT_OK(qtip_put(&context, &item));
+    TEST_ASSERT_EQUAL_size_t(4U, notifications);
+}
+
+#endif // DISABLE_NOTIFY
+
 void test_lock(void)
 {
     type_t item = 0;
@@ -265,6 +1106,63 @@ void test_telemetry(void)
     TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE, processed);
 }
 
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+
+void test_stats(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t item          = 0U;
+    void* pSlot          = NULL;
+    qtipStats_t stats    = {0};
+    qtipStats_t recorded = {0};
+
+    // A queue without statistics reports zeros
+    QTIP_ASSERT_OK(qtip_put(&context, &item));
+    QTIP_ASSERT_OK(qtip_get_stats(&context, &stats, false));
+    TEST_ASSERT_EQUAL_size_t(0U, stats.highWatermark);
+    QTIP_ASSERT_OK(qtip_pop(&context, &item));
+
+    QTIP_ASSERT_OK(qtip_enable_stats(&context, &recorded));
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+    QTIP_ASSERT_FULL(qtip_put(&context, &item));
+    QTIP_ASSERT_FULL(qtip_reserve(&context, &pSlot));
+
+    for (size_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    }
+    QTIP_ASSERT_EMPTY(qtip_pop(&context, &item));
+    QTIP_ASSERT_EMPTY(qtip_pop_back(&context, &item));
+
+    QTIP_ASSERT_OK(qtip_lock(&context));
+    QTIP_ASSERT_LOCKED(qtip_put(&context, &item));
+    QTIP_ASSERT_OK(qtip_unlock(&context));
+
+    QTIP_ASSERT_OK(qtip_get_stats(&context, &stats, true));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE, stats.highWatermark);
+    TEST_ASSERT_EQUAL_size_t(2U, stats.full);
+    TEST_ASSERT_EQUAL_size_t(2U, stats.empty);
+    TEST_ASSERT_EQUAL_size_t(1U, stats.locked);
+    // Fill levels 1, 2-3, 4-7 and 8 or more
+    TEST_ASSERT_EQUAL_size_t(1U, stats.histogram[0U]);
+    TEST_ASSERT_EQUAL_size_t(2U, stats.histogram[1U]);
+    TEST_ASSERT_EQUAL_size_t(4U, stats.histogram[2U]);
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE - 7U, stats.histogram[3U]);
+
+    QTIP_ASSERT_OK(qtip_put_n(&context, buffer, 3U));
+    QTIP_ASSERT_OK(qtip_get_stats(&context, &stats, false));
+    TEST_ASSERT_EQUAL_size_t(3U, stats.highWatermark);
+    TEST_ASSERT_EQUAL_size_t(0U, stats.full);
+    TEST_ASSERT_EQUAL_size_t(0U, stats.empty);
+    TEST_ASSERT_EQUAL_size_t(0U, stats.locked);
+    TEST_ASSERT_EQUAL_size_t(0U, stats.histogram[0U]);
+    TEST_ASSERT_EQUAL_size_t(1U, stats.histogram[1U]);
+}
+
+#endif // DISABLE_TELEMETRY && DISABLE_STATS
+
 void test_null_ptr(void) // NOLINT
 {
     QTIP_ASSERT_NULL_PTR(qtip_init(NULL, NULL, 0U, 0U));
@@ -282,12 +1180,81 @@ void test_null_ptr(void) // NOLINT
     QTIP_ASSERT_NULL_PTR(qtip_unlock(NULL));
     QTIP_ASSERT_NULL_PTR(qtip_total_enqueued_items(NULL, NULL));
     QTIP_ASSERT_NULL_PTR(qtip_total_processed_items(NULL, NULL));
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    QTIP_ASSERT_NULL_PTR(qtip_enable_stats(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_get_stats(NULL, NULL, false));
+#endif
+    QTIP_ASSERT_NULL_PTR(qtip_put_n(NULL, NULL, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_pop_n(NULL, NULL, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_put_up_to_n(NULL, NULL, 0U, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_pop_up_to_n(NULL, NULL, 0U, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_push_front(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_pop_back(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_push_front_n(NULL, NULL, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_pop_back_n(NULL, NULL, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_reserve(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_commit(NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_acquire(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_release(NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_get_view(NULL, NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_release_n(NULL, 0U));
+#ifndef DISABLE_GROW
+    QTIP_ASSERT_NULL_PTR(qtip_init_growable(NULL, NULL, 0U, 0U, 0U, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_free_growable(NULL));
+#endif
+#ifndef DISABLE_TOMBSTONE
+    QTIP_ASSERT_NULL_PTR(qtip_enable_tombstones(NULL, NULL, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_compact(NULL));
+#endif
+    QTIP_ASSERT_NULL_PTR(qtip_remove_if(NULL, NULL, NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_extract_if(NULL, NULL, NULL, NULL, NULL));
+#ifndef DISABLE_OVERWRITE
+    QTIP_ASSERT_NULL_PTR(qtip_set_overwrite(NULL, false));
+    QTIP_ASSERT_NULL_PTR(qtip_total_overwritten_items(NULL, NULL));
+#endif
+#ifndef DISABLE_SOJOURN
+    QTIP_ASSERT_NULL_PTR(qtip_enable_sojourn(NULL, NULL, NULL, NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_pop_timed(NULL, NULL, NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_get_sojourn_percentile(NULL, 0U, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_reset_sojourns(NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_set_codel(NULL, 0U, 0U, false));
+    QTIP_ASSERT_NULL_PTR(qtip_total_late_items(NULL, NULL));
+#endif
+#ifndef DISABLE_NOTIFY
+    QTIP_ASSERT_NULL_PTR(qtip_set_notifier(NULL, NULL, NULL, 0U));
+#endif
 }
 
 void test_invalid_size(void)
 {
+#ifndef DISABLE_GROW
+    const qtipAllocator_t allocator = {.alloc = counted_alloc, .free = counted_free, .pArg = NULL};
+#endif
+    qtipSize_t moved                = 0U;
+#ifndef DISABLE_SOJOURN
+    uint64_t result                 = 0U;
+#endif
+
     QTIP_ASSERT_INVALID_SIZE(qtip_init(&context, queue, 0U, sizeof(type_t)));
     QTIP_ASSERT_INVALID_SIZE(qtip_init(&context, queue, QUEUE_SIZE, 0U));
+#ifndef DISABLE_NOTIFY
+    QTIP_ASSERT_INVALID_SIZE(qtip_set_notifier(&context, NULL, NULL, QUEUE_SIZE + 1U));
+#endif
+#ifndef DISABLE_GROW
+    QTIP_ASSERT_INVALID_SIZE(qtip_init_growable(&context, &allocator, 4U, 2U, sizeof(type_t), 0U));
+#endif
+#ifndef DISABLE_TOMBSTONE
+    QTIP_ASSERT_INVALID_SIZE(qtip_enable_tombstones(&context, (uint8_t*) buffer, 101U));
+#endif
+    QTIP_ASSERT_INVALID_SIZE(qtip_extract_if(&context, &context, is_odd, NULL, &moved));
+#ifndef DISABLE_SOJOURN
+    QTIP_ASSERT_INVALID_SIZE(qtip_get_sojourn_percentile(&context, 101U, &result));
+    QTIP_ASSERT_INVALID_SIZE(qtip_set_codel(&context, 10U, 0U, false));
+    QTIP_ASSERT_INVALID_SIZE(qtip_set_codel(&context, 10U, 100U, false));
+#endif
+#ifdef POWER_OF_TWO
+    QTIP_ASSERT_INVALID_SIZE(qtip_init(&context, queue, QUEUE_SIZE - 1U, sizeof(type_t)));
+#endif
 }
 
 int main(void)
@@ -303,8 +1270,42 @@ int main(void)
     RUN_TEST(test_get_index);
     RUN_TEST(test_remove_index);
     RUN_TEST(test_pop_index);
+    RUN_TEST(test_put_pop_n);
+    RUN_TEST(test_put_pop_n_rollover);
+    RUN_TEST(test_put_pop_up_to_n);
+    RUN_TEST(test_remove_index_rollover);
+    RUN_TEST(test_deque);
+    RUN_TEST(test_reserve_commit);
+    RUN_TEST(test_acquire_release);
+    RUN_TEST(test_get_view);
+#ifndef DISABLE_GROW
+    RUN_TEST(test_growable);
+#endif
+#ifndef DISABLE_TOMBSTONE
+    RUN_TEST(test_tombstones);
+    RUN_TEST(test_tombstone_lookup);
+    RUN_TEST(test_tombstone_threshold);
+#endif
+    RUN_TEST(test_remove_if);
+    RUN_TEST(test_extract_if);
+#ifndef DISABLE_OVERWRITE
+    RUN_TEST(test_overwrite);
+#endif
+#ifndef DISABLE_SOJOURN
+    RUN_TEST(test_sojourn);
+    RUN_TEST(test_sojourn_removals);
+    RUN_TEST(test_codel);
+#endif
+    RUN_TEST(test_typed_queue);
+    RUN_TEST(test_fast);
+#ifndef DISABLE_NOTIFY
+    RUN_TEST(test_notifier);
+#endif
     RUN_TEST(test_lock);
     RUN_TEST(test_telemetry);
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    RUN_TEST(test_stats);
+#endif
     RUN_TEST(test_null_ptr);
     RUN_TEST(test_invalid_size);
     UNITY_END();
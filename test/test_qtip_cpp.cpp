@@ -0,0 +1,178 @@
+/**
+ * @file test_qtip_cpp.cpp
+ * @brief Unit tests for QTip C++ API
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#include "qtip.hpp"
+#include "unity.h"
+
+#include <memory>
+#include <string>
+
+#define QTIP_ASSERT_OK(exp)    TEST_ASSERT(QTIP_STATUS_OK == (exp))
+#define QTIP_ASSERT_EMPTY(exp) TEST_ASSERT(QTIP_STATUS_EMPTY == (exp))
+#define QTIP_ASSERT_FULL(exp)  TEST_ASSERT(QTIP_STATUS_FULL == (exp))
+
+#define QUEUE_SIZE 10U
+
+namespace
+{
+
+int alive = 0;
+
+struct tracked
+{
+    explicit tracked(int value) : value(value)
+    {
+        alive++;
+    }
+
+    tracked(tracked&& other) noexcept : value(other.value)
+    {
+        alive++;
+    }
+
+    tracked& operator=(tracked&& other) noexcept
+    {
+        value = other.value;
+        return *this;
+    }
+
+    ~tracked()
+    {
+        alive--;
+    }
+
+    int value;
+};
+
+} // namespace
+
+void setUp(void)
+{
+    alive = 0;
+}
+
+void tearDown(void)
+{
+}
+
+void test_put_pop(void)
+{
+    qtip::ring<std::string, QUEUE_SIZE> queue;
+    std::string item;
+
+    static_assert(qtip::ring<std::string, QUEUE_SIZE>::capacity() == QUEUE_SIZE, "capacity");
+
+    QTIP_ASSERT_OK(queue.put(std::string(64U, 'a')));
+    QTIP_ASSERT_OK(queue.emplace(64U, 'b'));
+    TEST_ASSERT_EQUAL_size_t(2U, queue.count_items());
+    TEST_ASSERT_EQUAL_INT('a', queue.front()->front());
+    TEST_ASSERT_EQUAL_INT('b', queue.rear()->front());
+    QTIP_ASSERT_OK(queue.pop(item));
+    TEST_ASSERT_EQUAL_STRING(std::string(64U, 'a').c_str(), item.c_str());
+    QTIP_ASSERT_OK(queue.pop(item));
+    TEST_ASSERT_EQUAL_STRING(std::string(64U, 'b').c_str(), item.c_str());
+    QTIP_ASSERT_EMPTY(queue.pop(item));
+    TEST_ASSERT_NULL(queue.front());
+    TEST_ASSERT_NULL(queue.rear());
+}
+
+void test_rollover(void)
+{
+    qtip::ring<std::unique_ptr<int>, QUEUE_SIZE> queue;
+    std::unique_ptr<int> item;
+
+    for (int round = 0; round < 5; round++)
+    {
+        for (int i = 0; i < static_cast<int>(QUEUE_SIZE) - 3; i++)
+        {
+            QTIP_ASSERT_OK(queue.put(std::make_unique<int>(round + i)));
+        }
+
+        for (int i = 0; i < static_cast<int>(QUEUE_SIZE) - 3; i++)
+        {
+            QTIP_ASSERT_OK(queue.pop(item));
+            TEST_ASSERT_EQUAL_INT(round + i, *item);
+        }
+    }
+
+    for (int i = 0; i < static_cast<int>(QUEUE_SIZE); i++)
+    {
+        QTIP_ASSERT_OK(queue.emplace(new int(i)));
+    }
+    QTIP_ASSERT_FULL(queue.put(std::make_unique<int>(0)));
+    TEST_ASSERT_TRUE(queue.full());
+}
+
+void test_lifetime(void)
+{
+    {
+        qtip::ring<tracked, QUEUE_SIZE> queue;
+        tracked item(0);
+
+        for (int i = 0; i < static_cast<int>(QUEUE_SIZE); i++)
+        {
+            QTIP_ASSERT_OK(queue.emplace(i));
+        }
+        QTIP_ASSERT_FULL(queue.emplace(0));
+        TEST_ASSERT_EQUAL_INT(QUEUE_SIZE + 1U, alive);
+
+        QTIP_ASSERT_OK(queue.pop(item));
+        TEST_ASSERT_EQUAL_INT(0, item.value);
+        QTIP_ASSERT_OK(queue.pop());
+        TEST_ASSERT_EQUAL_INT(QUEUE_SIZE - 1U, alive);
+
+        queue.purge();
+        TEST_ASSERT_TRUE(queue.empty());
+        TEST_ASSERT_EQUAL_INT(1, alive);
+
+        QTIP_ASSERT_OK(queue.emplace(1));
+        QTIP_ASSERT_OK(queue.emplace(2));
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, alive);
+}
+
+void test_dynamic_ring(void)
+{
+    alignas(tracked) unsigned char buffer[QUEUE_SIZE * sizeof(tracked)];
+    tracked item(0);
+
+    {
+        qtip::dynamic_ring<tracked> queue(buffer, QUEUE_SIZE);
+
+        TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE, queue.capacity());
+        for (int round = 0; round < 3; round++)
+        {
+            for (int i = 0; i < static_cast<int>(QUEUE_SIZE); i++)
+            {
+                QTIP_ASSERT_OK(queue.emplace(round + i));
+            }
+            QTIP_ASSERT_FULL(queue.emplace(0));
+
+            for (int i = 0; i < static_cast<int>(QUEUE_SIZE) - 1; i++)
+            {
+                QTIP_ASSERT_OK(queue.pop(item));
+                TEST_ASSERT_EQUAL_INT(round + i, item.value);
+            }
+            QTIP_ASSERT_OK(queue.pop());
+        }
+
+        QTIP_ASSERT_OK(queue.emplace(1));
+    }
+
+    TEST_ASSERT_EQUAL_INT(1, alive);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_put_pop);
+    RUN_TEST(test_rollover);
+    RUN_TEST(test_lifetime);
+    RUN_TEST(test_dynamic_ring);
+    return UNITY_END();
+}
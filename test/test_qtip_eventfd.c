@@ -0,0 +1,116 @@
+/**
+ * @file test_qtip_eventfd.c
+ * @brief Unit tests for QTip eventfd notification
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#include "qtip_eventfd.h"
+#include "unity.h"
+
+#include <poll.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#define QTIP_ASSERT_OK(exp)           TEST_ASSERT(QTIP_STATUS_OK == (exp))
+#define QTIP_ASSERT_NULL_PTR(exp)     TEST_ASSERT(QTIP_STATUS_NULL_PTR == (exp))
+#define QTIP_ASSERT_INVALID_SIZE(exp) TEST_ASSERT(QTIP_STATUS_INVALID_SIZE == (exp))
+
+#define QUEUE_SIZE 8U
+#define THRESHOLD  6U
+
+typedef uint32_t type_t;
+
+qtipContext_t context;
+type_t queue[QUEUE_SIZE];
+int fd = -1;
+
+void setUp(void)
+{
+    qtip_init(&context, queue, QUEUE_SIZE, sizeof(type_t));
+    fd = eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+}
+
+void tearDown(void)
+{
+    close(fd);
+    memset(queue, 0U, sizeof(queue));
+}
+
+static bool is_readable(void)
+{
+    struct pollfd pollFd = {.fd = fd, .events = POLLIN, .revents = 0};
+    return (poll(&pollFd, 1U, 0) == 1) && ((pollFd.revents & POLLIN) != 0);
+}
+
+static uint64_t consume(void)
+{
+    uint64_t counter = 0U;
+    return (read(fd, &counter, sizeof(counter)) == (ssize_t) sizeof(counter)) ? counter : 0U;
+}
+
+void test_empty_transition(void)
+{
+    type_t item = 0U;
+
+    QTIP_ASSERT_OK(qtip_eventfd_attach(&context, fd, 0U));
+    TEST_ASSERT_FALSE(is_readable());
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+    TEST_ASSERT_TRUE(is_readable());
+    TEST_ASSERT_EQUAL_UINT64(1U, consume());
+
+    while (qtip_pop(&context, &item) == QTIP_STATUS_OK)
+    {
+    }
+    TEST_ASSERT_FALSE(is_readable());
+
+    QTIP_ASSERT_OK(qtip_put(&context, &item));
+    TEST_ASSERT_EQUAL_UINT64(1U, consume());
+}
+
+void test_threshold(void)
+{
+    type_t item = 0U;
+
+    QTIP_ASSERT_OK(qtip_eventfd_attach(&context, fd, THRESHOLD));
+
+    QTIP_ASSERT_OK(qtip_put(&context, &item));
+    TEST_ASSERT_EQUAL_UINT64(1U, consume());
+
+    for (type_t i = 1U; i < THRESHOLD - 1U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_put(&context, &i));
+    }
+    TEST_ASSERT_FALSE(is_readable());
+
+    QTIP_ASSERT_OK(qtip_put(&context, &item));
+    QTIP_ASSERT_OK(qtip_put(&context, &item));
+    TEST_ASSERT_EQUAL_UINT64(1U, consume());
+
+    QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    QTIP_ASSERT_OK(qtip_put(&context, &item));
+    TEST_ASSERT_EQUAL_UINT64(1U, consume());
+}
+
+void test_invalid(void)
+{
+    QTIP_ASSERT_NULL_PTR(qtip_eventfd_attach(NULL, fd, 0U));
+    QTIP_ASSERT_INVALID_SIZE(qtip_eventfd_attach(&context, -1, 0U));
+    QTIP_ASSERT_INVALID_SIZE(qtip_eventfd_attach(&context, fd, QUEUE_SIZE + 1U));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_transition);
+    RUN_TEST(test_threshold);
+    RUN_TEST(test_invalid);
+    return UNITY_END();
+}
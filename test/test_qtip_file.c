@@ -0,0 +1,206 @@
+/**
+ * @file test_qtip_file.c
+ * @brief Unit tests for QTip queue files
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "qtip_file.h"
+#include "unity.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define QTIP_ASSERT_OK(exp)           TEST_ASSERT(QTIP_STATUS_OK == (exp))
+#define QTIP_ASSERT_NULL_PTR(exp)     TEST_ASSERT(QTIP_STATUS_NULL_PTR == (exp))
+#define QTIP_ASSERT_EMPTY(exp)        TEST_ASSERT(QTIP_STATUS_EMPTY == (exp))
+#define QTIP_ASSERT_FULL(exp)         TEST_ASSERT(QTIP_STATUS_FULL == (exp))
+#define QTIP_ASSERT_INVALID_SIZE(exp) TEST_ASSERT(QTIP_STATUS_INVALID_SIZE == (exp))
+
+#define QTIP_ASSERT_ITEM(expected, actual) TEST_ASSERT_EQUAL_size_t((expected), (actual))
+
+#define QUEUE_SIZE 8U
+#define PATH_SIZE  64U
+#define SYNC_EVERY 4U
+
+typedef uint32_t type_t;
+
+qtipFileContext_t context;
+char path[PATH_SIZE];
+
+void setUp(void)
+{
+    (void) snprintf(path, sizeof(path), "qtip_test_%ld.qtip", (long) getpid());
+    (void) unlink(path);
+    qtip_file_open(&context, path, QUEUE_SIZE, sizeof(type_t), 0U, 0U);
+}
+
+void tearDown(void)
+{
+    (void) qtip_file_close(&context);
+    (void) unlink(path);
+}
+
+static void put_range(type_t first, type_t last)
+{
+    for (type_t i = first; i <= last; i++)
+    {
+        QTIP_ASSERT_OK(qtip_file_put(&context, &i));
+    }
+}
+
+static void pop_range(type_t first, type_t last)
+{
+    type_t item = 0U;
+
+    for (type_t i = first; i <= last; i++)
+    {
+        QTIP_ASSERT_OK(qtip_file_pop(&context, &item));
+        QTIP_ASSERT_ITEM(i, item);
+    }
+}
+
+void test_reopen(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t item = 0U;
+    size_t total = 0U;
+
+    put_range(1U, QUEUE_SIZE);
+    QTIP_ASSERT_FULL(qtip_file_put(&context, &item));
+    pop_range(1U, 3U);
+    put_range(QUEUE_SIZE + 1U, QUEUE_SIZE + 2U);
+    QTIP_ASSERT_OK(qtip_file_close(&context));
+
+    QTIP_ASSERT_OK(qtip_file_open(&context, path, QUEUE_SIZE, sizeof(type_t), 0U, 0U));
+    QTIP_ASSERT_OK(qtip_total_enqueued_items(&context.queue, &total));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE + 2U, total);
+    pop_range(4U, QUEUE_SIZE + 2U);
+    QTIP_ASSERT_EMPTY(qtip_file_pop(&context, &item));
+}
+
+void test_crash(void)
+{
+    int exitCode      = -1;
+    type_t item       = 0U;
+    const pid_t child = fork();
+
+    if (child == 0)
+    {
+        qtipFileContext_t crashed;
+
+        (void) qtip_file_close(&context);
+        (void) qtip_file_open(&crashed, path, QUEUE_SIZE, sizeof(type_t), SYNC_EVERY, 0U);
+        for (type_t i = 1U; i <= SYNC_EVERY + 1U; i++)
+        {
+            (void) qtip_file_put(&crashed, &i);
+        }
+        (void) qtip_file_pop(&crashed, &item);
+        _exit(0);
+    }
+
+    TEST_ASSERT_EQUAL_INT(child, waitpid(child, &exitCode, 0));
+    TEST_ASSERT_EQUAL_INT(0, exitCode);
+
+    // The queue is recovered as of the last flush, so the pop is undone and the last put is lost
+    QTIP_ASSERT_OK(qtip_file_close(&context));
+    QTIP_ASSERT_OK(qtip_file_open(&context, path, QUEUE_SIZE, sizeof(type_t), 0U, 0U));
+    pop_range(1U, SYNC_EVERY);
+    QTIP_ASSERT_EMPTY(qtip_file_pop(&context, &item));
+}
+
+void test_torn_state(void)
+{
+    const uint64_t garbage = UINT64_MAX;
+    type_t item            = 0U;
+    qtipSize_t qty         = 0U;
+    off_t offset           = 0;
+
+    QTIP_ASSERT_OK(qtip_file_close(&context));
+    QTIP_ASSERT_OK(qtip_file_open(&context, path, QUEUE_SIZE, sizeof(type_t), 1U, 0U));
+    put_range(1U, 3U);
+    offset = (off_t) offsetof(qtipFileHeader_t, states[context.sequence % 2U].front);
+    QTIP_ASSERT_OK(qtip_file_close(&context));
+
+    const int fd = open(path, O_WRONLY);
+    TEST_ASSERT_EQUAL_INT((int) sizeof(garbage), (int) pwrite(fd, &garbage, sizeof(garbage), offset));
+    close(fd);
+
+    QTIP_ASSERT_OK(qtip_file_open(&context, path, QUEUE_SIZE, sizeof(type_t), 0U, 0U));
+    QTIP_ASSERT_OK(qtip_count_items(&context.queue, &qty));
+    QTIP_ASSERT_ITEM(2U, qty);
+    pop_range(1U, 2U);
+    QTIP_ASSERT_EMPTY(qtip_file_pop(&context, &item));
+}
+
+void test_sync(void)
+{
+    QTIP_ASSERT_OK(qtip_file_close(&context));
+    QTIP_ASSERT_OK(qtip_file_open(&context, path, QUEUE_SIZE, sizeof(type_t), SYNC_EVERY, 0U));
+
+    put_range(1U, SYNC_EVERY - 1U);
+    TEST_ASSERT_EQUAL_UINT32(SYNC_EVERY - 1U, context.pending);
+    put_range(SYNC_EVERY, SYNC_EVERY);
+    TEST_ASSERT_EQUAL_UINT32(0U, context.pending);
+    put_range(SYNC_EVERY + 1U, SYNC_EVERY + 1U);
+    QTIP_ASSERT_OK(qtip_file_sync(&context));
+    TEST_ASSERT_EQUAL_UINT32(0U, context.pending);
+}
+
+void test_slot_reuse(void)
+{
+    put_range(1U, QUEUE_SIZE);
+    QTIP_ASSERT_OK(qtip_file_sync(&context));
+    pop_range(1U, 2U);
+    TEST_ASSERT_EQUAL_UINT32(2U, context.pending);
+
+    // The slot of item 1 is still part of the state on the disk, so the put flushes first
+    put_range(QUEUE_SIZE + 1U, QUEUE_SIZE + 1U);
+    TEST_ASSERT_EQUAL_UINT32(1U, context.pending);
+    put_range(QUEUE_SIZE + 2U, QUEUE_SIZE + 2U);
+    TEST_ASSERT_EQUAL_UINT32(2U, context.pending);
+}
+
+void test_invalid_size(void)
+{
+    qtipFileContext_t other;
+    const char text[] = "not a queue file";
+
+    QTIP_ASSERT_INVALID_SIZE(qtip_file_open(&other, path, QUEUE_SIZE * 2U, sizeof(type_t), 0U, 0U));
+    QTIP_ASSERT_INVALID_SIZE(qtip_file_open(&other, path, QUEUE_SIZE, sizeof(type_t) * 2U, 0U, 0U));
+    QTIP_ASSERT_INVALID_SIZE(qtip_file_open(&other, path, 0U, sizeof(type_t), 0U, 0U));
+    QTIP_ASSERT_INVALID_SIZE(qtip_file_open(&other, path, QUEUE_SIZE, 0U, 0U, 0U));
+
+    QTIP_ASSERT_OK(qtip_file_close(&context));
+    const int fd = open(path, O_WRONLY | O_TRUNC);
+    TEST_ASSERT_EQUAL_INT((int) sizeof(text), (int) write(fd, text, sizeof(text)));
+    close(fd);
+    QTIP_ASSERT_INVALID_SIZE(qtip_file_open(&context, path, QUEUE_SIZE, sizeof(type_t), 0U, 0U));
+}
+
+void test_null_ptr(void)
+{
+    QTIP_ASSERT_NULL_PTR(qtip_file_open(NULL, NULL, 0U, 0U, 0U, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_file_put(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_file_put(&context, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_file_pop(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_file_sync(NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_file_close(NULL));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_reopen);
+    RUN_TEST(test_crash);
+    RUN_TEST(test_torn_state);
+    RUN_TEST(test_sync);
+    RUN_TEST(test_slot_reuse);
+    RUN_TEST(test_invalid_size);
+    RUN_TEST(test_null_ptr);
+    return UNITY_END();
+}
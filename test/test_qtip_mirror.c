@@ -0,0 +1,156 @@
+/**
+ * @file test_qtip_mirror.c
+ * @brief Unit tests for QTip mirrored queues
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#include "qtip_mirror.h"
+#include "unity.h"
+
+#include <string.h>
+#include <unistd.h>
+
+#define QTIP_ASSERT_OK(exp)           TEST_ASSERT(QTIP_STATUS_OK == (exp))
+#define QTIP_ASSERT_NULL_PTR(exp)     TEST_ASSERT(QTIP_STATUS_NULL_PTR == (exp))
+#define QTIP_ASSERT_EMPTY(exp)        TEST_ASSERT(QTIP_STATUS_EMPTY == (exp))
+#define QTIP_ASSERT_INVALID_SIZE(exp) TEST_ASSERT(QTIP_STATUS_INVALID_SIZE == (exp))
+
+#define QTIP_ASSERT_ITEM(expected, actual) TEST_ASSERT_EQUAL_size_t((expected), (actual))
+
+#define ITEM_SIZE  32U
+#define MAX_ITEMS  1024U
+#define OFFSET     (queueSize - 3U)
+#define BATCH      8U
+
+typedef uint32_t type_t;
+
+// Items are large enough that one page of them fits any qtipSize_t
+typedef struct
+{
+    type_t value;
+    uint8_t padding[ITEM_SIZE - sizeof(type_t)];
+} item_t;
+
+qtipContext_t context;
+qtipSize_t queueSize;
+item_t buffer[MAX_ITEMS];
+
+void setUp(void)
+{
+    queueSize = (qtipSize_t) ((size_t) sysconf(_SC_PAGESIZE) / sizeof(item_t));
+    TEST_ASSERT_TRUE(queueSize <= MAX_ITEMS);
+    QTIP_ASSERT_OK(qtip_mirror_init(&context, queueSize, sizeof(item_t)));
+}
+
+void tearDown(void)
+{
+    (void) qtip_mirror_free(&context);
+    memset(buffer, 0U, sizeof(buffer));
+}
+
+static void put_range(type_t first, type_t last)
+{
+    item_t item = {0};
+
+    for (type_t i = first; i <= last; i++)
+    {
+        item.value = i;
+        QTIP_ASSERT_OK(qtip_put(&context, &item));
+    }
+}
+
+static void put_past_end(type_t first, type_t last)
+{
+    // Start the items near the end of the buffer, so they wrap around
+    put_range(0U, OFFSET - 1U);
+    put_range(first, first + (queueSize - OFFSET) - 1U);
+    QTIP_ASSERT_OK(qtip_release_n(&context, OFFSET));
+    put_range(first + (queueSize - OFFSET), last);
+}
+
+void test_view(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    item_t* pItems   = NULL;
+    qtipSize_t count = 0U;
+
+    put_past_end(0U, BATCH - 1U);
+
+    QTIP_ASSERT_OK(qtip_get_view(&context, (void**) &pItems, &count));
+    TEST_ASSERT_EQUAL_size_t(BATCH, count);
+    for (type_t i = 0U; i < BATCH; i++)
+    {
+        QTIP_ASSERT_ITEM(i, pItems[i].value);
+    }
+
+    QTIP_ASSERT_OK(qtip_release_n(&context, count));
+    QTIP_ASSERT_EMPTY(qtip_get_view(&context, (void**) &pItems, &count));
+}
+
+void test_peek(void)
+{
+    qtipSize_t count = 0U;
+
+    put_past_end(0U, queueSize - 1U);
+
+    QTIP_ASSERT_OK(qtip_peek(&context, buffer, &count));
+    TEST_ASSERT_EQUAL_size_t(queueSize, count);
+    for (type_t i = 0U; i < queueSize; i++)
+    {
+        QTIP_ASSERT_ITEM(i, buffer[i].value);
+    }
+}
+
+void test_put_pop_n(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    item_t items[BATCH] = {0};
+    item_t item         = {0};
+
+    for (type_t i = 0U; i < BATCH; i++)
+    {
+        items[i].value = i + 1U;
+    }
+
+    put_range(0U, OFFSET);
+    QTIP_ASSERT_OK(qtip_release_n(&context, OFFSET));
+    QTIP_ASSERT_OK(qtip_put_n(&context, items, BATCH));
+    QTIP_ASSERT_OK(qtip_get_rear(&context, &item));
+    QTIP_ASSERT_ITEM(BATCH, item.value);
+    QTIP_ASSERT_OK(qtip_pop(&context, &item));
+    QTIP_ASSERT_ITEM(OFFSET, item.value);
+
+    memset(items, 0U, sizeof(items));
+    QTIP_ASSERT_OK(qtip_pop_n(&context, items, BATCH));
+    for (type_t i = 0U; i < BATCH; i++)
+    {
+        QTIP_ASSERT_ITEM(i + 1U, items[i].value);
+    }
+    QTIP_ASSERT_EMPTY(qtip_pop(&context, &item));
+}
+
+void test_null_ptr(void)
+{
+    QTIP_ASSERT_NULL_PTR(qtip_mirror_init(NULL, queueSize, sizeof(item_t)));
+    QTIP_ASSERT_NULL_PTR(qtip_mirror_free(NULL));
+}
+
+void test_invalid_size(void)
+{
+    qtipContext_t other;
+    qtipContext_t plain = {0};
+
+    QTIP_ASSERT_INVALID_SIZE(qtip_mirror_init(&other, queueSize - 1U, sizeof(item_t)));
+    QTIP_ASSERT_INVALID_SIZE(qtip_mirror_init(&other, 0U, sizeof(item_t)));
+    QTIP_ASSERT_INVALID_SIZE(qtip_mirror_free(&plain));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_view);
+    RUN_TEST(test_peek);
+    RUN_TEST(test_put_pop_n);
+    RUN_TEST(test_null_ptr);
+    RUN_TEST(test_invalid_size);
+    return UNITY_END();
+}
@@ -0,0 +1,302 @@
+/**
+ * @file test_qtip_mpmc.c
+ * @brief Unit tests for QTip multi-producer/multi-consumer API
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#include "qtip_mpmc.h"
+#include "unity.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#define QTIP_ASSERT_OK(exp)           TEST_ASSERT(QTIP_STATUS_OK == (exp))
+#define QTIP_ASSERT_NULL_PTR(exp)     TEST_ASSERT(QTIP_STATUS_NULL_PTR == (exp))
+#define QTIP_ASSERT_EMPTY(exp)        TEST_ASSERT(QTIP_STATUS_EMPTY == (exp))
+#define QTIP_ASSERT_FULL(exp)         TEST_ASSERT(QTIP_STATUS_FULL == (exp))
+#define QTIP_ASSERT_INVALID_SIZE(exp) TEST_ASSERT(QTIP_STATUS_INVALID_SIZE == (exp))
+
+#define QTIP_ASSERT_ITEM(expected, actual) TEST_ASSERT_EQUAL_size_t((expected), (actual))
+
+#ifdef POWER_OF_TWO
+#define QUEUE_SIZE 8U
+#else
+#define QUEUE_SIZE 10U
+#endif
+#define PRODUCERS      4U
+#define CONSUMERS      4U
+#define ITEMS_PER_PROD 20000U
+#define PRODUCER_SHIFT 24U
+
+typedef uint32_t type_t;
+
+qtipMpmcContext_t context;
+size_t queue[QTIP_MPMC_BUFFER_SIZE(QUEUE_SIZE, sizeof(type_t)) / sizeof(size_t)];
+
+typedef struct
+{
+    type_t next[PRODUCERS];
+    size_t received;
+    bool ordered;
+} consumerResult_t;
+
+static QTIP_ATOMIC(size_t) consumed;
+static QTIP_ATOMIC(uint8_t) delivered[PRODUCERS][ITEMS_PER_PROD];
+
+void setUp(void)
+{
+    qtip_mpmc_init(&context, queue, QUEUE_SIZE, sizeof(type_t));
+}
+
+void tearDown(void)
+{
+    memset(queue, 0U, sizeof(queue));
+}
+
+static void* producer(void* pArg)
+{
+    const type_t id = (type_t) (uintptr_t) pArg;
+
+    for (type_t i = 0U; i < ITEMS_PER_PROD; i++)
+    {
+        type_t item = (id << PRODUCER_SHIFT) | i;
+        while (qtip_mpmc_put(&context, &item) != QTIP_STATUS_OK)
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void* consumer(void* pArg)
+{
+    consumerResult_t* pResult = (consumerResult_t*) pArg;
+    type_t item               = 0U;
+
+    while (atomic_load(&consumed) < PRODUCERS * ITEMS_PER_PROD)
+    {
+        if (qtip_mpmc_pop(&context, &item) == QTIP_STATUS_OK)
+        {
+            const type_t id    = item >> PRODUCER_SHIFT;
+            const type_t index = item & ((1U << PRODUCER_SHIFT) - 1U);
+
+            pResult->ordered = pResult->ordered && (index >= pResult->next[id]);
+            pResult->next[id] = index + 1U;
+            atomic_fetch_add(&delivered[id][index], 1U);
+            atomic_fetch_add(&consumed, 1U);
+            pResult->received++;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+void test_put_pop(void)
+{
+    type_t element1 = 1U;
+    type_t element2 = 2U;
+    type_t item     = 0U;
+    qtipSize_t size = 0U;
+    QTIP_ASSERT_OK(qtip_mpmc_put(&context, &element1));
+    QTIP_ASSERT_OK(qtip_mpmc_put(&context, &element2));
+    QTIP_ASSERT_OK(qtip_mpmc_count_items(&context, &size));
+    TEST_ASSERT_EQUAL_size_t(2U, size);
+    QTIP_ASSERT_OK(qtip_mpmc_pop(&context, &item));
+    QTIP_ASSERT_ITEM(element1, item);
+    QTIP_ASSERT_OK(qtip_mpmc_pop(&context, &item));
+    QTIP_ASSERT_ITEM(element2, item);
+    QTIP_ASSERT_EMPTY(qtip_mpmc_pop(&context, &item));
+}
+
+void test_rollover(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t item = 0U;
+
+    for (type_t round = 0U; round < 5U; round++)
+    {
+        for (type_t i = 0U; i < QUEUE_SIZE; i++)
+        {
+            item = round + i;
+            QTIP_ASSERT_OK(qtip_mpmc_put(&context, &item));
+        }
+        QTIP_ASSERT_FULL(qtip_mpmc_put(&context, &item));
+
+        for (type_t i = 0U; i < QUEUE_SIZE; i++)
+        {
+            QTIP_ASSERT_OK(qtip_mpmc_pop(&context, &item));
+            QTIP_ASSERT_ITEM(round + i, item);
+        }
+        QTIP_ASSERT_EMPTY(qtip_mpmc_pop(&context, &item));
+    }
+}
+
+void test_threads(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    pthread_t producers[PRODUCERS];
+    pthread_t consumers[CONSUMERS];
+    consumerResult_t results[CONSUMERS];
+    size_t received = 0U;
+
+    memset(results, 0, sizeof(results));
+    memset(delivered, 0, sizeof(delivered));
+    atomic_store(&consumed, 0U);
+
+    for (size_t i = 0U; i < CONSUMERS; i++)
+    {
+        results[i].ordered = true;
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&consumers[i], NULL, consumer, &results[i]));
+    }
+    for (size_t i = 0U; i < PRODUCERS; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&producers[i], NULL, producer, (void*) (uintptr_t) i));
+    }
+
+    for (size_t i = 0U; i < PRODUCERS; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(producers[i], NULL));
+    }
+    for (size_t i = 0U; i < CONSUMERS; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(consumers[i], NULL));
+        TEST_ASSERT_TRUE(results[i].ordered);
+        received += results[i].received;
+    }
+
+    TEST_ASSERT_EQUAL_size_t(PRODUCERS * ITEMS_PER_PROD, received);
+    for (size_t i = 0U; i < PRODUCERS; i++)
+    {
+        for (size_t j = 0U; j < ITEMS_PER_PROD; j++)
+        {
+            TEST_ASSERT_EQUAL_UINT8(1U, atomic_load(&delivered[i][j]));
+        }
+    }
+}
+
+void test_telemetry(void)
+{
+    type_t item      = 0U;
+    size_t processed = 0U;
+    size_t total     = 0U;
+
+    for (int i = 0; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_mpmc_put(&context, &item));
+    }
+
+    for (int i = 0; i < QUEUE_SIZE - 1; i++)
+    {
+        QTIP_ASSERT_OK(qtip_mpmc_pop(&context, &item));
+    }
+
+    QTIP_ASSERT_OK(qtip_mpmc_total_enqueued_items(&context, &total));
+    QTIP_ASSERT_OK(qtip_mpmc_total_processed_items(&context, &processed));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE, total);
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE - 1U, processed);
+}
+
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+
+static size_t sum_histogram(const qtipStats_t* pStats)
+{
+    size_t sum = 0U;
+
+    for (size_t i = 0U; i < STATS_BUCKETS; i++)
+    {
+        sum += pStats->histogram[i];
+    }
+
+    return sum;
+}
+
+void test_stats(void)
+{
+    type_t item       = 0U;
+    qtipStats_t stats = {0};
+
+    for (size_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_mpmc_put(&context, &item));
+    }
+    QTIP_ASSERT_FULL(qtip_mpmc_put(&context, &item));
+    QTIP_ASSERT_FULL(qtip_mpmc_put(&context, &item));
+
+    for (size_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_mpmc_pop(&context, &item));
+    }
+    QTIP_ASSERT_EMPTY(qtip_mpmc_pop(&context, &item));
+
+    // Only the put that claimed position 0 was sampled, with itself in the queue
+    QTIP_ASSERT_OK(qtip_mpmc_get_stats(&context, &stats, true));
+    TEST_ASSERT_EQUAL_size_t(2U, stats.full);
+    TEST_ASSERT_EQUAL_size_t(1U, stats.empty);
+    TEST_ASSERT_EQUAL_size_t(1U, stats.highWatermark);
+    TEST_ASSERT_EQUAL_size_t(1U, stats.histogram[0U]);
+
+    QTIP_ASSERT_OK(qtip_mpmc_get_stats(&context, &stats, false));
+    TEST_ASSERT_EQUAL_size_t(0U, stats.full);
+    TEST_ASSERT_EQUAL_size_t(0U, stats.empty);
+    TEST_ASSERT_EQUAL_size_t(0U, stats.highWatermark);
+    TEST_ASSERT_EQUAL_size_t(0U, sum_histogram(&stats));
+
+    // The puts at the next two sampled positions see one and three items
+    for (size_t i = QUEUE_SIZE; i < ((2U * STATS_SAMPLE_RATE) - 2U); i++)
+    {
+        QTIP_ASSERT_OK(qtip_mpmc_put(&context, &item));
+        QTIP_ASSERT_OK(qtip_mpmc_pop(&context, &item));
+    }
+    for (size_t i = 0U; i < 3U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_mpmc_put(&context, &item));
+    }
+
+    QTIP_ASSERT_OK(qtip_mpmc_get_stats(&context, &stats, false));
+    TEST_ASSERT_EQUAL_size_t(3U, stats.highWatermark);
+    TEST_ASSERT_EQUAL_size_t(1U, stats.histogram[0U]);
+    TEST_ASSERT_EQUAL_size_t(1U, stats.histogram[1U]);
+    TEST_ASSERT_EQUAL_size_t(2U, sum_histogram(&stats));
+}
+
+#endif // DISABLE_TELEMETRY && DISABLE_STATS
+
+void test_null_ptr(void)
+{
+    QTIP_ASSERT_NULL_PTR(qtip_mpmc_init(NULL, NULL, 0U, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_mpmc_put(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_mpmc_pop(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_mpmc_count_items(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_mpmc_total_enqueued_items(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_mpmc_total_processed_items(NULL, NULL));
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    QTIP_ASSERT_NULL_PTR(qtip_mpmc_get_stats(NULL, NULL, false));
+#endif
+}
+
+void test_invalid_size(void)
+{
+    QTIP_ASSERT_INVALID_SIZE(qtip_mpmc_init(&context, queue, 0U, sizeof(type_t)));
+    QTIP_ASSERT_INVALID_SIZE(qtip_mpmc_init(&context, queue, QUEUE_SIZE, 0U));
+    QTIP_ASSERT_INVALID_SIZE(qtip_mpmc_init(&context, (uint8_t*) queue + 1U, QUEUE_SIZE, sizeof(type_t)));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_put_pop);
+    RUN_TEST(test_rollover);
+    RUN_TEST(test_threads);
+    RUN_TEST(test_telemetry);
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    RUN_TEST(test_stats);
+#endif
+    RUN_TEST(test_null_ptr);
+    RUN_TEST(test_invalid_size);
+    return UNITY_END();
+}
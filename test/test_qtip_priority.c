@@ -0,0 +1,126 @@
+/**
+ * @file test_qtip_priority.c
+ * @brief Unit tests for QTip priority queues
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#include "qtip_priority.h"
+#include "unity.h"
+
+#include <string.h>
+
+#define QTIP_ASSERT_OK(exp)           TEST_ASSERT(QTIP_STATUS_OK == (exp))
+#define QTIP_ASSERT_NULL_PTR(exp)     TEST_ASSERT(QTIP_STATUS_NULL_PTR == (exp))
+#define QTIP_ASSERT_EMPTY(exp)        TEST_ASSERT(QTIP_STATUS_EMPTY == (exp))
+#define QTIP_ASSERT_FULL(exp)         TEST_ASSERT(QTIP_STATUS_FULL == (exp))
+#define QTIP_ASSERT_INVALID_SIZE(exp) TEST_ASSERT(QTIP_STATUS_INVALID_SIZE == (exp))
+
+#define QTIP_ASSERT_ITEM(expected, actual) TEST_ASSERT_EQUAL_size_t((expected), (actual))
+
+#define LEVELS     3U
+#define LEVEL_SIZE 4U
+
+typedef uint32_t type_t;
+
+qtipPriorityContext_t context;
+type_t queue[LEVELS * LEVEL_SIZE];
+
+void setUp(void)
+{
+    qtip_priority_init(&context, queue, LEVELS, LEVEL_SIZE, sizeof(type_t));
+}
+
+void tearDown(void)
+{
+    memset(queue, 0U, sizeof(queue));
+}
+
+static void put_item(type_t item, uint32_t priority)
+{
+    QTIP_ASSERT_OK(qtip_priority_put(&context, &item, priority));
+}
+
+static void pop_item(type_t expected)
+{
+    type_t item = 0U;
+
+    QTIP_ASSERT_OK(qtip_priority_pop(&context, &item));
+    QTIP_ASSERT_ITEM(expected, item);
+}
+
+void test_order(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t item       = 0U;
+    uint32_t priority = 0U;
+    qtipSize_t count  = 0U;
+
+    QTIP_ASSERT_EMPTY(qtip_priority_pop(&context, &item));
+    QTIP_ASSERT_EMPTY(qtip_priority_get_front(&context, &item, &priority));
+
+    put_item(20U, 2U);
+    put_item(21U, 2U);
+    put_item(10U, 1U);
+    put_item(22U, 2U);
+    put_item(0U, 0U);
+    put_item(11U, 1U);
+    QTIP_ASSERT_OK(qtip_priority_count_items(&context, &count));
+    TEST_ASSERT_EQUAL_size_t(6U, count);
+
+    QTIP_ASSERT_OK(qtip_priority_get_front(&context, &item, &priority));
+    QTIP_ASSERT_ITEM(0U, item);
+    TEST_ASSERT_EQUAL_UINT32(0U, priority);
+
+    pop_item(0U);
+    pop_item(10U);
+    put_item(1U, 0U);
+    pop_item(1U);
+    pop_item(11U);
+    pop_item(20U);
+    pop_item(21U);
+    pop_item(22U);
+    QTIP_ASSERT_EMPTY(qtip_priority_pop(&context, &item));
+}
+
+void test_full_level(void)
+{
+    type_t item = 0U;
+
+    for (type_t i = 0U; i < LEVEL_SIZE; i++)
+    {
+        put_item(i, 1U);
+    }
+    QTIP_ASSERT_FULL(qtip_priority_put(&context, &item, 1U));
+    put_item(LEVEL_SIZE, 0U);
+    pop_item(LEVEL_SIZE);
+    pop_item(0U);
+}
+
+void test_null_ptr(void)
+{
+    QTIP_ASSERT_NULL_PTR(qtip_priority_init(NULL, NULL, 0U, 0U, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_priority_put(NULL, NULL, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_priority_pop(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_priority_get_front(NULL, NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_priority_count_items(NULL, NULL));
+}
+
+void test_invalid_size(void)
+{
+    type_t item = 0U;
+
+    QTIP_ASSERT_INVALID_SIZE(qtip_priority_put(&context, &item, LEVELS));
+    QTIP_ASSERT_INVALID_SIZE(qtip_priority_init(&context, queue, 0U, LEVEL_SIZE, sizeof(type_t)));
+    QTIP_ASSERT_INVALID_SIZE(qtip_priority_init(&context, queue, PRIORITY_LEVELS + 1U, 1U, sizeof(type_t)));
+    QTIP_ASSERT_INVALID_SIZE(qtip_priority_init(&context, queue, LEVELS, 0U, sizeof(type_t)));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_order);
+    RUN_TEST(test_full_level);
+    RUN_TEST(test_null_ptr);
+    RUN_TEST(test_invalid_size);
+    return UNITY_END();
+}
@@ -0,0 +1,157 @@
+/**
+ * @file test_qtip_record.c
+ * @brief Unit tests for QTip record queues
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#include "qtip_record.h"
+#include "unity.h"
+
+#include <string.h>
+
+#define QTIP_ASSERT_OK(exp)           TEST_ASSERT(QTIP_STATUS_OK == (exp))
+#define QTIP_ASSERT_NULL_PTR(exp)     TEST_ASSERT(QTIP_STATUS_NULL_PTR == (exp))
+#define QTIP_ASSERT_EMPTY(exp)        TEST_ASSERT(QTIP_STATUS_EMPTY == (exp))
+#define QTIP_ASSERT_FULL(exp)         TEST_ASSERT(QTIP_STATUS_FULL == (exp))
+#define QTIP_ASSERT_INVALID_SIZE(exp) TEST_ASSERT(QTIP_STATUS_INVALID_SIZE == (exp))
+
+#define BUFFER_SIZE  64U
+#define RECORD_MAX   BUFFER_SIZE
+#define RESERVE_SIZE 32U
+
+qtipRecordContext_t context;
+uint64_t queue[BUFFER_SIZE / sizeof(uint64_t)];
+char record[RECORD_MAX];
+
+void setUp(void)
+{
+    qtip_record_init(&context, queue, sizeof(queue));
+}
+
+void tearDown(void)
+{
+    memset(queue, 0U, sizeof(queue));
+    memset(record, 0U, sizeof(record));
+}
+
+static void put_record(char fill, size_t length)
+{
+    char data[RECORD_MAX];
+
+    memset(data, fill, length);
+    QTIP_ASSERT_OK(qtip_record_put(&context, data, length));
+}
+
+static void pop_record(char fill, size_t length)
+{
+    size_t actual = 0U;
+
+    QTIP_ASSERT_OK(qtip_record_pop(&context, record, sizeof(record), &actual));
+    TEST_ASSERT_EQUAL_size_t(length, actual);
+    for (size_t i = 0U; i < length; i++)
+    {
+        TEST_ASSERT_TRUE(record[i] == fill);
+    }
+}
+
+void test_put_pop(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    qtipSize_t count = 0U;
+    size_t length    = 0U;
+
+    put_record('a', 1U);
+    put_record('b', 12U);
+    put_record('c', 3U);
+    QTIP_ASSERT_OK(qtip_record_count(&context, &count));
+    TEST_ASSERT_EQUAL_size_t(3U, count);
+
+    pop_record('a', 1U);
+    pop_record('b', 12U);
+    pop_record('c', 3U);
+    QTIP_ASSERT_EMPTY(qtip_record_pop(&context, record, sizeof(record), &length));
+}
+
+void test_wrap_padding(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    size_t length = 0U;
+
+    put_record('a', 20U);
+    put_record('b', 8U);
+    pop_record('a', 20U);
+
+    // Does not fit before the end, so it goes to the start behind a padding marker
+    put_record('c', 20U);
+    QTIP_ASSERT_FULL(qtip_record_put(&context, record, 1U));
+
+    pop_record('b', 8U);
+    QTIP_ASSERT_OK(qtip_record_next_size(&context, &length));
+    TEST_ASSERT_EQUAL_size_t(20U, length);
+    pop_record('c', 20U);
+    QTIP_ASSERT_EMPTY(qtip_record_next_size(&context, &length));
+
+    put_record('d', BUFFER_SIZE - QTIP_RECORD_ALIGNMENT);
+    pop_record('d', BUFFER_SIZE - QTIP_RECORD_ALIGNMENT);
+}
+
+void test_short_buffer(void)
+{
+    size_t length = 0U;
+
+    put_record('a', 10U);
+    QTIP_ASSERT_INVALID_SIZE(qtip_record_pop(&context, record, 4U, &length));
+    TEST_ASSERT_EQUAL_size_t(10U, length);
+    pop_record('a', 10U);
+}
+
+void test_reserve_commit(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    char* pRecord = NULL;
+
+    QTIP_ASSERT_INVALID_SIZE(qtip_record_commit(&context, 1U));
+    QTIP_ASSERT_INVALID_SIZE(qtip_record_reserve(&context, BUFFER_SIZE, (void**) &pRecord));
+
+    QTIP_ASSERT_OK(qtip_record_reserve(&context, RESERVE_SIZE, (void**) &pRecord));
+    memset(pRecord, 'a', 5U);
+    QTIP_ASSERT_INVALID_SIZE(qtip_record_commit(&context, RESERVE_SIZE + 1U));
+    QTIP_ASSERT_OK(qtip_record_commit(&context, 5U));
+    QTIP_ASSERT_INVALID_SIZE(qtip_record_commit(&context, 5U));
+
+    // The rest of the reservation is free again
+    put_record('b', RESERVE_SIZE);
+    pop_record('a', 5U);
+    pop_record('b', RESERVE_SIZE);
+}
+
+void test_null_ptr(void)
+{
+    QTIP_ASSERT_NULL_PTR(qtip_record_init(NULL, NULL, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_record_put(NULL, NULL, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_record_pop(NULL, NULL, 0U, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_record_next_size(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_record_reserve(NULL, 0U, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_record_commit(NULL, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_record_count(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_record_pop(&context, record, sizeof(record), NULL));
+}
+
+void test_invalid_size(void)
+{
+    QTIP_ASSERT_INVALID_SIZE(qtip_record_init(&context, queue, 0U));
+    QTIP_ASSERT_INVALID_SIZE(qtip_record_init(&context, queue, sizeof(queue) - 1U));
+    QTIP_ASSERT_OK(qtip_record_init(&context, queue, sizeof(queue)));
+    QTIP_ASSERT_INVALID_SIZE(qtip_record_put(&context, record, 0U));
+    QTIP_ASSERT_INVALID_SIZE(qtip_record_put(&context, record, BUFFER_SIZE));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_put_pop);
+    RUN_TEST(test_wrap_padding);
+    RUN_TEST(test_short_buffer);
+    RUN_TEST(test_reserve_commit);
+    RUN_TEST(test_null_ptr);
+    RUN_TEST(test_invalid_size);
+    return UNITY_END();
+}
@@ -0,0 +1,172 @@
+/**
+ * @file test_qtip_segment.c
+ * @brief Unit tests for QTip segmented queues
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#include "qtip_segment.h"
+#include "unity.h"
+
+#include <stdlib.h>
+
+#define QTIP_ASSERT_OK(exp)           TEST_ASSERT(QTIP_STATUS_OK == (exp))
+#define QTIP_ASSERT_NULL_PTR(exp)     TEST_ASSERT(QTIP_STATUS_NULL_PTR == (exp))
+#define QTIP_ASSERT_EMPTY(exp)        TEST_ASSERT(QTIP_STATUS_EMPTY == (exp))
+#define QTIP_ASSERT_FULL(exp)         TEST_ASSERT(QTIP_STATUS_FULL == (exp))
+#define QTIP_ASSERT_INVALID_SIZE(exp) TEST_ASSERT(QTIP_STATUS_INVALID_SIZE == (exp))
+
+#define QTIP_ASSERT_ITEM(expected, actual) TEST_ASSERT_EQUAL_size_t((expected), (actual))
+
+#define CHUNK_SIZE 4U
+#define MAX_POOLED 2U
+#define ITEMS      (5U * CHUNK_SIZE)
+
+typedef uint32_t type_t;
+
+static size_t allocations;
+static size_t allocated;
+
+static void* counted_alloc(size_t size, void* pArg)
+{
+    (void) pArg;
+    allocations++;
+    allocated++;
+    return malloc(size);
+}
+
+static void counted_free(void* pBuffer, void* pArg)
+{
+    (void) pArg;
+    allocated--;
+    free(pBuffer);
+}
+
+static const qtipAllocator_t allocator = {.alloc = counted_alloc, .free = counted_free, .pArg = NULL};
+
+qtipSegmentContext_t context;
+
+void setUp(void)
+{
+    allocations = 0U;
+    qtip_segment_init(&context, &allocator, CHUNK_SIZE, sizeof(type_t), 0U, MAX_POOLED);
+}
+
+void tearDown(void)
+{
+    (void) qtip_segment_free(&context);
+    TEST_ASSERT_EQUAL_size_t(0U, allocated);
+}
+
+static void put_range(type_t first, type_t last)
+{
+    for (type_t i = first; i <= last; i++)
+    {
+        QTIP_ASSERT_OK(qtip_segment_put(&context, &i));
+    }
+}
+
+static void pop_range(type_t first, type_t last)
+{
+    type_t item = 0U;
+
+    for (type_t i = first; i <= last; i++)
+    {
+        QTIP_ASSERT_OK(qtip_segment_pop(&context, &item));
+        QTIP_ASSERT_ITEM(i, item);
+    }
+}
+
+void test_put_pop(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t item  = 0U;
+    size_t count = 0U;
+
+    QTIP_ASSERT_EMPTY(qtip_segment_pop(&context, &item));
+    QTIP_ASSERT_EMPTY(qtip_segment_get_front(&context, &item));
+
+    put_range(1U, ITEMS);
+    TEST_ASSERT_EQUAL_size_t(ITEMS / CHUNK_SIZE, context.chunks);
+    QTIP_ASSERT_OK(qtip_segment_count_items(&context, &count));
+    TEST_ASSERT_EQUAL_size_t(ITEMS, count);
+    QTIP_ASSERT_OK(qtip_segment_get_front(&context, &item));
+    QTIP_ASSERT_ITEM(1U, item);
+
+    pop_range(1U, ITEMS);
+    QTIP_ASSERT_EMPTY(qtip_segment_pop(&context, &item));
+
+    // Drained chunks beyond the pool are freed
+    TEST_ASSERT_EQUAL_size_t(MAX_POOLED, context.pooled);
+    TEST_ASSERT_EQUAL_size_t(MAX_POOLED + 1U, context.chunks);
+}
+
+void test_recycle(void)
+{
+    size_t warm = 0U;
+
+    put_range(1U, (MAX_POOLED + 1U) * CHUNK_SIZE);
+    pop_range(1U, (MAX_POOLED + 1U) * CHUNK_SIZE);
+    warm = allocations;
+
+    for (type_t round = 0U; round < 10U; round++)
+    {
+        put_range(1U, (MAX_POOLED + 1U) * CHUNK_SIZE);
+        pop_range(1U, (MAX_POOLED + 1U) * CHUNK_SIZE);
+    }
+    TEST_ASSERT_EQUAL_size_t(warm, allocations);
+}
+
+void test_interleaved(void)
+{
+    put_range(1U, CHUNK_SIZE + 1U);
+    pop_range(1U, 2U);
+    put_range(CHUNK_SIZE + 2U, 3U * CHUNK_SIZE);
+    pop_range(3U, 3U * CHUNK_SIZE);
+}
+
+void test_max_chunks(void)
+{
+    type_t item = 0U;
+
+    QTIP_ASSERT_OK(qtip_segment_free(&context));
+    QTIP_ASSERT_OK(qtip_segment_init(&context, &allocator, CHUNK_SIZE, sizeof(type_t), 2U, 0U));
+    put_range(1U, 2U * CHUNK_SIZE);
+    QTIP_ASSERT_FULL(qtip_segment_put(&context, &item));
+    pop_range(1U, 1U);
+    QTIP_ASSERT_FULL(qtip_segment_put(&context, &item));
+    pop_range(2U, CHUNK_SIZE);
+    put_range(1U, 1U);
+}
+
+void test_null_ptr(void)
+{
+    const qtipAllocator_t noHooks = {.alloc = NULL, .free = NULL, .pArg = NULL};
+
+    QTIP_ASSERT_NULL_PTR(qtip_segment_init(NULL, NULL, 0U, 0U, 0U, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_segment_init(&context, &noHooks, CHUNK_SIZE, sizeof(type_t), 0U, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_segment_put(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_segment_pop(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_segment_get_front(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_segment_count_items(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_segment_free(NULL));
+}
+
+void test_invalid_size(void)
+{
+    qtipSegmentContext_t other;
+
+    QTIP_ASSERT_INVALID_SIZE(qtip_segment_init(&other, &allocator, 0U, sizeof(type_t), 0U, 0U));
+    QTIP_ASSERT_INVALID_SIZE(qtip_segment_init(&other, &allocator, CHUNK_SIZE, 0U, 0U, 0U));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_put_pop);
+    RUN_TEST(test_recycle);
+    RUN_TEST(test_interleaved);
+    RUN_TEST(test_max_chunks);
+    RUN_TEST(test_null_ptr);
+    RUN_TEST(test_invalid_size);
+    return UNITY_END();
+}
@@ -0,0 +1,207 @@
+/**
+ * @file test_qtip_shm.c
+ * @brief Unit tests for QTip shared memory queues
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "qtip_shm.h"
+#include "unity.h"
+
+#include <fcntl.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define QTIP_ASSERT_OK(exp)           TEST_ASSERT(QTIP_STATUS_OK == (exp))
+#define QTIP_ASSERT_NULL_PTR(exp)     TEST_ASSERT(QTIP_STATUS_NULL_PTR == (exp))
+#define QTIP_ASSERT_EMPTY(exp)        TEST_ASSERT(QTIP_STATUS_EMPTY == (exp))
+#define QTIP_ASSERT_FULL(exp)         TEST_ASSERT(QTIP_STATUS_FULL == (exp))
+#define QTIP_ASSERT_INVALID_SIZE(exp) TEST_ASSERT(QTIP_STATUS_INVALID_SIZE == (exp))
+#define QTIP_ASSERT_SYSTEM_ERROR(exp) TEST_ASSERT(QTIP_STATUS_SYSTEM_ERROR == (exp))
+
+#define QTIP_ASSERT_ITEM(expected, actual) TEST_ASSERT_EQUAL_size_t((expected), (actual))
+
+#define QUEUE_SIZE    10U
+#define MEMORY_SIZE   QTIP_SHM_SIZE(QUEUE_SIZE, sizeof(type_t))
+#define STRESS_ITEMS  100000U
+#define SHM_NAME_SIZE 32U
+
+typedef uint32_t type_t;
+
+qtipShmContext_t producer;
+qtipShmContext_t consumer;
+type_t buffer[QUEUE_SIZE];
+void* pMemory = NULL;
+char name[SHM_NAME_SIZE];
+
+void setUp(void)
+{
+    pMemory = mmap(NULL, MEMORY_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    qtip_shm_init(&producer, pMemory, MEMORY_SIZE, QUEUE_SIZE, sizeof(type_t));
+    qtip_shm_attach_memory(&consumer, pMemory, MEMORY_SIZE);
+    (void) snprintf(name, sizeof(name), "/qtip_test_%ld", (long) getpid());
+}
+
+void tearDown(void)
+{
+    munmap(pMemory, MEMORY_SIZE);
+    (void) shm_unlink(name);
+}
+
+void test_put_pop(void)
+{
+    type_t item = 0U;
+
+    for (type_t round = 0U; round < 3U; round++)
+    {
+        for (type_t i = 0U; i < QUEUE_SIZE; i++)
+        {
+            item = round + i;
+            QTIP_ASSERT_OK(qtip_shm_put(&producer, &item));
+        }
+        QTIP_ASSERT_FULL(qtip_shm_put(&producer, &item));
+
+        for (type_t i = 0U; i < QUEUE_SIZE; i++)
+        {
+            QTIP_ASSERT_OK(qtip_shm_pop(&consumer, &item));
+            QTIP_ASSERT_ITEM(round + i, item);
+        }
+        QTIP_ASSERT_EMPTY(qtip_shm_pop(&consumer, &item));
+    }
+}
+
+void test_put_pop_up_to_n(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t items[QUEUE_SIZE + 2U];
+    qtipSize_t qty = 0U;
+    size_t total   = 0U;
+
+    for (type_t i = 0U; i < QUEUE_SIZE + 2U; i++)
+    {
+        items[i] = i;
+    }
+
+    QTIP_ASSERT_OK(qtip_shm_put_up_to_n(&producer, items, 3U, &qty));
+    QTIP_ASSERT_OK(qtip_shm_pop_up_to_n(&consumer, buffer, 3U, &qty));
+    QTIP_ASSERT_OK(qtip_shm_put_up_to_n(&producer, items, QUEUE_SIZE + 2U, &qty));
+    QTIP_ASSERT_ITEM(QUEUE_SIZE, qty);
+    QTIP_ASSERT_FULL(qtip_shm_put_up_to_n(&producer, items, 1U, &qty));
+    QTIP_ASSERT_OK(qtip_shm_count_items(&consumer, &qty));
+    QTIP_ASSERT_ITEM(QUEUE_SIZE, qty);
+
+    QTIP_ASSERT_OK(qtip_shm_pop_up_to_n(&consumer, buffer, QUEUE_SIZE + 2U, &qty));
+    QTIP_ASSERT_ITEM(QUEUE_SIZE, qty);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(items, buffer, QUEUE_SIZE);
+    QTIP_ASSERT_EMPTY(qtip_shm_pop_up_to_n(&consumer, buffer, 1U, &qty));
+
+    QTIP_ASSERT_OK(qtip_shm_total_enqueued_items(&consumer, &total));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE + 3U, total);
+    QTIP_ASSERT_OK(qtip_shm_total_processed_items(&producer, &total));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE + 3U, total);
+}
+
+void test_named_object(void)
+{
+    qtipShmContext_t attached;
+    type_t item = 7U;
+
+    QTIP_ASSERT_OK(qtip_shm_create(&producer, name, QUEUE_SIZE, sizeof(type_t)));
+    QTIP_ASSERT_SYSTEM_ERROR(qtip_shm_create(&consumer, name, QUEUE_SIZE, sizeof(type_t)));
+    QTIP_ASSERT_OK(qtip_shm_attach(&attached, name));
+    TEST_ASSERT_TRUE(producer.pHeader != attached.pHeader);
+
+    QTIP_ASSERT_OK(qtip_shm_put(&producer, &item));
+    item = 0U;
+    QTIP_ASSERT_OK(qtip_shm_pop(&attached, &item));
+    QTIP_ASSERT_ITEM(7U, item);
+
+    QTIP_ASSERT_OK(qtip_shm_detach(&attached));
+    QTIP_ASSERT_OK(qtip_shm_detach(&producer));
+    QTIP_ASSERT_NULL_PTR(qtip_shm_detach(&producer));
+    TEST_ASSERT_EQUAL_INT(0, shm_unlink(name));
+    QTIP_ASSERT_SYSTEM_ERROR(qtip_shm_attach(&attached, name));
+}
+
+void test_processes(void)
+{
+    type_t item       = 0U;
+    type_t sum        = 0U;
+    int exitCode      = -1;
+    const pid_t child = fork();
+
+    if (child == 0)
+    {
+        for (type_t i = 1U; i <= STRESS_ITEMS; i++)
+        {
+            while (qtip_shm_put(&producer, &i) != QTIP_STATUS_OK)
+            {
+                sched_yield();
+            }
+        }
+        _exit(0);
+    }
+
+    TEST_ASSERT_TRUE(child > 0);
+    for (type_t i = 1U; i <= STRESS_ITEMS; i++)
+    {
+        while (qtip_shm_pop(&consumer, &item) != QTIP_STATUS_OK)
+        {
+            sched_yield();
+        }
+        sum += (item == i) ? 1U : 0U;
+    }
+
+    TEST_ASSERT_EQUAL_INT(child, waitpid(child, &exitCode, 0));
+    TEST_ASSERT_EQUAL_INT(0, exitCode);
+    TEST_ASSERT_EQUAL_UINT32(STRESS_ITEMS, sum);
+}
+
+void test_invalid_size(void)
+{
+    qtipShmContext_t context;
+    uint8_t* pBytes = pMemory;
+
+    QTIP_ASSERT_INVALID_SIZE(qtip_shm_init(&context, pMemory, MEMORY_SIZE - 1U, QUEUE_SIZE, sizeof(type_t)));
+    QTIP_ASSERT_INVALID_SIZE(qtip_shm_init(&context, pBytes + 1U, MEMORY_SIZE - 1U, 1U, 1U));
+    QTIP_ASSERT_INVALID_SIZE(qtip_shm_init(&context, pMemory, MEMORY_SIZE, 0U, sizeof(type_t)));
+    QTIP_ASSERT_INVALID_SIZE(qtip_shm_init(&context, pMemory, MEMORY_SIZE, QUEUE_SIZE, 0U));
+    QTIP_ASSERT_INVALID_SIZE(qtip_shm_attach_memory(&context, pMemory, MEMORY_SIZE - 1U));
+
+    memset(pMemory, 0, MEMORY_SIZE);
+    QTIP_ASSERT_INVALID_SIZE(qtip_shm_attach_memory(&context, pMemory, MEMORY_SIZE));
+    QTIP_ASSERT_INVALID_SIZE(qtip_shm_create(&context, name, 0U, sizeof(type_t)));
+}
+
+void test_null_ptr(void)
+{
+    QTIP_ASSERT_NULL_PTR(qtip_shm_init(NULL, NULL, 0U, 0U, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_shm_attach_memory(NULL, NULL, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_shm_create(NULL, NULL, 0U, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_shm_attach(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_shm_detach(NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_shm_put(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_shm_pop(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_shm_put_up_to_n(NULL, NULL, 0U, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_shm_pop_up_to_n(NULL, NULL, 0U, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_shm_count_items(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_shm_total_enqueued_items(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_shm_total_processed_items(NULL, NULL));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_put_pop);
+    RUN_TEST(test_put_pop_up_to_n);
+    RUN_TEST(test_named_object);
+    RUN_TEST(test_processes);
+    RUN_TEST(test_invalid_size);
+    RUN_TEST(test_null_ptr);
+    return UNITY_END();
+}
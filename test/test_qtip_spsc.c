@@ -0,0 +1,391 @@
+/**
+ * @file test_qtip_spsc.c
+ * @brief Unit tests for QTip single-producer/single-consumer API
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#include "qtip_spsc.h"
+#include "unity.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#define QTIP_ASSERT_OK(exp)           TEST_ASSERT(QTIP_STATUS_OK == (exp))
+#define QTIP_ASSERT_NULL_PTR(exp)     TEST_ASSERT(QTIP_STATUS_NULL_PTR == (exp))
+#define QTIP_ASSERT_EMPTY(exp)        TEST_ASSERT(QTIP_STATUS_EMPTY == (exp))
+#define QTIP_ASSERT_FULL(exp)         TEST_ASSERT(QTIP_STATUS_FULL == (exp))
+#define QTIP_ASSERT_INVALID_SIZE(exp) TEST_ASSERT(QTIP_STATUS_INVALID_SIZE == (exp))
+
+#define QTIP_ASSERT_ITEM(expected, actual) TEST_ASSERT_EQUAL_size_t((expected), (actual))
+
+#define QUEUE_SIZE       10U
+#define MAX_QUEUE_SIZE   (((qtipSize_t) -1) / 2U)
+#define LARGE_QUEUE_SIZE ((MAX_QUEUE_SIZE < 1024U) ? MAX_QUEUE_SIZE : 1024U)
+#define INTERLEAVED_PUTS (4U * LARGE_QUEUE_SIZE)
+#define STRESS_ITEMS     200000U
+#define STRESS_BURST     7U
+
+typedef uint32_t type_t;
+
+qtipSpscContext_t context;
+type_t queue[QUEUE_SIZE];
+type_t buffer[QUEUE_SIZE];
+
+void setUp(void)
+{
+    qtip_spsc_init(&context, queue, QUEUE_SIZE, sizeof(type_t));
+}
+
+void tearDown(void)
+{
+    memset(queue, 0U, sizeof(queue));
+}
+
+static void* producer(void* pArg)
+{
+    (void) pArg;
+    type_t items[STRESS_BURST] = {0U};
+    type_t next                = 0U;
+    qtipSize_t put             = 0U;
+
+    while (next < STRESS_ITEMS)
+    {
+        const qtipSize_t burst = ((STRESS_ITEMS - next) < STRESS_BURST) ? (STRESS_ITEMS - next) : STRESS_BURST;
+        for (qtipSize_t i = 0U; i < burst; i++)
+        {
+            items[i] = next + i;
+        }
+
+        if (qtip_spsc_put_up_to_n(&context, items, burst, &put) == QTIP_STATUS_OK)
+        {
+            next += put;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+#ifndef DISABLE_OVERWRITE
+
+static void* overwriting_producer(void* pArg)
+{
+    (void) pArg;
+
+    for (type_t i = 1U; i <= STRESS_ITEMS; i++)
+    {
+        (void) qtip_spsc_put(&context, &i);
+        if ((i % STRESS_BURST) == 0U)
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+#endif // DISABLE_OVERWRITE
+
+void test_put_pop(void)
+{
+    type_t element1 = 1U;
+    type_t element2 = 2U;
+    type_t item     = 0U;
+    QTIP_ASSERT_OK(qtip_spsc_put(&context, &element1));
+    QTIP_ASSERT_OK(qtip_spsc_put(&context, &element2));
+    QTIP_ASSERT_OK(qtip_spsc_get_front(&context, &item));
+    QTIP_ASSERT_ITEM(element1, item);
+    QTIP_ASSERT_OK(qtip_spsc_pop(&context, &item));
+    QTIP_ASSERT_ITEM(element1, item);
+    QTIP_ASSERT_OK(qtip_spsc_pop(&context, &item));
+    QTIP_ASSERT_ITEM(element2, item);
+    QTIP_ASSERT_EMPTY(qtip_spsc_pop(&context, &item));
+    QTIP_ASSERT_EMPTY(qtip_spsc_get_front(&context, &item));
+}
+
+void test_full(void)
+{
+    type_t item     = 0U;
+    qtipSize_t size = 0U;
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_spsc_put(&context, &i));
+    }
+    QTIP_ASSERT_FULL(qtip_spsc_put(&context, &item));
+    QTIP_ASSERT_OK(qtip_spsc_count_items(&context, &size));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE, size);
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_spsc_pop(&context, &item));
+        QTIP_ASSERT_ITEM(i, item);
+    }
+    QTIP_ASSERT_EMPTY(qtip_spsc_pop(&context, &item));
+}
+
+void test_rollover(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t items[QUEUE_SIZE] = {0U};
+    qtipSize_t qty           = 0U;
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        items[i] = i;
+    }
+
+    for (int round = 0; round < 5; round++)
+    {
+        QTIP_ASSERT_OK(qtip_spsc_put_up_to_n(&context, items, QUEUE_SIZE - 3U, &qty));
+        TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE - 3U, qty);
+        QTIP_ASSERT_OK(qtip_spsc_pop_up_to_n(&context, buffer, QUEUE_SIZE, &qty));
+        TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE - 3U, qty);
+        TEST_ASSERT_EQUAL_UINT32_ARRAY(items, buffer, QUEUE_SIZE - 3U);
+    }
+
+    QTIP_ASSERT_OK(qtip_spsc_put_up_to_n(&context, items, QUEUE_SIZE, &qty));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE, qty);
+    QTIP_ASSERT_FULL(qtip_spsc_put_up_to_n(&context, items, 1U, &qty));
+    TEST_ASSERT_EQUAL_size_t(0U, qty);
+    QTIP_ASSERT_OK(qtip_spsc_pop_up_to_n(&context, buffer, QUEUE_SIZE, &qty));
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(items, buffer, QUEUE_SIZE);
+    QTIP_ASSERT_EMPTY(qtip_spsc_pop_up_to_n(&context, buffer, 1U, &qty));
+}
+
+void test_threads(void)
+{
+    pthread_t thread;
+    type_t expected = 0U;
+    qtipSize_t qty  = 0U;
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, producer, NULL));
+
+    while (expected < STRESS_ITEMS)
+    {
+        if (qtip_spsc_pop_up_to_n(&context, buffer, QUEUE_SIZE, &qty) == QTIP_STATUS_OK)
+        {
+            for (qtipSize_t i = 0U; i < qty; i++)
+            {
+                QTIP_ASSERT_ITEM(expected, buffer[i]);
+                expected++;
+            }
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+    QTIP_ASSERT_EMPTY(qtip_spsc_pop(&context, buffer));
+}
+
+#ifndef DISABLE_OVERWRITE
+
+void test_overwrite(void)
+{
+    size_t overwritten = 0U;
+    qtipSize_t qty     = 0U;
+
+    QTIP_ASSERT_OK(qtip_spsc_set_overwrite(&context, true));
+    for (type_t i = 0U; i < QUEUE_SIZE + 3U; i++)
+    {
+        QTIP_ASSERT_OK(qtip_spsc_put(&context, &i));
+    }
+    QTIP_ASSERT_FULL(qtip_spsc_put_up_to_n(&context, buffer, 1U, &qty));
+
+    QTIP_ASSERT_OK(qtip_spsc_total_overwritten_items(&context, &overwritten));
+    TEST_ASSERT_EQUAL_size_t(3U, overwritten);
+    QTIP_ASSERT_OK(qtip_spsc_pop_up_to_n(&context, buffer, QUEUE_SIZE, &qty));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE, qty);
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_ITEM(i + 3U, buffer[i]);
+    }
+}
+
+void test_overwrite_threads(void)
+{
+    pthread_t thread;
+    type_t item        = 0U;
+    type_t last        = 0U;
+    size_t received    = 0U;
+    size_t overwritten = 0U;
+
+    QTIP_ASSERT_OK(qtip_spsc_set_overwrite(&context, true));
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, overwriting_producer, NULL));
+
+    // Items may be dropped, but the consumer never sees one twice or out of order
+    while (last < STRESS_ITEMS)
+    {
+        if (qtip_spsc_pop(&context, &item) == QTIP_STATUS_OK)
+        {
+            TEST_ASSERT_TRUE(item > last);
+            last = item;
+            received++;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+    QTIP_ASSERT_OK(qtip_spsc_total_overwritten_items(&context, &overwritten));
+    TEST_ASSERT_EQUAL_size_t(STRESS_ITEMS, received + overwritten);
+}
+
+#endif // DISABLE_OVERWRITE
+
+void test_telemetry(void)
+{
+    type_t item      = 0U;
+    size_t processed = 0U;
+    size_t total     = 0U;
+
+    for (int i = 0; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_spsc_put(&context, &item));
+    }
+
+    for (int i = 0; i < QUEUE_SIZE - 1; i++)
+    {
+        QTIP_ASSERT_OK(qtip_spsc_pop(&context, &item));
+    }
+
+    QTIP_ASSERT_OK(qtip_spsc_total_enqueued_items(&context, &total));
+    QTIP_ASSERT_OK(qtip_spsc_total_processed_items(&context, &processed));
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE, total);
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE - 1U, processed);
+}
+
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+
+static size_t sum_histogram(const qtipStats_t* pStats)
+{
+    size_t sum = 0U;
+
+    for (size_t i = 0U; i < STATS_BUCKETS; i++)
+    {
+        sum += pStats->histogram[i];
+    }
+
+    return sum;
+}
+
+void test_stats(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t item       = 0U;
+    qtipSize_t popped = 0U;
+    qtipStats_t stats = {0};
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_spsc_put(&context, &i));
+    }
+    QTIP_ASSERT_FULL(qtip_spsc_put(&context, &item));
+
+    for (size_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_spsc_pop(&context, &item));
+    }
+    QTIP_ASSERT_EMPTY(qtip_spsc_pop(&context, &item));
+    QTIP_ASSERT_EMPTY(qtip_spsc_pop_up_to_n(&context, buffer, 2U, &popped));
+
+    QTIP_ASSERT_OK(qtip_spsc_get_stats(&context, &stats, true));
+    // The full queue reloads the front, so the watermark is exact
+    TEST_ASSERT_EQUAL_size_t(QUEUE_SIZE, stats.highWatermark);
+    TEST_ASSERT_EQUAL_size_t(1U, stats.full);
+    TEST_ASSERT_EQUAL_size_t(2U, stats.empty);
+    TEST_ASSERT_EQUAL_size_t(0U, stats.locked);
+    // The first put is sampled, with one item in the queue
+    TEST_ASSERT_EQUAL_size_t(1U, stats.histogram[0U]);
+    TEST_ASSERT_EQUAL_size_t((QUEUE_SIZE + STATS_SAMPLE_RATE - 1U) / STATS_SAMPLE_RATE, sum_histogram(&stats));
+
+    QTIP_ASSERT_OK(qtip_spsc_get_stats(&context, &stats, false));
+    TEST_ASSERT_EQUAL_size_t(0U, stats.highWatermark);
+    TEST_ASSERT_EQUAL_size_t(0U, stats.full);
+    TEST_ASSERT_EQUAL_size_t(0U, stats.empty);
+    TEST_ASSERT_EQUAL_size_t(0U, sum_histogram(&stats));
+
+    QTIP_ASSERT_EMPTY(qtip_spsc_pop(&context, &item));
+    QTIP_ASSERT_OK(qtip_spsc_get_stats(&context, &stats, false));
+    TEST_ASSERT_EQUAL_size_t(1U, stats.empty);
+}
+
+void test_stats_interleaved(void)
+{
+    static type_t largeQueue[LARGE_QUEUE_SIZE];
+    qtipSpscContext_t largeContext;
+    type_t item       = 0U;
+    qtipStats_t stats = {0};
+
+    QTIP_ASSERT_OK(qtip_spsc_init(&largeContext, largeQueue, LARGE_QUEUE_SIZE, sizeof(type_t)));
+
+    // The cached front falls behind, but the queue never holds more than one item
+    for (type_t i = 0U; i < INTERLEAVED_PUTS; i++)
+    {
+        QTIP_ASSERT_OK(qtip_spsc_put(&largeContext, &i));
+        QTIP_ASSERT_OK(qtip_spsc_pop(&largeContext, &item));
+    }
+
+    QTIP_ASSERT_OK(qtip_spsc_get_stats(&largeContext, &stats, false));
+    TEST_ASSERT_EQUAL_size_t(1U, stats.highWatermark);
+    TEST_ASSERT_EQUAL_size_t((INTERLEAVED_PUTS + STATS_SAMPLE_RATE - 1U) / STATS_SAMPLE_RATE, stats.histogram[0U]);
+    TEST_ASSERT_EQUAL_size_t(stats.histogram[0U], sum_histogram(&stats));
+}
+
+#endif // DISABLE_TELEMETRY && DISABLE_STATS
+
+void test_null_ptr(void)
+{
+    QTIP_ASSERT_NULL_PTR(qtip_spsc_init(NULL, NULL, 0U, 0U));
+    QTIP_ASSERT_NULL_PTR(qtip_spsc_put(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_spsc_pop(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_spsc_put_up_to_n(NULL, NULL, 0U, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_spsc_pop_up_to_n(NULL, NULL, 0U, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_spsc_get_front(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_spsc_count_items(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_spsc_total_enqueued_items(NULL, NULL));
+    QTIP_ASSERT_NULL_PTR(qtip_spsc_total_processed_items(NULL, NULL));
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    QTIP_ASSERT_NULL_PTR(qtip_spsc_get_stats(NULL, NULL, false));
+#endif
+#ifndef DISABLE_OVERWRITE
+    QTIP_ASSERT_NULL_PTR(qtip_spsc_set_overwrite(NULL, false));
+    QTIP_ASSERT_NULL_PTR(qtip_spsc_total_overwritten_items(NULL, NULL));
+#endif
+}
+
+void test_invalid_size(void)
+{
+    QTIP_ASSERT_INVALID_SIZE(qtip_spsc_init(&context, queue, 0U, sizeof(type_t)));
+    QTIP_ASSERT_INVALID_SIZE(qtip_spsc_init(&context, queue, QUEUE_SIZE, 0U));
+    QTIP_ASSERT_INVALID_SIZE(qtip_spsc_init(&context, queue, (qtipSize_t) -1, sizeof(type_t)));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_put_pop);
+    RUN_TEST(test_full);
+    RUN_TEST(test_rollover);
+    RUN_TEST(test_threads);
+#ifndef DISABLE_OVERWRITE
+    RUN_TEST(test_overwrite);
+    RUN_TEST(test_overwrite_threads);
+#endif
+    RUN_TEST(test_telemetry);
+#if !defined(DISABLE_TELEMETRY) && !defined(DISABLE_STATS)
+    RUN_TEST(test_stats);
+    RUN_TEST(test_stats_interleaved);
+#endif
+    RUN_TEST(test_null_ptr);
+    RUN_TEST(test_invalid_size);
+    return UNITY_END();
+}
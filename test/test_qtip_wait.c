@@ -0,0 +1,242 @@
+/**
+ * @file test_qtip_wait.c
+ * @brief Unit tests for QTip blocking operations
+ * @author Jose Amador
+ * @copyright MIT License
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "qtip_mpmc.h"
+#include "qtip_spsc.h"
+#include "unity.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+#define QTIP_ASSERT_OK(exp)       TEST_ASSERT(QTIP_STATUS_OK == (exp))
+#define QTIP_ASSERT_NULL_PTR(exp) TEST_ASSERT(QTIP_STATUS_NULL_PTR == (exp))
+#define QTIP_ASSERT_EMPTY(exp)    TEST_ASSERT(QTIP_STATUS_EMPTY == (exp))
+#define QTIP_ASSERT_FULL(exp)     TEST_ASSERT(QTIP_STATUS_FULL == (exp))
+
+#define QTIP_ASSERT_ITEM(expected, actual) TEST_ASSERT_EQUAL_size_t((expected), (actual))
+
+#define QUEUE_SIZE     4U
+#define TIMEOUT_US     2000U
+#define DELAY_US       5000U
+#define STRESS_THREADS 2U
+#define STRESS_ITEMS   20000U
+
+typedef uint32_t type_t;
+
+static const qtipWaitStrategy_t STRATEGIES[] = {QTIP_WAIT_SPIN, QTIP_WAIT_YIELD, QTIP_WAIT_PARK};
+
+qtipSpscContext_t spscContext;
+qtipMpmcContext_t mpmcContext;
+type_t spscQueue[QUEUE_SIZE];
+size_t mpmcQueue[QTIP_MPMC_BUFFER_SIZE(QUEUE_SIZE, sizeof(type_t)) / sizeof(size_t)];
+
+typedef struct
+{
+    qtipWaitStrategy_t strategy;
+    type_t item;
+    qtipStatus_t status;
+} waiter_t;
+
+static QTIP_ATOMIC(size_t) received;
+static QTIP_ATOMIC(size_t) receivedSum;
+static QTIP_ATOMIC(size_t) failures;
+
+void setUp(void)
+{
+    qtip_spsc_init(&spscContext, spscQueue, QUEUE_SIZE, sizeof(type_t));
+    qtip_mpmc_init(&mpmcContext, mpmcQueue, QUEUE_SIZE, sizeof(type_t));
+}
+
+void tearDown(void)
+{
+    memset(spscQueue, 0U, sizeof(spscQueue));
+    memset(mpmcQueue, 0U, sizeof(mpmcQueue));
+}
+
+static uint64_t now_us(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return ((uint64_t) time.tv_sec * 1000000U) + ((uint64_t) time.tv_nsec / 1000U);
+}
+
+static void sleep_us(uint64_t delay)
+{
+    struct timespec time = {.tv_sec = (time_t) (delay / 1000000U), .tv_nsec = (long) ((delay % 1000000U) * 1000U)};
+    nanosleep(&time, NULL);
+}
+
+static void* spsc_consumer(void* pArg)
+{
+    waiter_t* pWaiter = pArg;
+    pWaiter->status   = qtip_spsc_pop_wait(&spscContext, &pWaiter->item, QTIP_WAIT_FOREVER, pWaiter->strategy);
+    return NULL;
+}
+
+static void* mpmc_producer(void* pArg)
+{
+    waiter_t* pWaiter = pArg;
+    pWaiter->status   = qtip_mpmc_put_wait(&mpmcContext, &pWaiter->item, QTIP_WAIT_FOREVER, pWaiter->strategy);
+    return NULL;
+}
+
+static void* stress_producer(void* pArg)
+{
+    (void) pArg;
+
+    for (type_t i = 1U; i <= STRESS_ITEMS; i++)
+    {
+        if (qtip_mpmc_put_wait(&mpmcContext, &i, QTIP_WAIT_FOREVER, QTIP_WAIT_PARK) != QTIP_STATUS_OK)
+        {
+            atomic_fetch_add(&failures, 1U);
+        }
+    }
+
+    return NULL;
+}
+
+static void* stress_consumer(void* pArg)
+{
+    (void) pArg;
+    type_t item = 0U;
+
+    for (size_t i = 0U; i < STRESS_ITEMS; i++)
+    {
+        if (qtip_mpmc_pop_wait(&mpmcContext, &item, QTIP_WAIT_FOREVER, QTIP_WAIT_PARK) == QTIP_STATUS_OK)
+        {
+            atomic_fetch_add(&received, 1U);
+            atomic_fetch_add(&receivedSum, item);
+        }
+        else
+        {
+            atomic_fetch_add(&failures, 1U);
+        }
+    }
+
+    return NULL;
+}
+
+void test_no_wait(void)
+{
+    type_t item = 1U;
+
+    QTIP_ASSERT_EMPTY(qtip_spsc_pop_wait(&spscContext, &item, 0U, QTIP_WAIT_PARK));
+    QTIP_ASSERT_OK(qtip_spsc_put_wait(&spscContext, &item, 0U, QTIP_WAIT_PARK));
+    QTIP_ASSERT_OK(qtip_spsc_pop_wait(&spscContext, &item, TIMEOUT_US, QTIP_WAIT_PARK));
+    QTIP_ASSERT_ITEM(1U, item);
+}
+
+void test_timeout(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t item = 0U;
+
+    for (size_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_mpmc_put(&mpmcContext, &item));
+    }
+
+    for (size_t i = 0U; i < sizeof(STRATEGIES) / sizeof(STRATEGIES[0]); i++)
+    {
+        uint64_t start = now_us();
+        QTIP_ASSERT_EMPTY(qtip_spsc_pop_wait(&spscContext, &item, TIMEOUT_US, STRATEGIES[i]));
+        TEST_ASSERT_TRUE((now_us() - start) >= TIMEOUT_US);
+
+        start = now_us();
+        QTIP_ASSERT_FULL(qtip_mpmc_put_wait(&mpmcContext, &item, TIMEOUT_US, STRATEGIES[i]));
+        TEST_ASSERT_TRUE((now_us() - start) >= TIMEOUT_US);
+    }
+}
+
+void test_wake_consumer(void)
+{
+    for (size_t i = 0U; i < sizeof(STRATEGIES) / sizeof(STRATEGIES[0]); i++)
+    {
+        pthread_t thread;
+        waiter_t waiter = {.strategy = STRATEGIES[i], .item = 0U, .status = QTIP_STATUS_EMPTY};
+        type_t item     = (type_t) i + 1U;
+
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, spsc_consumer, &waiter));
+        sleep_us(DELAY_US);
+        QTIP_ASSERT_OK(qtip_spsc_put(&spscContext, &item));
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+        QTIP_ASSERT_OK(waiter.status);
+        QTIP_ASSERT_ITEM(item, waiter.item);
+    }
+}
+
+void test_wake_producer(void) // NOLINT(readability-function-cognitive-complexity)
+{
+    type_t item = 0U;
+
+    for (type_t i = 0U; i < QUEUE_SIZE; i++)
+    {
+        QTIP_ASSERT_OK(qtip_mpmc_put(&mpmcContext, &i));
+    }
+
+    for (size_t i = 0U; i < sizeof(STRATEGIES) / sizeof(STRATEGIES[0]); i++)
+    {
+        pthread_t thread;
+        waiter_t waiter = {.strategy = STRATEGIES[i], .item = QUEUE_SIZE + (type_t) i, .status = QTIP_STATUS_FULL};
+
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, mpmc_producer, &waiter));
+        sleep_us(DELAY_US);
+        QTIP_ASSERT_OK(qtip_mpmc_pop(&mpmcContext, &item));
+        QTIP_ASSERT_ITEM(i, item);
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+        QTIP_ASSERT_OK(waiter.status);
+    }
+}
+
+void test_park_threads(void)
+{
+    pthread_t producers[STRESS_THREADS];
+    pthread_t consumers[STRESS_THREADS];
+
+    atomic_store(&received, 0U);
+    atomic_store(&receivedSum, 0U);
+    atomic_store(&failures, 0U);
+
+    for (size_t i = 0U; i < STRESS_THREADS; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&consumers[i], NULL, stress_consumer, NULL));
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&producers[i], NULL, stress_producer, NULL));
+    }
+
+    for (size_t i = 0U; i < STRESS_THREADS; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(producers[i], NULL));
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(consumers[i], NULL));
+    }
+
+    TEST_ASSERT_EQUAL_size_t(0U, atomic_load(&failures));
+    TEST_ASSERT_EQUAL_size_t(STRESS_THREADS * STRESS_ITEMS, atomic_load(&received));
+    TEST_ASSERT_EQUAL_size_t(STRESS_THREADS * ((size_t) STRESS_ITEMS * (STRESS_ITEMS + 1U) / 2U),
+                             atomic_load(&receivedSum));
+}
+
+void test_null_ptr(void)
+{
+    QTIP_ASSERT_NULL_PTR(qtip_spsc_put_wait(NULL, NULL, 0U, QTIP_WAIT_SPIN));
+    QTIP_ASSERT_NULL_PTR(qtip_spsc_pop_wait(NULL, NULL, 0U, QTIP_WAIT_SPIN));
+    QTIP_ASSERT_NULL_PTR(qtip_mpmc_put_wait(NULL, NULL, 0U, QTIP_WAIT_SPIN));
+    QTIP_ASSERT_NULL_PTR(qtip_mpmc_pop_wait(NULL, NULL, 0U, QTIP_WAIT_SPIN));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_no_wait);
+    RUN_TEST(test_timeout);
+    RUN_TEST(test_wake_consumer);
+    RUN_TEST(test_wake_producer);
+    RUN_TEST(test_park_threads);
+    RUN_TEST(test_null_ptr);
+    return UNITY_END();
+}